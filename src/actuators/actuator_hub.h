@@ -2,18 +2,20 @@
  * ACS4 Flight Computer — Actuator Hub
  *
  * Aggregates commanded actuator state (4-aileron canard bank) into a
- * single timestamped snapshot shared between the producer (future
- * control-law, debug shell) and the consumer (ActuatorThread).
+ * single timestamped snapshot shared between the producer (ControlThread,
+ * debug shell) and the consumer (ActuatorThread).
  *
  * Threading model mirrors SensorHub: all access goes through chSysLock
  * to keep struct updates atomic.
  *
  * Producers:
- *   - control-law / FSM: set_aileron_deg(), set_armed_request()
+ *   - ControlThread: set_aileron_deg() while ctrl.enable = 1 and armed
+ *   - FSM: set_armed_request()
  *   - debug shell: same, plus set_sweep()
  *
  * Consumer (ActuatorThread):
- *   - snapshot() at 100 Hz, applies sweep (if active), pushes to ServoBankT75
+ *   - snapshot() per control command (10 ms fallback), applies sweep (if
+ *     active), pushes to ServoBankT75
  *   - feeds back via update_current_us() / update_armed()
  */
 
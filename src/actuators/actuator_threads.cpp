@@ -51,12 +51,20 @@ static float triangle_wave_deg(float min_deg, float max_deg, uint32_t period_ms,
 }
 
 /* =====================================================================
- * ActuatorThread — 100 Hz write-out to ServoBankT75
+ * ActuatorThread — write-out to ServoBankT75 on each control command
  * ===================================================================== */
 
+/* Bez powiadomien (shell, sweep) watek i tak budzi sie co 10 ms */
+static constexpr uint32_t kActuatorFallbackMs = 10;
+
+/* Gorne ograniczenie dt slew-limitera (np. po pierwszym przebiegu) */
+static constexpr uint32_t kActuatorMaxDtUs = 20000;
+
 static int g_prof_act = -1;
 static int g_wdg_act  = -1;
 
+static BSEMAPHORE_DECL(g_cmd_ready, true);
+
 static THD_WORKING_AREA(waActuatorThread, 1024);
 
 static THD_FUNCTION(ActuatorThread, arg)
@@ -73,15 +81,24 @@ static THD_FUNCTION(ActuatorThread, arg)
         return;
     }
 
-    bool      last_armed_req = false;
-    systime_t next           = chVTGetSystemTimeX();
+    bool     last_armed_req = false;
+    uint32_t last_tick_us   = timestamp_us();
 
     while (true)
     {
-        next += TIME_MS2I(10);
+        (void)chBSemWaitTimeout(&g_cmd_ready, TIME_MS2I(kActuatorFallbackMs));
 
         PROFILE_BEGIN(g_prof_act);
 
+        /* Rzeczywisty odstep od poprzedniego ticku (DWT) */
+        const uint32_t now_us = timestamp_us();
+        uint32_t       dt_us  = timestamp_elapsed_us(last_tick_us, now_us);
+        last_tick_us          = now_us;
+        if (dt_us > kActuatorMaxDtUs)
+        {
+            dt_us = kActuatorMaxDtUs;
+        }
+
         const ActuatorSnapshot snap = actuator_hub().snapshot();
 
         /* Synchronize arm state with the producer's request. */
@@ -116,7 +133,7 @@ static THD_FUNCTION(ActuatorThread, arg)
             bank->set_angle_deg(i, deg);
         }
 
-        bank->tick(10);
+        bank->tick_us(dt_us, snap.cmd_timestamp_us);
 
         for (uint8_t i = 0; i < kAileronCount; ++i)
         {
@@ -129,11 +146,14 @@ static THD_FUNCTION(ActuatorThread, arg)
         {
             watchdog_feed(g_wdg_act);
         }
-
-        chThdSleepUntil(next);
     }
 }
 
+void actuator_notify()
+{
+    chBSemSignal(&g_cmd_ready);
+}
+
 void start_actuator_threads()
 {
     chThdCreateStatic(
@@ -147,6 +167,10 @@ void start_actuator_threads()
 namespace acs
 {
 
+void actuator_notify()
+{
+}
+
 void start_actuator_threads()
 {
 }
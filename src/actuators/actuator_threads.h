@@ -1,11 +1,13 @@
 /*
  * ACS4 Flight Computer — Actuator Thread
  *
- * ActuatorThread (100 Hz, prio NORMALPRIO + 20):
- *   Reads commanded angles from ActuatorHub, applies per-fin triangle
- *   sweep (if active), pushes through ServoBankT75's slew limiter,
- *   writes pulse widths to TIM4 PWM channels, feeds back current pulse
- *   widths to the hub.
+ * ActuatorThread (event-driven, prio NORMALPRIO + 20):
+ *   Woken by actuator_notify() after each control-law command (400 Hz),
+ *   or every 10 ms without one (shell commands, sweeps). Reads commanded
+ *   angles from ActuatorHub, applies per-fin triangle sweep (if active),
+ *   pushes through ServoBankT75's slew limiter with the measured dt,
+ *   writes pulse widths to TIM4 (latched at the next PWM update event),
+ *   feeds back current pulse widths to the hub.
  *
  * Call start_actuator_threads() once from main() after the servo bank
  * has been initialized. On Nucleo builds (no PCB, no servos) this is
@@ -19,4 +21,11 @@ namespace acs
 
 void start_actuator_threads();
 
+/**
+ * @brief Wake ActuatorThread — a new command is in ActuatorHub.
+ *
+ * Called by ControlThread after each set_aileron_deg() batch.
+ */
+void actuator_notify();
+
 }  // namespace acs
@@ -0,0 +1,58 @@
+/**
+ * @file attitude_control.cpp
+ * @brief Roll / pitch / yaw PID attitude law.
+ */
+
+#include "control/attitude_control.h"
+
+#include <cmath>
+
+namespace acs::ctrl
+{
+
+static constexpr float kRadToDeg = 57.29577951f;
+
+/* Os uznana za nasycona, gdy alokator nie dostarczyl zadanego momentu */
+static constexpr float kShortfallDeg = 1e-3f;
+
+static float clampf(float x, float lim)
+{
+    return (x > lim) ? lim : ((x < -lim) ? -lim : x);
+}
+
+void AttitudeController::reset()
+{
+    integ_     = {};
+    axis_cmd_  = {};
+    alloc_out_ = {};
+}
+
+FinCommand AttitudeController::update(const AttitudeGains &gains,
+                                      const nav::Quat     &q,
+                                      const nav::Quat     &q_ref,
+                                      const nav::Vec3     &rate_rads,
+                                      float                dt)
+{
+    const nav::Vec3 err  = nav::quat_error_vector(q, q_ref) * kRadToDeg;
+    const nav::Vec3 rate = rate_rads * kRadToDeg;
+
+    for (int a = 0; a < 3; ++a)
+    {
+        const AxisGains &g = gains.axis[a];
+
+        /* Anti-windup: nie calkuj dalej w strone nasycenia */
+        const bool limited = std::fabs(axis_cmd_[a] - alloc_out_.achieved[a]) > kShortfallDeg;
+        const bool winding = limited && (err[a] * axis_cmd_[a] > 0.0f);
+        if (dt > 0.0f && !winding)
+        {
+            integ_[a] = clampf(integ_[a] + g.ki * err[a] * dt, limits_.i_limit_deg);
+        }
+
+        axis_cmd_[a] = g.kp * err[a] + integ_[a] - g.kd * rate[a];
+    }
+
+    alloc_out_ = alloc_->allocate(axis_cmd_, limits_.max_deflection_deg);
+    return alloc_out_.fins;
+}
+
+}  // namespace acs::ctrl
@@ -0,0 +1,121 @@
+/**
+ * @file attitude_control.h
+ * @brief Roll / pitch / yaw PID attitude law.
+ *
+ * Per body axis (board frame, x = roll, y = pitch, z = yaw):
+ *
+ *   e   = quat_error_vector(q, q_ref)          attitude error [deg]
+ *   I  += ki · e · dt                          clamped to ±i_limit
+ *   u   = kp · e + I − kd · ω                  virtual deflection [deg]
+ *
+ * The D term acts on the measured (bias-corrected) body rate, not on the
+ * error derivative, so setpoint steps do not kick the fins. The integrator
+ * of an axis is frozen while that axis is saturated and the error would
+ * push it further (conditional integration anti-windup).
+ *
+ * Gains are dimensionless in degrees: fin deg per deg of error (kp), per
+ * deg·s (ki), per deg/s of rate (kd).
+ *
+ * The 3-axis virtual deflection is the moment demand handed to the canard
+ * allocator (control/canard_allocation.h), which clamps each fin to
+ * ±max_deflection_deg and redistributes the shortfall over the remaining
+ * fins. An axis counts as saturated for anti-windup when the allocated
+ * moment falls short of the demand on that axis.
+ *
+ * No RTOS dependencies — host-testable. ControlThread
+ * (control/control_thread.cpp) owns one instance.
+ */
+
+#pragma once
+
+#include "control/canard_allocation.h"
+#include "navigation/quaternion.h"
+
+namespace acs::ctrl
+{
+
+struct AxisGains
+{
+    float kp;
+    float ki;
+    float kd;
+};
+
+struct AttitudeGains
+{
+    AxisGains axis[3]; /* roll, pitch, yaw */
+};
+
+struct AttitudeLimits
+{
+    float max_deflection_deg; /* per-fin cap (= ServoT75Config::max_angle_deg) */
+    float i_limit_deg;        /* integrator cap per axis */
+};
+
+class AttitudeController
+{
+  public:
+    explicit AttitudeController(const AttitudeLimits  &limits,
+                                const CanardAllocator &alloc = kRocketAllocator)
+        : limits_(limits), alloc_(&alloc)
+    {
+    }
+
+    /**
+     * @brief Clear integrators (call on engage).
+     */
+    void reset();
+
+    void set_limits(const AttitudeLimits &limits)
+    {
+        limits_ = limits;
+    }
+
+    /**
+     * @brief One control step.
+     *
+     * @param gains     Current gains (read from params by the caller).
+     * @param q         Current attitude, body → NED.
+     * @param q_ref     Desired attitude, body → NED.
+     * @param rate_rads Bias-corrected body rate [rad/s].
+     * @param dt        Step [s]; the integrator is skipped if ≤ 0.
+     * @return Clamped fin deflections [deg].
+     */
+    FinCommand update(const AttitudeGains &gains,
+                      const nav::Quat     &q,
+                      const nav::Quat     &q_ref,
+                      const nav::Vec3     &rate_rads,
+                      float                dt);
+
+    /** Virtual deflection of the last step (moment demand) [deg]. */
+    [[nodiscard]] const AxisCommand &axis_command() const
+    {
+        return axis_cmd_;
+    }
+
+    [[nodiscard]] const AxisCommand &integrator() const
+    {
+        return integ_;
+    }
+
+    /** Allocation of the last step (fins, achieved moment, saturation). */
+    [[nodiscard]] const AllocationResult &allocation() const
+    {
+        return alloc_out_;
+    }
+
+    /** True if any fin hit the cap in the last step. */
+    [[nodiscard]] bool saturated() const
+    {
+        return alloc_out_.saturated_mask != 0;
+    }
+
+  private:
+    AttitudeLimits         limits_;
+    const CanardAllocator *alloc_;
+    AxisCommand            integ_{};
+    AxisCommand            axis_cmd_{};
+    AllocationResult       alloc_out_{};
+};
+
+}  // namespace acs::ctrl
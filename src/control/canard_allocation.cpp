@@ -0,0 +1,77 @@
+/**
+ * @file canard_allocation.cpp
+ * @brief Redistributed pseudo-inverse canard allocation.
+ */
+
+#include "control/canard_allocation.h"
+
+#include <cmath>
+
+namespace acs::ctrl
+{
+
+/* Kompilacyjna kontrola domyslnego ukladu: alokacja bez ograniczen = prosty mix */
+static_assert(mix_canards({1.0f, 0.0f, 0.0f})[0] == 1.0f &&
+                  mix_canards({1.0f, 0.0f, 0.0f})[3] == 1.0f,
+              "pure roll must deflect every fin equally");
+static_assert(mix_canards({0.0f, 1.0f, 0.0f})[1] == 0.0f &&
+                  mix_canards({0.0f, 1.0f, 0.0f})[0] == -mix_canards({0.0f, 1.0f, 0.0f})[2],
+              "pitch must use the Y-axis fin pair differentially");
+static_assert(mix_canards({0.0f, 0.0f, 1.0f})[0] == 0.0f &&
+                  mix_canards({0.0f, 0.0f, 1.0f})[1] == -mix_canards({0.0f, 0.0f, 1.0f})[3],
+              "yaw must use the Z-axis fin pair differentially");
+
+AllocationResult CanardAllocator::allocate(const AxisCommand &m,
+                                           float              max_deg,
+                                           uint8_t            available) const
+{
+    AllocationResult res{};
+    AxisCommand      rem  = m;
+    auto             free = static_cast<uint8_t>(available & kAllFins);
+
+    /* Kazde przejscie zamraza >= 1 pletwe, wiec najwyzej kAileronCount przejsc */
+    while (free != 0)
+    {
+        const FinCommand d    = apply(free, rem);
+        uint8_t          over = 0;
+        for (size_t i = 0; i < kAileronCount; ++i)
+        {
+            if (((free >> i) & 1U) && std::fabs(d[i]) > max_deg)
+            {
+                over = static_cast<uint8_t>(over | (1U << i));
+            }
+        }
+
+        if (over == 0)
+        {
+            for (size_t i = 0; i < kAileronCount; ++i)
+            {
+                if ((free >> i) & 1U)
+                {
+                    res.fins[i] = d[i];
+                }
+            }
+            break;
+        }
+
+        /* Nasycone pletwy na limit; ich moment odjety od zadania */
+        for (size_t i = 0; i < kAileronCount; ++i)
+        {
+            if ((over >> i) & 1U)
+            {
+                res.fins[i] = std::copysign(max_deg, d[i]);
+                for (size_t r = 0; r < 3; ++r)
+                {
+                    rem[r] -= b_[r][i] * res.fins[i];
+                }
+            }
+        }
+        free               = static_cast<uint8_t>(free & ~over);
+        res.saturated_mask = static_cast<uint8_t>(res.saturated_mask | over);
+    }
+
+    res.achieved = moment(res.fins);
+    return res;
+}
+
+}  // namespace acs::ctrl
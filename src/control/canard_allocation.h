@@ -0,0 +1,232 @@
+/**
+ * @file canard_allocation.h
+ * @brief 3-axis moment → 4-canard allocation with saturation redistribution.
+ *
+ * Effectiveness model (board frame): fin i sits at radial direction
+ * (0, y_i, z_i) and positive deflection pushes it tangentially, giving a
+ * +roll moment on every fin:
+ *
+ *   m = B · δ,   B[:, i] = [ k_roll,  −k_pitch · y_i,  −k_yaw · z_i ]ᵀ
+ *
+ * The moment is expressed in "equivalent fin degrees" — with the default
+ * gains (¼, ½, ½) a pure roll demand of u deflects all four fins by u,
+ * matching the virtual deflection produced by AttitudeController.
+ *
+ * For every non-empty subset of usable fins (15 masks) the minimum-norm
+ * pseudo-inverse B_m⁺ = B_mᵀ (B_m B_mᵀ)⁻¹ is computed at compile time
+ * (rank-deficient subsets use the Tikhonov limit with a tiny damping).
+ *
+ * allocate() is the redistributed pseudo-inverse: allocate with the free
+ * fins, clamp those that exceed the cap, subtract their moment and
+ * re-allocate the remainder over the still-free fins — at most four
+ * passes of a 4×3 product, well under 1 µs on the H725.
+ *
+ * No RTOS dependencies — host-testable.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "actuators/actuator_hub.h"
+
+namespace acs::ctrl
+{
+
+using AxisCommand = std::array<float, 3>;             /* roll, pitch, yaw [deg] */
+using FinCommand  = std::array<float, kAileronCount>; /* fin 1..4 [deg] */
+
+inline constexpr uint8_t kAllFins  = (1U << kAileronCount) - 1U;
+inline constexpr size_t  kFinMasks = size_t{1} << kAileronCount;
+
+/**
+ * @brief Fin geometry and per-axis effectiveness of one airframe.
+ */
+struct CanardAirframe
+{
+    float fin_y[kAileronCount]; /* radial direction of each fin, body Y */
+    float fin_z[kAileronCount]; /* radial direction of each fin, body Z */
+    float k_roll;               /* moment per degree, per fin */
+    float k_pitch;
+    float k_yaw;
+
+    /**
+     * @brief 4-canard "+" layout (fin 1..4 on +Y, +Z, −Y, −Z), gains
+     *        normalized so the unconstrained allocation equals the plain
+     *        roll/pitch/yaw mix.
+     */
+    static constexpr CanardAirframe rocket_default()
+    {
+        return {
+            .fin_y   = {1.0f, 0.0f, -1.0f, 0.0f},
+            .fin_z   = {0.0f, 1.0f, 0.0f, -1.0f},
+            .k_roll  = 0.25f,
+            .k_pitch = 0.5f,
+            .k_yaw   = 0.5f,
+        };
+    }
+};
+
+struct AllocationResult
+{
+    FinCommand  fins;           /* clamped deflections [deg] */
+    AxisCommand achieved;       /* B · fins */
+    uint8_t     saturated_mask; /* bit i = fin i at the cap */
+};
+
+class CanardAllocator
+{
+  public:
+    constexpr explicit CanardAllocator(const CanardAirframe &a) : b_{}, pinv_{}
+    {
+        for (size_t i = 0; i < kAileronCount; ++i)
+        {
+            b_[0][i] = a.k_roll;
+            b_[1][i] = -a.k_pitch * a.fin_y[i];
+            b_[2][i] = -a.k_yaw * a.fin_z[i];
+        }
+        for (size_t m = 1; m < kFinMasks; ++m)
+        {
+            build_pinv(m);
+        }
+    }
+
+    /**
+     * @brief Unconstrained minimum-norm allocation over all fins.
+     */
+    constexpr FinCommand mix(const AxisCommand &m) const
+    {
+        return apply(kAllFins, m);
+    }
+
+    /**
+     * @brief Moment produced by a fin deflection vector.
+     */
+    constexpr AxisCommand moment(const FinCommand &fins) const
+    {
+        AxisCommand out{};
+        for (size_t r = 0; r < 3; ++r)
+        {
+            for (size_t i = 0; i < kAileronCount; ++i)
+            {
+                out[r] += b_[r][i] * fins[i];
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Allocate with per-fin cap and redistribution.
+     *
+     * @param m          Moment demand [equivalent fin deg].
+     * @param max_deg    Per-fin deflection cap (±).
+     * @param available  Usable fins; the others are held at 0.
+     */
+    AllocationResult allocate(const AxisCommand &m,
+                              float              max_deg,
+                              uint8_t            available = kAllFins) const;
+
+    /** Pseudo-inverse entry for a fin subset (tests / diagnostics). */
+    constexpr float pinv(uint8_t mask, size_t fin, size_t axis) const
+    {
+        return pinv_[mask][fin][axis];
+    }
+
+  private:
+    constexpr FinCommand apply(uint8_t mask, const AxisCommand &m) const
+    {
+        FinCommand out{};
+        for (size_t i = 0; i < kAileronCount; ++i)
+        {
+            out[i] = pinv_[mask][i][0] * m[0] + pinv_[mask][i][1] * m[1] + pinv_[mask][i][2] * m[2];
+        }
+        return out;
+    }
+
+    /* B_m⁺ = B_mᵀ (B_m B_mᵀ)⁻¹ w double; podzbiory bez pelnego rzedu:
+     * B_mᵀ (B_m B_mᵀ + λI)⁻¹ z malym λ (granica Tichonowa → Moore-Penrose) */
+    constexpr void build_pinv(size_t mask)
+    {
+        double g[3][3] = {};
+        for (size_t r = 0; r < 3; ++r)
+        {
+            for (size_t c = 0; c < 3; ++c)
+            {
+                for (size_t i = 0; i < kAileronCount; ++i)
+                {
+                    if ((mask >> i) & 1U)
+                    {
+                        g[r][c] += static_cast<double>(b_[r][i]) * static_cast<double>(b_[c][i]);
+                    }
+                }
+            }
+        }
+
+        const double tr = g[0][0] + g[1][1] + g[2][2];
+        if (det3(g) <= 1e-9 * tr * tr * tr)
+        {
+            for (size_t r = 0; r < 3; ++r)
+            {
+                g[r][r] += 1e-7 * tr;
+            }
+        }
+
+        /* Odwrotnosc 3×3 z dopelnien algebraicznych */
+        const double c00 = g[1][1] * g[2][2] - g[1][2] * g[2][1];
+        const double c01 = g[1][2] * g[2][0] - g[1][0] * g[2][2];
+        const double c02 = g[1][0] * g[2][1] - g[1][1] * g[2][0];
+        const double det = det3(g);
+
+        double inv[3][3] = {};
+        inv[0][0]        = c00 / det;
+        inv[1][0]        = c01 / det;
+        inv[2][0]        = c02 / det;
+        inv[0][1]        = (g[0][2] * g[2][1] - g[0][1] * g[2][2]) / det;
+        inv[1][1]        = (g[0][0] * g[2][2] - g[0][2] * g[2][0]) / det;
+        inv[2][1]        = (g[0][1] * g[2][0] - g[0][0] * g[2][1]) / det;
+        inv[0][2]        = (g[0][1] * g[1][2] - g[0][2] * g[1][1]) / det;
+        inv[1][2]        = (g[0][2] * g[1][0] - g[0][0] * g[1][2]) / det;
+        inv[2][2]        = (g[0][0] * g[1][1] - g[0][1] * g[1][0]) / det;
+
+        for (size_t i = 0; i < kAileronCount; ++i)
+        {
+            for (size_t c = 0; c < 3; ++c)
+            {
+                double v = 0.0;
+                if ((mask >> i) & 1U)
+                {
+                    for (size_t r = 0; r < 3; ++r)
+                    {
+                        v += static_cast<double>(b_[r][i]) * inv[r][c];
+                    }
+                }
+                pinv_[mask][i][c] = static_cast<float>(v);
+            }
+        }
+    }
+
+    static constexpr double det3(const double (&g)[3][3])
+    {
+        return g[0][0] * (g[1][1] * g[2][2] - g[1][2] * g[2][1]) +
+               g[0][1] * (g[1][2] * g[2][0] - g[1][0] * g[2][2]) +
+               g[0][2] * (g[1][0] * g[2][1] - g[1][1] * g[2][0]);
+    }
+
+    float b_[3][kAileronCount];
+    float pinv_[kFinMasks][kAileronCount][3];
+};
+
+/* Tablice liczone w czasie kompilacji */
+inline constexpr CanardAllocator kRocketAllocator{CanardAirframe::rocket_default()};
+
+/**
+ * @brief Unconstrained roll / pitch / yaw mix for the default airframe.
+ */
+constexpr FinCommand mix_canards(const AxisCommand &u)
+{
+    return kRocketAllocator.mix(u);
+}
+
+}  // namespace acs::ctrl
@@ -0,0 +1,186 @@
+/*
+ * ACS4 Flight Computer — Control Thread Implementation
+ */
+
+#include "control/control_thread.h"
+
+#include "actuators/actuator_hub.h"
+#include "actuators/actuator_threads.h"
+#include "control/attitude_control.h"
+#include "drivers/servo_t75.h"
+#include "navigation/nav_thread.h"
+#include "system/params.h"
+#include "system/watchdog.h"
+#include "utils/profiler.h"
+#include "utils/timestamp.h"
+
+extern "C" {
+#include "ch.h"
+
+#include "hal.h"
+}
+
+#if defined(STM32H725xx)
+
+namespace acs
+{
+
+/* 400 Hz — szybciej niz ramka PWM 330 Hz, wiec kazda ramka niesie
+ * komende nie starsza niz jeden okres regulatora */
+static constexpr uint32_t kControlPeriodUs = 2500;
+
+/* Rozwiazanie nav starsze niz to → wylacz regulator (nav stoi) */
+static constexpr uint32_t kNavStaleUs = 20000;
+
+static int g_prof_ctrl = -1;
+static int g_wdg_ctrl  = -1;
+
+static THD_WORKING_AREA(waControlThread, 2048);
+
+/* Uchwyty parametrow — wiazane raz, w petli tylko odczyt */
+struct ControlParams
+{
+    ParamRef gain[3][3]; /* [os][kp, ki, kd] */
+    ParamRef enable;
+    ParamRef i_limit;
+};
+
+static ControlParams bind_params()
+{
+    static constexpr const char *kNames[3][3] = {
+        {"ctrl.kp_roll", "ctrl.ki_roll", "ctrl.kd_roll"},
+        {"ctrl.kp_pitch", "ctrl.ki_pitch", "ctrl.kd_pitch"},
+        {"ctrl.kp_yaw", "ctrl.ki_yaw", "ctrl.kd_yaw"},
+    };
+
+    ControlParams p;
+    for (int a = 0; a < 3; ++a)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            p.gain[a][k] = param_bind(kNames[a][k]);
+        }
+    }
+    p.enable  = param_bind("ctrl.enable");
+    p.i_limit = param_bind("ctrl.i_limit");
+    return p;
+}
+
+static ctrl::AttitudeGains read_gains(const ControlParams &p)
+{
+    ctrl::AttitudeGains g{};
+    for (int a = 0; a < 3; ++a)
+    {
+        g.axis[a] = {
+            p.gain[a][0].get_or(0.0f), p.gain[a][1].get_or(0.0f), p.gain[a][2].get_or(0.0f)};
+    }
+    return g;
+}
+
+static void command_fins(const ctrl::FinCommand &fins)
+{
+    const uint32_t now = timestamp_us();
+    for (uint8_t i = 0; i < kAileronCount; ++i)
+    {
+        actuator_hub().set_aileron_deg(i, fins[i], now);
+    }
+    actuator_notify();
+}
+
+/* =====================================================================
+ * ControlThread — 400 Hz attitude law
+ * ===================================================================== */
+
+static THD_FUNCTION(ControlThread, arg)
+{
+    (void)arg;
+    chRegSetThreadName("control");
+
+    g_prof_ctrl = profiler_register("control");
+    g_wdg_ctrl  = watchdog_register("control", 50);
+
+    const ControlParams params = bind_params();
+
+    const ServoBankT75 *bank    = servo_bank_instance();
+    const float         max_deg = (bank != nullptr)
+                                      ? bank->config().max_angle_deg
+                                      : ServoT75Config::rocket_default().max_angle_deg;
+
+    ctrl::AttitudeController law({max_deg, params.i_limit.get_or(0.0f)});
+
+    bool      engaged = false;
+    nav::Quat q_ref   = nav::quat_identity();
+    uint32_t  last_us = 0;
+    systime_t next    = chVTGetSystemTimeX();
+
+    while (true)
+    {
+        next += TIME_US2I(kControlPeriodUs);
+
+        PROFILE_BEGIN(g_prof_ctrl);
+
+        NavSolution sol{};
+        const bool  have_nav = nav_solution(sol) && sol.mode == NavMode::RUNNING &&
+                              timestamp_elapsed_us(sol.timestamp_us, timestamp_us()) < kNavStaleUs;
+        const bool  armed    = actuator_hub().snapshot().armed;
+        const bool  want     = params.enable.get_or(0.0f) > 0.5f && armed && have_nav;
+
+        const nav::Quat q(sol.q[0], sol.q[1], sol.q[2], sol.q[3]);
+
+        if (want && !engaged)
+        {
+            law.reset();
+            q_ref   = q;
+            last_us = sol.timestamp_us;
+            engaged = true;
+        }
+        else if (!want && engaged)
+        {
+            command_fins({});
+            engaged = false;
+        }
+
+        if (engaged)
+        {
+            /* dt z czasu probek nav — 0 gdy brak nowego rozwiazania */
+            const float dt =
+                static_cast<float>(timestamp_elapsed_us(last_us, sol.timestamp_us)) * 1e-6f;
+            last_us = sol.timestamp_us;
+
+            law.set_limits({max_deg, params.i_limit.get_or(0.0f)});
+            const nav::Vec3 rate(sol.rate_body[0], sol.rate_body[1], sol.rate_body[2]);
+            command_fins(law.update(read_gains(params), q, q_ref, rate, dt));
+            profiler_items(g_prof_ctrl, 1);
+        }
+
+        PROFILE_END(g_prof_ctrl);
+
+        if (g_wdg_ctrl >= 0)
+        {
+            watchdog_feed(g_wdg_ctrl);
+        }
+
+        chThdSleepUntil(next);
+    }
+}
+
+void start_control_thread()
+{
+    chThdCreateStatic(
+        waControlThread, sizeof(waControlThread), NORMALPRIO + 40, ControlThread, nullptr);
+}
+
+}  // namespace acs
+
+#else /* NUCLEO_H723 — no PCB, no servos */
+
+namespace acs
+{
+
+void start_control_thread()
+{
+}
+
+}  // namespace acs
+
+#endif
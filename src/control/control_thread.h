@@ -0,0 +1,30 @@
+/*
+ * ACS4 Flight Computer — Control Thread
+ *
+ * ControlThread (400 Hz, prio NORMALPRIO + 40, 2 KB stack):
+ *   Reads the latest NavSolution, runs the roll / pitch / yaw PID law
+ *   (control/attitude_control.h), writes the allocated fin deflections to
+ *   ActuatorHub::set_aileron_deg() and wakes ActuatorThread
+ *   (actuator_notify()), which applies them at the next PWM frame.
+ *
+ * Engaged only while ctrl.enable = 1, the servo bank is armed and
+ * NavThread is RUNNING with a fresh solution; the attitude at the moment
+ * of engagement becomes the hold setpoint. On disengage the fins are
+ * commanded to zero once and the shell / sweep own them again.
+ *
+ * Gains (ctrl.kp_roll … ctrl.kd_yaw, ctrl.i_limit, ctrl.enable) are bound
+ * to ParamRef handles at thread start; every tick reads them with plain
+ * loads, so `param set` takes effect on the next tick without a lookup.
+ *
+ * Call start_control_thread() once from main(). On Nucleo builds this
+ * is a no-op.
+ */
+
+#pragma once
+
+namespace acs
+{
+
+void start_control_thread();
+
+}  // namespace acs
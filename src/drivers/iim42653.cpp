@@ -20,6 +20,7 @@
 #include <cstring>
 #include <limits>
 
+#include "drivers/iim42653_math.h"
 #include "system/error_handler.h"
 #include "utils/timestamp.h"
 
@@ -573,10 +574,26 @@ bool Iim42653::configure_fifo(const Iim42653Config &cfg)
      */
     IMU_TRY(write_reg(FIFO_CONFIG1, FIFO1_PKT3_ALL));
 
+    IMU_TRY(write_fifo_watermark(cfg.fifo_watermark));
+
+    /* sflushuj FIFO (SIGNAL_PATH_RESET bit 1). */
+    IMU_TRY(modify_reg(SIGNAL_PATH_RESET, 0x00, FIFO_FLUSH));
+
+    chThdSleepMicroseconds(100);
+
+    /* Stream-to-FIFO mode: FIFO_CONFIG bits [7:6] = 01. */
+    IMU_TRY(write_reg(FIFO_CONFIG, FIFO_STREAM));
+
+    fifo_enabled_ = true;
+    return true;
+}
+
+bool Iim42653::write_fifo_watermark(uint16_t packets)
+{
     /* Watermark w bajtach. Musimy ograniczyc do maksymalnej wartosci sprzetowej (2080 B / 16 B =
      * 130 pakietow). Datasheet w 6.3 mowi: physical FIFO = 2048 B + read cache, driver max = 2080
      * B. FIFO_WM nie moze byc rowne 0 (patrz datasheet w 14.48/14.49). */
-    uint16_t wm_packets = (cfg.fifo_watermark > 0) ? cfg.fifo_watermark : 1;
+    uint16_t wm_packets = (packets > 0) ? packets : 1;
     if (wm_packets > kFifoMaxPackets)
     {
         wm_packets = static_cast<uint16_t>(kFifoMaxPackets);
@@ -586,16 +603,19 @@ bool Iim42653::configure_fifo(const Iim42653Config &cfg)
     IMU_TRY(write_reg(FIFO_CONFIG2, static_cast<uint8_t>(wm_bytes & 0xFF)));
     IMU_TRY(write_reg(FIFO_CONFIG3, static_cast<uint8_t>((wm_bytes >> 8) & 0x0F)));
 
-    /* sflushuj FIFO (SIGNAL_PATH_RESET bit 1). */
-    IMU_TRY(modify_reg(SIGNAL_PATH_RESET, 0x00, FIFO_FLUSH));
-
-    chThdSleepMicroseconds(100);
+    config_.fifo_watermark = wm_packets;
+    return true;
+}
 
-    /* Stream-to-FIFO mode: FIFO_CONFIG bits [7:6] = 01. */
-    IMU_TRY(write_reg(FIFO_CONFIG, FIFO_STREAM));
+bool Iim42653::set_fifo_watermark(uint16_t packets)
+{
+    if (!initialized_ || !fifo_enabled_)
+    {
+        return false;
+    }
 
-    fifo_enabled_ = true;
-    return true;
+    /* Zmiana progu w locie — FIFO dalej w trybie stream, bez flusha. */
+    return write_fifo_watermark(packets);
 }
 
 /* ===============
@@ -848,6 +868,9 @@ size_t Iim42653::read_fifo(ImuSample *samples, size_t max_count)
      * bez zewnetrzenego CLKIN oraz przy TMST_RES=0 wewnetrzny licznik 1 mikrosekundy w czujniku
      * dziala z predkoscia 30/32 rzeczywistego czasu.
      *
+     * Cofanie idzie modulo TIMESTAMP_WRAP_US: tuz po przepelnieniu DWT starsze probki batcha
+     * dostaja stemple tuz pod okresem zegara, nie w okolicy 2^32 (iim42653_math.h).
+     *
      * Surowe timestampy czujnika musza zostac zapisane przed ich nadpisanie czasem hosta,
      * poniewaz rekonstrukja wykorzystuje jednoczesnie oba zrodla zegara
      *
@@ -861,10 +884,10 @@ size_t Iim42653::read_fifo(ImuSample *samples, size_t max_count)
 
     for (size_t i = valid - 1; i > 0; --i)
     {
-        const auto     raw_delta = static_cast<uint16_t>(raw_sensor_ts_[i] - raw_sensor_ts_[i - 1]);
-        const uint32_t delta     = (static_cast<uint32_t>(raw_delta) * 32U + 15U) / 30U;
+        const uint32_t delta = iim42653::fifo_delta_us(raw_sensor_ts_[i - 1], raw_sensor_ts_[i]);
 
-        samples[i - 1].timestamp_us = samples[i].timestamp_us - delta;
+        samples[i - 1].timestamp_us =
+            iim42653::backdate_us(samples[i].timestamp_us, delta, TIMESTAMP_WRAP_US);
     }
 
     return valid;
@@ -269,6 +269,27 @@ enum class GyroOdr : uint8_t
     HZ_12_5  = 0x0B,
 };
 
+/** Gyro ODR in Hz (integer part; 12.5 Hz reports 12). */
+inline constexpr uint32_t gyro_odr_hz(GyroOdr odr)
+{
+    switch (odr)
+    {
+        case GyroOdr::HZ_32000: return 32000;
+        case GyroOdr::HZ_16000: return 16000;
+        case GyroOdr::HZ_8000:  return 8000;
+        case GyroOdr::HZ_4000:  return 4000;
+        case GyroOdr::HZ_2000:  return 2000;
+        case GyroOdr::HZ_1000:  return 1000;
+        case GyroOdr::HZ_500:   return 500;
+        case GyroOdr::HZ_200:   return 200;
+        case GyroOdr::HZ_100:   return 100;
+        case GyroOdr::HZ_50:    return 50;
+        case GyroOdr::HZ_25:    return 25;
+        case GyroOdr::HZ_12_5:  return 12;
+    }
+    return 1000;
+}
+
 /** Accelerometer output data rate. Bits [3:0] of ACCEL_CONFIG0. */
 enum class AccelOdr : uint8_t
 {
@@ -487,6 +508,43 @@ struct Iim42653Config
             .fifo_watermark     = 1,
         };
     }
+
+    /**
+     * @brief Oversampled FIFO configuration for a 1 kHz decimated stream.
+     *
+     * Runs gyro + accel at @p factor × 1 kHz (2, 4 or 8 kHz) with the AAF
+     * opened up to match the higher Nyquist; the remaining anti-alias work
+     * is done by the ImuDecimator stage in SensorHub. Any other factor
+     * returns rocket_fifo() (1 kHz).
+     */
+    static constexpr Iim42653Config rocket_fifo_oversampled(uint8_t factor)
+    {
+        Iim42653Config cfg = rocket_fifo();
+        switch (factor)
+        {
+            case 2:
+                cfg.gyro_odr  = GyroOdr::HZ_2000;
+                cfg.accel_odr = AccelOdr::HZ_2000;
+                cfg.gyro_aaf  = AafBw::bw_997();
+                cfg.accel_aaf = AafBw::bw_997();
+                break;
+            case 4:
+                cfg.gyro_odr  = GyroOdr::HZ_4000;
+                cfg.accel_odr = AccelOdr::HZ_4000;
+                cfg.gyro_aaf  = AafBw::bw_1962();
+                cfg.accel_aaf = AafBw::bw_1962();
+                break;
+            case 8:
+                cfg.gyro_odr  = GyroOdr::HZ_8000;
+                cfg.accel_odr = AccelOdr::HZ_8000;
+                cfg.gyro_aaf  = AafBw::bw_1962();
+                cfg.accel_aaf = AafBw::bw_1962();
+                break;
+            default:
+                break;
+        }
+        return cfg;
+    }
 };
 
 /* ======================
@@ -568,6 +626,41 @@ class Iim42653
      */
     [[nodiscard]] bool flush_fifo();
 
+    /**
+     * @brief Change the FIFO watermark at runtime.
+     *
+     * INT1 fires once @p packets frames are buffered, so the consumer
+     * wakes ODR / packets times per second. Clamped to 1–130.
+     *
+     * @return true on success.
+     * @pre configure() called with enable_fifo = true.
+     */
+    [[nodiscard]] bool set_fifo_watermark(uint16_t packets);
+
+    /**
+     * @brief True if configured for FIFO (watermark-interrupt) acquisition.
+     */
+    [[nodiscard]] bool fifo_enabled() const
+    {
+        return fifo_enabled_;
+    }
+
+    /**
+     * @brief Configured gyro output data rate in Hz.
+     */
+    [[nodiscard]] uint32_t odr_hz() const
+    {
+        return gyro_odr_hz(config_.gyro_odr);
+    }
+
+    /**
+     * @brief Current FIFO watermark in packets.
+     */
+    [[nodiscard]] uint16_t fifo_watermark() const
+    {
+        return config_.fifo_watermark;
+    }
+
     /**
      *
      * Measures sensor output with self-test enabled and disabled,
@@ -687,6 +780,7 @@ class Iim42653
     [[nodiscard]] bool configure_notch_filter(const Iim42653Config &cfg);
     [[nodiscard]] bool configure_interrupts(const Iim42653Config &cfg);
     [[nodiscard]] bool configure_fifo(const Iim42653Config &cfg);
+    [[nodiscard]] bool write_fifo_watermark(uint16_t packets);
 
     /* FIFO helpers  */
 
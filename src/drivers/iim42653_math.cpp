@@ -0,0 +1,27 @@
+/*
+ * ACS4 Flight Computer — IIM-42653 Niezalezna platformowo matma
+ */
+
+#include "drivers/iim42653_math.h"
+
+namespace acs::iim42653
+{
+
+uint32_t fifo_delta_us(uint16_t raw_from, uint16_t raw_to)
+{
+    /* Odejmowanie 16-bit obsluguje pojedyncze przepelnienie licznika czujnika */
+    const auto raw_delta = static_cast<uint16_t>(raw_to - raw_from);
+    return (static_cast<uint32_t>(raw_delta) * 32U + 15U) / 30U;
+}
+
+uint32_t backdate_us(uint32_t ts_us, uint32_t delta_us, uint32_t wrap_us)
+{
+    if (ts_us >= delta_us || wrap_us == 0)
+    {
+        return ts_us - delta_us;
+    }
+    /* Przed przepelnieniem zegara hosta — stempel tuz pod wrap_us */
+    return ts_us + (wrap_us - delta_us);
+}
+
+}  // namespace acs::iim42653
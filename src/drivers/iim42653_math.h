@@ -0,0 +1,44 @@
+/*
+ * ACS4 Flight Computer — IIM-42653 Platform-Independent Math
+ *
+ * Pure computation functions for the IMU driver:
+ *   - FIFO timestamp reconstruction: sensor 16-bit timestamp deltas
+ *     scaled to host µs, newest sample anchored to the host clock and
+ *     earlier ones back-dated modulo the host clock period
+ *
+ * No RTOS or hardware dependencies — safe for unit tests on host.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace acs::iim42653
+{
+
+/**
+ * @brief Host µs between two FIFO samples from their sensor timestamps.
+ *
+ * The raw 16-bit difference handles one sensor-counter wrap (gap below
+ * 65.5 ms). Without CLKIN and with TMST_RES = 0 the sensor's 1 µs counter
+ * runs at 30/32 of real time (datasheet §12.7), so the difference is
+ * scaled by 32/30, rounded to nearest.
+ *
+ * @param raw_from  Sensor timestamp of the earlier sample.
+ * @param raw_to    Sensor timestamp of the later sample.
+ */
+uint32_t fifo_delta_us(uint16_t raw_from, uint16_t raw_to);
+
+/**
+ * @brief Host timestamp @p delta_us before @p ts_us.
+ *
+ * The host clock (timestamp_us()) wraps at @p wrap_us, so a sample just
+ * before a wrap gets a stamp near wrap_us, not near 2^32.
+ *
+ * @param ts_us     Later host timestamp, in [0, wrap_us).
+ * @param delta_us  Interval to step back, below wrap_us.
+ * @param wrap_us   Host clock period (TIMESTAMP_WRAP_US); 0 = 2^32.
+ */
+uint32_t backdate_us(uint32_t ts_us, uint32_t delta_us, uint32_t wrap_us);
+
+}  // namespace acs::iim42653
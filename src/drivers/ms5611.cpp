@@ -230,7 +230,7 @@ void Ms5611::compute_and_publish()
     s.pressure_pa   = pressure_pa;
     s.temperature_c = temperature_c;
     s.altitude_m    = ms5611::pressure_to_altitude(pressure_pa, qnh_pa_);
-    s.timestamp_us  = timestamp_us();
+    s.timestamp_us  = d1_mid_us_;
 
     chSysLock();
     last_sample_ = s;
@@ -267,7 +267,7 @@ void Ms5611::update()
 
         case State::WAIT_D1:
         {
-            if (timestamp_us() - conv_start_us_ < conv_time_us_)
+            if (timestamp_elapsed_us(conv_start_us_, timestamp_us()) < conv_time_us_)
             {
                 break;
             }
@@ -285,6 +285,14 @@ void Ms5611::update()
                 return;
             }
 
+            /* Cisnienie reprezentuje srodek konwersji D1, nie chwile publikacji
+             * (ta nastepuje dopiero po D2, ~1.5 konwersji pozniej) */
+            d1_mid_us_ = conv_start_us_ + conv_time_us_ / 2U;
+            if (d1_mid_us_ >= TIMESTAMP_WRAP_US)
+            {
+                d1_mid_us_ -= TIMESTAMP_WRAP_US; /* na zegarze timestamp_us() */
+            }
+
             /* Natychmiast rozpocznij konwersje D2 */
             {
                 const uint8_t cmd = CMD_CONVERT_D2 + static_cast<uint8_t>(osr_);
@@ -302,7 +310,7 @@ void Ms5611::update()
 
         case State::WAIT_D2:
         {
-            if (timestamp_us() - conv_start_us_ < conv_time_us_)
+            if (timestamp_elapsed_us(conv_start_us_, timestamp_us()) < conv_time_us_)
             {
                 break;
             }
@@ -45,7 +45,7 @@ struct BaroSample
     float    pressure_pa;   /* Skompensowane cisnienie, Pa */
     float    temperature_c; /* Skompensowana temeperatura, degC */
     float    altitude_m;    /* Wysokosc barometryczna (ISA lub QNH), m */
-    uint32_t timestamp_us;  /* host µs (DWT) na koncu konwersji */
+    uint32_t timestamp_us;  /* host µs (DWT) w srodku konwersji cisnienia (D1) */
 };
 
 /* ==================
@@ -217,6 +217,7 @@ class Ms5611
     uint32_t raw_d2_ = 0; /* raw temperature ADC */
 
     uint32_t conv_start_us_ = 0; /* timestamp when conversion was started */
+    uint32_t d1_mid_us_     = 0; /* midpoint of the last pressure conversion */
     uint32_t error_count_   = 0;
 
     BaroSample last_sample_ = {};
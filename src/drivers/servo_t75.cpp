@@ -5,8 +5,11 @@
 #include "drivers/servo_t75.h"
 
 #include "drivers/servo_t75_math.h"
+#include "utils/timestamp.h"
 
 extern "C" {
+#include "ch.h"
+
 #include "hal.h"
 }
 
@@ -36,10 +39,65 @@ uint8_t ServoBankT75::timer_channel_for_fin(uint8_t fin_idx)
  * 330 Hz @ 1 MHz tick PWM configuration (TIM4, 4 channels)
  * ===================================================================== */
 
+/* Bank obslugujacy przerwanie update TIM4 (jeden bank na plytce) */
+static ServoBankT75 *g_period_bank = nullptr;
+
+/* =====================================================================
+ * DMA burst: CCR1..CCR4 z jednego bufora na zdarzenie update TIM4
+ *
+ * DIER.UDE → zadanie DMA przy UEV; DCR (DBA = 13, DBL = 3) zamienia je
+ * w 4 zapisy do DMAR, czyli CCR1..CCR4. Strumien jednorazowy: tick_us()
+ * przygotowuje bufor i wlacza strumien, UEV go oproznia i strumien sam
+ * sie wylacza. Preload CCR jest wylaczony — burst tuz po UEV (licznik
+ * ~0, impuls >= 1000 µs) trafia jeszcze do biezacej ramki. Dlatego
+ * burst nie moze ruszyc w srodku ramki: zadanie UEV z okresu bez
+ * wlaczonego strumienia (pierwsze ticki po arm(), tick spozniony o
+ * ~0.5 ms) czeka w TIM4, wiec tick_us() kasuje je przed wlaczeniem.
+ * ===================================================================== */
+
+static constexpr uint32_t kBurstDmaMode = STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_MINC |
+                                          STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD |
+                                          STM32_DMA_CR_PL(3);
+
+/* Wyrownany do linii cache — cacheBufferFlush przed kazdym burstem */
+alignas(32) static uint32_t g_burst[servo_t75::kBurstChannels];
+
+static const stm32_dma_stream_t *g_burst_dma = nullptr;
+
+static void burst_dma_init(PWMDriver *pwm)
+{
+    if (g_burst_dma == nullptr)
+    {
+        g_burst_dma = dmaStreamAlloc(STM32_DMA_STREAM_ID_ANY, 2, nullptr, nullptr);
+    }
+    if (g_burst_dma == nullptr)
+    {
+        return; /* zostaje zapis CCR z CPU (z preloadem) */
+    }
+
+    dmaSetRequestSource(g_burst_dma, STM32_DMAMUX1_TIM4_UP);
+    dmaStreamSetPeripheral(g_burst_dma, &pwm->tim->DMAR);
+
+    pwm->tim->DCR = servo_t75::kTimDcrBurstCcr;
+    pwm->tim->CCMR1 &= ~(STM32_TIM_CCMR1_OC1PE | STM32_TIM_CCMR1_OC2PE);
+    pwm->tim->CCMR2 &= ~(STM32_TIM_CCMR2_OC3PE | STM32_TIM_CCMR2_OC4PE);
+}
+
+static void servo_pwm_period_cb(PWMDriver *pwmp)
+{
+    (void)pwmp;
+    if (g_period_bank != nullptr)
+    {
+        chSysLockFromISR();
+        g_period_bank->on_pwm_period_i();
+        chSysUnlockFromISR();
+    }
+}
+
 static const PWMConfig g_servo_pwm_cfg = {
     .frequency = 1'000'000U, /* 1 MHz tick → 1 µs per count */
     .period    = 3030U,       /* 3030 µs → 330.03 Hz */
-    .callback  = nullptr,
+    .callback  = servo_pwm_period_cb,
     .channels  = {
         {PWM_OUTPUT_ACTIVE_HIGH, nullptr}, /* CH1 = PD12 = fin 4 */
         {PWM_OUTPUT_ACTIVE_HIGH, nullptr}, /* CH2 = PD13 = fin 3 */
@@ -48,7 +106,7 @@ static const PWMConfig g_servo_pwm_cfg = {
     },
     .cr2  = 0,
     .bdtr = 0,
-    .dier = 0,
+    .dier = STM32_TIM_DIER_UDE, /* zadanie DMA burst przy UEV */
 };
 
 /* =====================================================================
@@ -62,10 +120,12 @@ bool ServoBankT75::init(PWMDriver *pwm, const ServoT75Config &cfg)
         return false;
     }
 
-    pwm_ = pwm;
-    cfg_ = cfg;
+    pwm_          = pwm;
+    cfg_          = cfg;
+    g_period_bank = this;
 
     pwmStart(pwm_, &g_servo_pwm_cfg);
+    burst_dma_init(pwm_);
 
     for (uint8_t i = 0; i < FIN_COUNT; ++i)
     {
@@ -93,6 +153,7 @@ void ServoBankT75::arm()
         current_us_[i] = cfg_.neutral_us[i];
         pwmEnableChannel(pwm_, kFinToTimerChannel[i], static_cast<pwmcnt_t>(current_us_[i]));
     }
+    pwmEnablePeriodicNotification(pwm_);
 }
 
 void ServoBankT75::disarm()
@@ -102,11 +163,19 @@ void ServoBankT75::disarm()
         return;
     }
 
+    pwmDisablePeriodicNotification(pwm_);
+    if (g_burst_dma != nullptr)
+    {
+        dmaStreamDisable(g_burst_dma);
+    }
     for (uint8_t i = 0; i < FIN_COUNT; ++i)
     {
         pwmDisableChannel(pwm_, kFinToTimerChannel[i]);
     }
 
+    chSysLock();
+    pending_ = false;
+    chSysUnlock();
     armed_ = false;
 }
 
@@ -155,7 +224,7 @@ void ServoBankT75::set_pulse_us(uint8_t fin_idx, uint16_t us)
     target_us_[fin_idx] = us;
 }
 
-void ServoBankT75::tick(uint32_t dt_ms)
+void ServoBankT75::tick_us(uint32_t dt_us, uint32_t cmd_us)
 {
     if (!initialized_)
     {
@@ -165,14 +234,83 @@ void ServoBankT75::tick(uint32_t dt_ms)
     for (uint8_t i = 0; i < FIN_COUNT; ++i)
     {
         current_us_[i] =
-            servo_t75::slew_step(current_us_[i], target_us_[i], cfg_.slew_us_per_ms, dt_ms);
+            servo_t75::slew_step_us(current_us_[i], target_us_[i], cfg_.slew_us_per_ms, dt_us);
+    }
 
-        if (armed_)
+    if (!armed_)
+    {
+        return;
+    }
+
+    chSysLock();
+    if (g_burst_dma != nullptr)
+    {
+        /* Niewystrzelony burst z poprzedniego ticku jest zastepowany */
+        dmaStreamDisable(g_burst_dma);
+        servo_t75::stage_burst(current_us_, kFinToTimerChannel, g_burst);
+        cacheBufferFlush(g_burst, sizeof(g_burst));
+        dmaStreamSetMemory0(g_burst_dma, g_burst);
+        dmaStreamSetTransactionSize(g_burst_dma, servo_t75::kBurstChannels);
+        dmaStreamSetMode(g_burst_dma, kBurstDmaMode);
+        /* Zalegle zadanie UEV odpaliloby burst od razu, w srodku ramki
+         * (skrocony albo drugi impuls) — UDE 0 → 1 je kasuje */
+        pwm_->tim->DIER &= ~STM32_TIM_DIER_UDE;
+        pwm_->tim->DIER |= STM32_TIM_DIER_UDE;
+        dmaStreamEnable(g_burst_dma);
+    }
+    else
+    {
+        /* CCR z preloadem — nowe szerokosci wchodza przy nastepnym update */
+        for (uint8_t i = 0; i < FIN_COUNT; ++i)
         {
-            pwmEnableChannel(
-                pwm_, kFinToTimerChannel[i], static_cast<pwmcnt_t>(current_us_[i]));
+            pwmEnableChannelI(pwm_, kFinToTimerChannel[i], static_cast<pwmcnt_t>(current_us_[i]));
         }
     }
+    if (cmd_us != 0 && cmd_us != last_cmd_us_)
+    {
+        last_cmd_us_    = cmd_us;
+        pending_cmd_us_ = cmd_us;
+        pending_        = true;
+    }
+    chSysUnlock();
+}
+
+void ServoBankT75::on_pwm_period_i()
+{
+    if (!pending_)
+    {
+        return;
+    }
+    pending_ = false;
+
+    const uint32_t lat = timestamp_elapsed_us(pending_cmd_us_, timestamp_us());
+    latency_.last_us   = lat;
+    latency_.total_us += lat;
+    ++latency_.count;
+    if (lat > latency_.max_us)
+    {
+        latency_.max_us = lat;
+    }
+}
+
+bool ServoBankT75::burst_dma() const
+{
+    return g_burst_dma != nullptr;
+}
+
+ServoLatencyStats ServoBankT75::latency_stats() const
+{
+    chSysLock();
+    const ServoLatencyStats s = latency_;
+    chSysUnlock();
+    return s;
+}
+
+void ServoBankT75::reset_latency_stats()
+{
+    chSysLock();
+    latency_ = {};
+    chSysUnlock();
 }
 
 #else /* HAL_USE_PWM == FALSE (Nucleo dev build — no PWM hardware) */
@@ -198,7 +336,25 @@ void ServoBankT75::set_pulse_us(uint8_t, uint16_t)
 {
 }
 
-void ServoBankT75::tick(uint32_t)
+void ServoBankT75::tick_us(uint32_t, uint32_t)
+{
+}
+
+bool ServoBankT75::burst_dma() const
+{
+    return false;
+}
+
+ServoLatencyStats ServoBankT75::latency_stats() const
+{
+    return {};
+}
+
+void ServoBankT75::reset_latency_stats()
+{
+}
+
+void ServoBankT75::on_pwm_period_i()
 {
 }
 
@@ -12,9 +12,19 @@
  *
  * Control model:
  *   - Caller sets targets via set_angle_deg() or set_pulse_us().
- *   - tick(dt_ms) is called from ActuatorThread at 100 Hz; it applies
- *     a slew-rate limiter between current and target, then pushes the
- *     current value to the PWM channel.
+ *   - tick_us(dt_us, cmd_us) is called from ActuatorThread whenever the
+ *     control law posts a command (10 ms fallback); it applies a slew-rate
+ *     limiter over the measured interval, then stages the four widths
+ *     for a TIM4 DMA burst (DCR/DMAR): on the next update event one DMA
+ *     request writes CCR1..CCR4 together, so all fins move in the same
+ *     PWM frame. A request left pending by a frame without a staged
+ *     burst is cleared first, so a burst never lands mid-frame. If no
+ *     DMA stream is available the CCRs are written by
+ *     the CPU with compare preload on (also latched at the next update).
+ *
+ * Latency: while armed, the TIM4 update interrupt stamps the first frame
+ * that carries a new command; command timestamp → frame start is kept in
+ * ServoLatencyStats (shell `servo latency`).
  *
  * Fail-safe:
  *   - init() leaves the bank disarmed: channels are NOT enabled, pins stay LOW.
@@ -80,6 +90,17 @@ struct ServoT75Config
     }
 };
 
+/**
+ * @brief Command → PWM frame latency (DWT µs), updated from the TIM4 ISR.
+ */
+struct ServoLatencyStats
+{
+    uint32_t last_us;
+    uint32_t max_us;
+    uint32_t total_us;
+    uint32_t count;
+};
+
 /* =====================================================================
  * ServoBankT75 — 4-channel PWM driver
  * ===================================================================== */
@@ -124,7 +145,7 @@ class ServoBankT75
      * @brief Command a deflection angle (degrees) on one fin.
      *
      * Maps through angle_to_pulse_us(). Has no immediate effect on the pin —
-     * the slew limiter in tick() moves current toward this new target.
+     * the slew limiter in tick_us() moves current toward this new target.
      *
      * @param fin_idx  0..FIN_COUNT-1 (fin 1 = index 0).
      * @param deg      Commanded angle in degrees.
@@ -142,13 +163,33 @@ class ServoBankT75
     void set_pulse_us(uint8_t fin_idx, uint16_t us);
 
     /**
-     * @brief Advance the slew limiter by `dt_ms` milliseconds and push the
-     *        current pulse width to the hardware (only while armed).
+     * @brief Advance the slew limiter by `dt_us` and write the current
+     *        pulse widths to the timer (only while armed).
+     *
+     * Called from ActuatorThread with the measured interval since the
+     * previous call. Widths latch at the next TIM4 update event.
      *
-     * Should be called at a steady rate from ActuatorThread (100 Hz →
-     * dt_ms = 10).
+     * @param dt_us   Time since the previous tick (µs).
+     * @param cmd_us  timestamp_us() of the command being applied; a value
+     *                different from the previous call starts a latency
+     *                measurement (0 = do not measure).
      */
-    void tick(uint32_t dt_ms);
+    void tick_us(uint32_t dt_us, uint32_t cmd_us);
+
+    /** True if CCR updates go through the TIM4 DMA burst. */
+    [[nodiscard]] bool burst_dma() const;
+
+    /**
+     * @brief Snapshot of the command → PWM latency statistics.
+     */
+    [[nodiscard]] ServoLatencyStats latency_stats() const;
+
+    void reset_latency_stats();
+
+    /**
+     * @brief TIM4 update-event hook (ISR context, under chSysLockFromISR).
+     */
+    void on_pwm_period_i();
 
     [[nodiscard]] bool is_initialized() const
     {
@@ -160,6 +201,11 @@ class ServoBankT75
         return armed_;
     }
 
+    [[nodiscard]] const ServoT75Config &config() const
+    {
+        return cfg_;
+    }
+
     /**
      * @brief Current pulse width actually being output to the pin (µs).
      *        Returns 0 if fin_idx is out of range.
@@ -192,6 +238,12 @@ class ServoBankT75
 
     uint16_t target_us_[FIN_COUNT]  = {0, 0, 0, 0};
     uint16_t current_us_[FIN_COUNT] = {0, 0, 0, 0};
+
+    /* Pomiar opoznienia: zapis w watku, odczyt w ISR — pod chSysLock */
+    uint32_t          last_cmd_us_    = 0;
+    uint32_t          pending_cmd_us_ = 0;
+    bool              pending_        = false;
+    ServoLatencyStats latency_        = {};
 };
 
 /**
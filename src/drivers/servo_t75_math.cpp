@@ -47,12 +47,17 @@ uint16_t angle_to_pulse_us(float deg, const Limits &lim, float max_angle_deg)
 
 uint16_t slew_step(uint16_t current, uint16_t target, float us_per_ms, uint32_t dt_ms)
 {
-    if (current == target || dt_ms == 0 || us_per_ms <= 0.0f)
+    return slew_step_us(current, target, us_per_ms, dt_ms * 1000U);
+}
+
+uint16_t slew_step_us(uint16_t current, uint16_t target, float us_per_ms, uint32_t dt_us)
+{
+    if (current == target || dt_us == 0 || us_per_ms <= 0.0f)
     {
         return current;
     }
 
-    const float max_delta = us_per_ms * static_cast<float>(dt_ms);
+    const float max_delta = us_per_ms * static_cast<float>(dt_us) * 1e-3f;
     const int   diff      = static_cast<int>(target) - static_cast<int>(current);
 
     if (static_cast<float>(std::abs(diff)) <= max_delta)
@@ -75,4 +80,31 @@ uint16_t slew_step(uint16_t current, uint16_t target, float us_per_ms, uint32_t
     return static_cast<uint16_t>(new_pulse_i);
 }
 
+void stage_burst(const uint16_t (&pulse_by_fin)[kBurstChannels],
+                 const uint8_t (&fin_to_channel)[kBurstChannels],
+                 uint32_t (&burst)[kBurstChannels])
+{
+    for (size_t fin = 0; fin < kBurstChannels; ++fin)
+    {
+        burst[fin_to_channel[fin] % kBurstChannels] = pulse_by_fin[fin];
+    }
+}
+
+size_t burst_apply(TimShadow &tim, uint32_t dcr, const uint32_t *words)
+{
+    const uint32_t dba = dcr & 0x1FU;
+    const uint32_t len = ((dcr >> 8) & 0x1FU) + 1U;
+    if (dba + len > TimShadow::kWords)
+    {
+        return 0;
+    }
+
+    /* Kazdy zapis do DMAR trafia pod DBA + k */
+    for (uint32_t k = 0; k < len; ++k)
+    {
+        tim.regs[dba + k] = words[k];
+    }
+    return len;
+}
+
 }  // namespace acs::servo_t75
@@ -3,7 +3,8 @@
  *
  * Pure computation functions for the servo driver:
  *   - Angle (deg) → pulse width (µs) mapping with trim, direction, clamping
- *   - Slew-rate-limited step toward a target pulse width
+ *   - Slew-rate-limited step toward a target pulse width (ms or µs dt)
+ *   - TIM DMA-burst staging (DCR / DMAR) and a shadow-register model of it
  *
  * No RTOS or hardware dependencies — safe for unit tests on host.
  *
@@ -13,11 +14,65 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace acs::servo_t75
 {
 
+/* =====================================================================
+ * TIM DMA burst (CCR1..CCR4 in one request)
+ *
+ * DCR.DBA selects the first register (word offset from the timer base),
+ * DCR.DBL the burst length − 1. Each DMA write to DMAR lands in register
+ * DBA + k; on an update-event request the timer issues DBL + 1 writes,
+ * so one staged 4-word buffer updates all four compare registers in the
+ * same PWM frame.
+ * ===================================================================== */
+
+inline constexpr size_t   kBurstChannels  = 4;
+inline constexpr uint32_t kTimCcr1Offset  = 0x34U; /* TIMx_CCR1, bytes */
+inline constexpr uint32_t kTimDcrDba      = kTimCcr1Offset / 4U;
+inline constexpr uint32_t kTimDcrDbl      = kBurstChannels - 1U;
+inline constexpr uint32_t kTimDcrBurstCcr = (kTimDcrDbl << 8) | kTimDcrDba;
+
+/**
+ * @brief Order per-fin pulse widths into the DMA burst buffer.
+ *
+ * Burst slot k is written to CCR(k + 1), i.e. timer channel index k.
+ *
+ * @param pulse_by_fin     Pulse width per fin (µs = timer counts).
+ * @param fin_to_channel   Timer channel index (0..3) per fin.
+ * @param burst            [out] Words in CCR1..CCR4 order.
+ */
+void stage_burst(const uint16_t (&pulse_by_fin)[kBurstChannels],
+                 const uint8_t (&fin_to_channel)[kBurstChannels],
+                 uint32_t (&burst)[kBurstChannels]);
+
+/**
+ * @brief DCR-addressable part of a timer register file (DBA is 5 bits).
+ *
+ * Host stand-in for TIMx used to verify burst staging.
+ */
+struct TimShadow
+{
+    static constexpr size_t kWords = 32;
+    uint32_t                regs[kWords];
+
+    [[nodiscard]] uint32_t ccr(size_t channel) const
+    {
+        return regs[kTimDcrDba + channel];
+    }
+};
+
+/**
+ * @brief Model one update-event DMA burst: DBL + 1 DMAR writes.
+ *
+ * @return Number of words written (0 if the burst would run past the
+ *         DCR-addressable range).
+ */
+size_t burst_apply(TimShadow &tim, uint32_t dcr, const uint32_t *words);
+
 struct Limits
 {
     uint16_t neutral_us;     /* per-channel mechanical zero pulse */
@@ -56,4 +111,12 @@ uint16_t angle_to_pulse_us(float deg, const Limits &lim, float max_angle_deg);
  */
 uint16_t slew_step(uint16_t current, uint16_t target, float us_per_ms, uint32_t dt_ms);
 
+/**
+ * @brief slew_step() with the elapsed time in microseconds.
+ *
+ * ActuatorThread runs off control-law notifications, not a fixed period,
+ * so it passes the measured interval (DWT) rather than a nominal 10 ms.
+ */
+uint16_t slew_step_us(uint16_t current, uint16_t target, float us_per_ms, uint32_t dt_us);
+
 }  // namespace acs::servo_t75
@@ -101,4 +101,23 @@ bool sdmmc_free_space(uint32_t &total_mb, uint32_t &free_mb)
     return true;
 }
 
+bool sdmmc_write_sectors(uint32_t lba, const uint8_t *buf, uint32_t count)
+{
+    if (!s_mounted || count == 0)
+    {
+        return false;
+    }
+
+    /* Ten sam semafor co FatFs (FF_FS_REENTRANT) — shell "sd ls" czy
+     * f_getfree nie wejda w trakcie transferu */
+    if (ff_req_grant(s_fs.sobj) == 0)
+    {
+        return false;
+    }
+    const bool ok = (sdcWrite(&SDCD1, lba, buf, count) == HAL_SUCCESS);
+    ff_rel_grant(s_fs.sobj);
+
+    return ok;
+}
+
 }  // namespace acs
@@ -2,7 +2,8 @@
  * ACS4 Flight Computer — SDMMC + FatFs Interface
  *
  * Wraps ChibiOS SDC driver (SDMMC1, 4-bit) and FatFs filesystem.
- * Provides mount/unmount, card detect, and free-space queries.
+ * Provides mount/unmount, card detect, free-space queries and raw sector
+ * writes into preallocated (f_expand) files.
  *
  * Hardware: SDMMC1 on PC8-PC12 (D0-D3, CLK), PD2 (CMD), PA15 (DETECT_SD).
  */
@@ -52,4 +53,19 @@ void sdmmc_unmount();
  */
 bool sdmmc_free_space(uint32_t &total_mb, uint32_t &free_mb);
 
+/**
+ * @brief Write whole sectors straight to the card, bypassing FatFs.
+ *
+ * Holds the FatFs volume lock for the transfer, so it never interleaves
+ * with f_* calls from other threads. Only for sectors owned by a file
+ * preallocated with f_expand() — FatFs does not know about these writes.
+ *
+ * @param lba    First sector (absolute, as from FATFS::database).
+ * @param buf    Source, 32-byte aligned for the SDMMC IDMA (D-cache
+ *               line); FF_MAX_SS bytes per sector.
+ * @param count  Number of sectors.
+ * @return true on success.
+ */
+bool sdmmc_write_sectors(uint32_t lba, const uint8_t *buf, uint32_t count);
+
 }  // namespace acs
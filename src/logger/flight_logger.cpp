@@ -1,18 +1,28 @@
 /*
  * ACS4 Flight Computer — Flight Logger Implementation
  *
- * Dual 16 KiB buffers, swap-on-full, semaphore-driven flush to SD.
+ * Producers → 16 KiB lock-free LogRing → LogPackThread → pool of 8 KiB
+ * buffers (objects FIFO) → LoggerThread → sector-aligned writes: raw
+ * SDMMC multi-block writes into a file preallocated with f_expand(), or
+ * f_write + periodic f_sync when the card has no contiguous space left.
+ * Each buffer's records are sealed into one CRC frame (log_format.h).
+ * Past log.rotate_mb / log.rotate_s the log continues in the next file.
  */
 
 #include "logger/flight_logger.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 #include "hal/sdmmc.h"
+#include "logger/log_profile.h"
+#include "logger/log_ring.h"
 #include "logger/ram_log.h"
 #include "system/error_handler.h"
+#include "system/params.h"
 #include "utils/timestamp.h"
 
 extern "C" {
@@ -26,48 +36,191 @@ namespace acs
 
 /* ── Constants ────────────────────────────────────────────────────────────── */
 
-static constexpr size_t BUF_SIZE = 16384;
+static constexpr size_t   RING_SIZE = 16384;
+static constexpr size_t   BUF_SIZE  = 8192; /* 16 sectors */
+static constexpr size_t   SECTOR    = 512;
+static constexpr uint32_t DRAIN_MS  = 10;
+
+/* Glebokosc puli: 6 × 8 KiB + pierscien 16 KiB ≈ 1.5 s przy ~40 KiB/s —
+ * z zapasem na odsmiecanie karty (100+ ms na tanich kartach) */
+static constexpr size_t POOL_BUFS = 6;
+
+static_assert(LOG_MAX_RECORD_SIZE <= LogRing<RING_SIZE>::kMaxRecord, "record > ring limit");
+static_assert(LOG_MAX_RECORD_SIZE + SECTOR + sizeof(LogFrameHeader) <= BUF_SIZE,
+              "buffer too small for carry-over");
+static_assert(POOL_BUFS >= 2, "pool needs a packing and a writing buffer");
+static_assert(sizeof(LogFileHeader) + log_schema_size() + sizeof(LogFrameHeader) +
+                      LOG_MAX_RECORD_SIZE <= BUF_SIZE,
+              "file header + schema must fit the first buffer");
+static_assert(BUF_SIZE <= UINT16_MAX, "frame payload length is 16-bit");
 
 /* ── State ────────────────────────────────────────────────────────────────── */
 
-static uint8_t s_buf[2][BUF_SIZE] __attribute__((aligned(4)));
+/* Producers (any thread / ISR) */
+static LogRing<RING_SIZE> s_ring;
+static LogDecimator       s_decim; /* profil logowania — FULL po starcie */
+
+/* Bufor puli; data na poczatku — wyrownanie 32 B dla IDMA SDMMC */
+struct alignas(32) LogBuf
+{
+    uint8_t data[BUF_SIZE];
+    size_t  len;
+    size_t  frame;  /* offset naglowka otwartej ramki */
+    bool    last;   /* ostatni bufor pliku — LoggerThread zamyka plik */
+    bool    rotate; /* ... i otwiera nastepny (rotacja) */
+};
+
+static LogBuf            s_pool[POOL_BUFS];
+static msg_t             s_pool_msgs[POOL_BUFS];
+static objects_fifo_t    s_pool_fifo;
+static std::atomic<bool> s_pool_ready{false};
 
-static volatile uint8_t  s_active        = 0;
-static volatile size_t   s_write_pos     = 0;
-static volatile size_t   s_flush_len     = 0;
-static volatile bool     s_flush_pending = false;
+/* Bufor pakowany przez LogPackThread; logger_start() ustawia, watek
+ * zeruje po wyslaniu ostatniego */
+static std::atomic<LogBuf *> s_pack{nullptr};
 
-static binary_semaphore_t s_flush_sem;
+static std::atomic<uint32_t> s_bufs_queued{0}; /* wyslane, jeszcze nie zapisane */
+static uint32_t              s_bufs_peak    = 0;
+static uint32_t              s_pool_starved = 0;
 
 static FIL                      s_file;
-static bool                     s_file_open = false;
+static std::atomic<bool>        s_file_open{false};
 static std::atomic<LoggerState> s_state{LoggerState::IDLE};
+static std::atomic<bool>        s_stop_req{false};
 
-static uint32_t s_records   = 0;
-static uint32_t s_bytes     = 0;
-static uint32_t s_flushes   = 0;
-static uint32_t s_flush_err = 0;
-static uint32_t s_overflows = 0;
+static uint32_t s_records      = 0;
+static uint32_t s_bytes        = 0; /* wszystkie pliki od logger_start() */
+static uint32_t s_file_bytes   = 0; /* biezacy plik (pozycja zapisu) */
+static uint32_t s_files        = 0; /* pliki od logger_start() (rotacja) */
+static uint32_t s_flushes      = 0;
+static uint32_t s_flush_err    = 0;
+static uint32_t s_drop_base    = 0; /* s_ring.dropped() at logger_start() */
 static char     s_filename[32] = {};
 
+/* Ramki jednego pliku: ziarno CRC (z naglowka) i numer nastepnej */
+struct FrameStream
+{
+    uint32_t seed;
+    uint32_t seq;
+};
+
+static FrameStream s_frames{}; /* LOG_NNN.BIN */
+
+/* Rotacja — stan LogPackThread: ile spakowano do biezacego pliku i od kiedy */
+static uint32_t  s_pack_file_bytes = 0;
+static systime_t s_pack_file_start = 0;
+
+/* Tryb ciagly: plik zaalokowany f_expand(), LoggerThread pisze sektory
+ * bezposrednio (FatFs nie dotyka FAT ani katalogu do zamkniecia) */
+static bool     s_contig         = false;
+static uint32_t s_contig_lba     = 0; /* pierwszy sektor pliku */
+static uint32_t s_contig_sectors = 0;
+static uint32_t s_prealloc_mb    = 0;
+
+/* Tryb FatFs: f_sync co log.sync_ms zamiast po kazdym zapisie */
+static bool      s_sync_pending = false;
+static systime_t s_last_sync    = 0;
+
+static systime_t        s_start_time    = 0;
+static uint64_t         s_write_busy_us = 0; /* laczny czas zapisow + f_sync */
+static WriteLatencyHist s_write_hist;        /* [us] na zapis bufora / f_sync */
+
+static std::atomic<bool> s_bench{false};
+static constexpr char    BENCH_FILE[] = "BENCH.BIN";
+
+/* Zrzut RAM logu (pre-trigger) do PRE_NNN.BIN — LoggerThread, porcjami */
+static std::atomic<bool>     s_dump_req{false};
+static std::atomic<uint32_t> s_dump_window_ms{0}; /* 0 = caly RAM log */
+static bool              s_dump_active = false;
+static FIL               s_dump_file;
+static LogBuf           *s_dump_buf = nullptr;
+static RamLogCursor      s_dump_cur{};
+static FrameStream       s_dump_frames{};
+static uint32_t          s_dump_bytes = 0;
+static uint32_t          s_dumps      = 0;
+static char              s_dump_name[16] = {};
+
+/* Bez otwartego pliku (IDLE + log.pretrig): pierscien → tylko RAM log */
+static uint8_t s_ram_scratch[2048];
+
+static int s_log_index = 0; /* NNN biezacego LOG_NNN.BIN */
+
+/* Nastepny wolny NNN z LOG_IDX.TXT — jeden f_stat zamiast do 999.
+ * 0 = jeszcze nie wczytany (po zamontowaniu karty) */
+static constexpr char    INDEX_FILE[] = "LOG_IDX.TXT";
+static FIL               s_index_file; /* FIL ma bufor sektora — nie na stosie */
+static int               s_next_log   = 0;
+static std::atomic<bool> s_index_dirty{false}; /* LoggerThread zapisze plik */
+
+static ParamRef s_p_prealloc;
+static ParamRef s_p_sync_ms;
+static ParamRef s_p_pretrig;
+static ParamRef s_p_rotate_mb;
+static ParamRef s_p_rotate_s;
+
+static THD_WORKING_AREA(waLogPack, 1024);
+
 /* ── Helpers ──────────────────────────────────────────────────────────────── */
 
+/* Ostatni uzyty NNN z pliku indeksu (0 = brak / nieczytelny) */
+static int read_log_index()
+{
+    char text[8] = {};
+    UINT br      = 0;
+    if (f_open(&s_index_file, INDEX_FILE, FA_READ) != FR_OK)
+    {
+        return 0;
+    }
+    (void)f_read(&s_index_file, text, sizeof(text) - 1, &br);
+    f_close(&s_index_file);
+
+    const long n = strtol(text, nullptr, 10);
+    return (n >= 1 && n <= 999) ? static_cast<int>(n) : 0;
+}
+
+/* Zapis z LoggerThread, poza logger_start() — start nie czeka na FAT */
+static void write_log_index()
+{
+    char text[8];
+    UINT bw = 0;
+    chsnprintf(text, sizeof(text), "%d\n", s_log_index);
+    if (f_open(&s_index_file, INDEX_FILE, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK)
+    {
+        return; /* tylko przyspieszenie — bez pliku dziala skanowanie */
+    }
+    (void)f_write(&s_index_file, text, strlen(text), &bw);
+    f_close(&s_index_file);
+}
+
+/* Od NNN z indeksu: zwykle pierwszy f_stat trafia w wolna nazwe. Indeks
+ * nieaktualny (karta zmieniana na PC) — dalej po kolei, a po 999 od 1. */
 static bool find_next_filename()
 {
-    for (int i = 1; i <= 999; i++)
+    if (s_next_log == 0)
     {
+        s_next_log = read_log_index() + 1;
+    }
+
+    for (int k = 0; k < 999; k++)
+    {
+        const int i = (s_next_log - 1 + k) % 999 + 1;
         chsnprintf(s_filename, sizeof(s_filename), "LOG_%03d.BIN", i);
 
         FILINFO fno;
         if (f_stat(s_filename, &fno) == FR_NO_FILE)
         {
+            s_log_index = i;
+            s_next_log  = i % 999 + 1;
+            s_index_dirty.store(true);
             return true;
         }
     }
     return false;
 }
 
-static bool write_file_header()
+/* Naglowek idzie przez pierwszy bufor — wszystkie f_write od offsetu 0
+ * sa wielokrotnoscia sektora, FatFs pisze je bez kopii do okna */
+static FrameStream stage_file_header(LogBuf &buf)
 {
     LogFileHeader hdr{};
     memcpy(hdr.magic, LOG_MAGIC, 4);
@@ -75,27 +228,352 @@ static bool write_file_header()
     hdr.sysclk_hz    = STM32_SYS_CK;
     hdr.boot_time_ms = static_cast<uint32_t>(chTimeI2MS(chVTGetSystemTimeX()));
 
-    UINT bw = 0;
-    const FRESULT res = f_write(&s_file, &hdr, sizeof(hdr), &bw);
-    return (res == FR_OK) && (bw == sizeof(hdr));
+    memcpy(buf.data, &hdr, sizeof(hdr));
+    buf.len = sizeof(hdr);
+    buf.len += log_schema_write(&buf.data[buf.len], BUF_SIZE - buf.len); /* v4 */
+    buf.last   = false;
+    buf.rotate = false;
+    return FrameStream{log_frame_seed(hdr), 0};
+}
+
+/* Ramka zaczyna sie tam, gdzie konczy sie zawartosc bufora (naglowek
+ * pliku albo przeniesiona koncowka poprzedniej ramki) */
+static void open_frame(LogBuf &buf)
+{
+    buf.frame = buf.len;
+    buf.len += sizeof(LogFrameHeader);
+}
+
+/* Naglowek + CRC; pusta ramka znika */
+static void seal_frame(LogBuf &buf, FrameStream &fs)
+{
+    const size_t payload = buf.len - buf.frame - sizeof(LogFrameHeader);
+    if (payload == 0)
+    {
+        buf.len = buf.frame;
+        return;
+    }
+    log_frame_seal(&buf.data[buf.frame], fs.seq++, payload, fs.seed);
+}
+
+static void account_write(uint32_t t0)
+{
+    const uint32_t dt = timestamp_elapsed_us(t0, timestamp_us());
+    s_write_busy_us += dt;
+    s_write_hist.add(dt);
+}
+
+static void reset_write_stats()
+{
+    s_records   = 0;
+    s_bytes     = 0;
+    s_files     = 1;
+    s_flushes   = 0;
+    s_flush_err = 0;
+    s_drop_base = s_ring.dropped();
+
+    s_sync_pending  = false;
+    s_start_time    = chVTGetSystemTimeX();
+    s_last_sync     = s_start_time;
+    s_write_busy_us = 0;
+    s_write_hist.reset();
+    s_bufs_peak    = 0;
+    s_pool_starved = 0;
+}
+
+/* f_open + prealokacja ciagla; gdy brak miejsca w jednym kawalku — zwykly
+ * f_write. f_sync zapisuje wpis katalogu (klaster startowy, rozmiar) raz —
+ * potem podczas zapisu zadnych zapisow metadanych. */
+static bool open_file(const char *name, BYTE mode, uint32_t prealloc_mb)
+{
+    if (f_open(&s_file, name, mode) != FR_OK)
+    {
+        return false;
+    }
+
+    s_contig      = false;
+    s_prealloc_mb = prealloc_mb;
+    s_file_bytes  = 0;
+    if (prealloc_mb > 0 && f_expand(&s_file, FSIZE_t{prealloc_mb} << 20U, 1) == FR_OK &&
+        f_sync(&s_file) == FR_OK)
+    {
+        const FATFS *fs  = s_file.obj.fs;
+        s_contig_lba     = fs->database + fs->csize * (s_file.obj.sclust - 2U);
+        s_contig_sectors = prealloc_mb << 11U; /* MiB → sektory 512 B */
+        s_contig         = true;
+    }
+    return true;
+}
+
+/* Zapis jednego bufora; niepelny sektor tylko w ostatnim. Nieudany
+ * bufor przepada (flush_errors), kolejny trafia w to samo miejsce. */
+static void write_buf(LogBuf &buf)
+{
+    const size_t   len     = buf.len;
+    const size_t   sectors = (len + SECTOR - 1) / SECTOR;
+    const uint32_t t0      = timestamp_us();
+    bool           ok      = false;
+    bool           full    = false;
+
+    if (len == 0)
+    {
+        return;
+    }
+
+    /* Koniec prealokacji: dalej przez FatFs od biezacej pozycji
+     * (s_file_bytes to wtedy dokladnie rozmiar pliku) */
+    if (s_contig && s_file_bytes / SECTOR + sectors > s_contig_sectors)
+    {
+        s_contig = false;
+        if (f_lseek(&s_file, s_file_bytes) != FR_OK)
+        {
+            error_report(ErrorCode::SD_WRITE_FAIL);
+            s_state.store(LoggerState::ERROR);
+            return;
+        }
+    }
+
+    if (s_contig)
+    {
+        /* Ogon dopelniony zerami; f_truncate() przy zamknieciu go odetnie */
+        memset(&buf.data[len], 0, sectors * SECTOR - len);
+        ok = sdmmc_write_sectors(s_contig_lba + s_file_bytes / SECTOR, buf.data,
+                                 static_cast<uint32_t>(sectors));
+    }
+    else
+    {
+        UINT          bw  = 0;
+        const FRESULT res = f_write(&s_file, buf.data, len, &bw);
+        ok                = (res == FR_OK && bw == len);
+        full              = (res == FR_OK && bw < len);
+        s_sync_pending |= ok;
+    }
+    account_write(t0);
+
+    if (ok)
+    {
+        s_bytes += static_cast<uint32_t>(len);
+        s_file_bytes += static_cast<uint32_t>(len);
+        s_flushes++;
+        return;
+    }
+
+    s_flush_err++;
+    if (full)
+    {
+        error_report(ErrorCode::SD_FULL);
+        s_state.store(LoggerState::ERROR);
+    }
+    else
+    {
+        error_report(ErrorCode::SD_WRITE_FAIL);
+        if (s_flush_err >= 10)
+        {
+            s_state.store(LoggerState::ERROR);
+        }
+    }
+}
+
+static void finish_file()
+{
+    if (s_contig)
+    {
+        /* Rozmiar = dane; niewykorzystana prealokacja wraca do FAT */
+        if (f_lseek(&s_file, s_file_bytes) != FR_OK || f_truncate(&s_file) != FR_OK)
+        {
+            error_report(ErrorCode::SD_WRITE_FAIL);
+        }
+        s_contig = false;
+    }
+    f_close(&s_file);
+    s_sync_pending = false;
+}
+
+static void close_file()
+{
+    finish_file();
+    s_file_open.store(false);
+    s_stop_req.store(false);
+}
+
+/* Prealokacja na plik: przy rotacji po rozmiarze wystarczy rotate_mb
+ * (+1 MiB na ostatni bufor) — f_expand() nie rezerwuje za duzo */
+static uint32_t prealloc_per_file()
+{
+    const auto prealloc = static_cast<uint32_t>(s_p_prealloc.get_or(0.0f));
+    const auto rotate   = static_cast<uint32_t>(s_p_rotate_mb.get_or(0.0f));
+    return (rotate > 0) ? std::min(prealloc, rotate + 1U) : prealloc;
+}
+
+/* Rotacja w LoggerThread: zamkniecie jak przy stopie, potem kolejny
+ * LOG_NNN.BIN; bufory czekaja w kolejce na czas f_expand() */
+static void rotate_file()
+{
+    finish_file();
+    if (!find_next_filename() ||
+        !open_file(s_filename, FA_WRITE | FA_CREATE_NEW, prealloc_per_file()))
+    {
+        error_report(ErrorCode::SD_WRITE_FAIL);
+        s_state.store(LoggerState::ERROR); /* s_file_open zostaje do logger_stop() */
+        return;
+    }
+    s_files++;
+}
+
+/* LogPackThread: czas zaczac nastepny plik? */
+static bool rotate_due()
+{
+    const auto mb = static_cast<uint32_t>(s_p_rotate_mb.get_or(0.0f));
+    const auto s  = static_cast<uint32_t>(s_p_rotate_s.get_or(0.0f));
+    return (mb > 0 && s_pack_file_bytes >= (mb << 20U)) ||
+           (s > 0 && chVTTimeElapsedSinceX(s_pack_file_start) >= TIME_S2I(s));
+}
+
+/* Metadane FatFs (rozmiar, FAT) — najwyzej co log.sync_ms */
+static void sync_if_due()
+{
+    const auto period = static_cast<uint32_t>(s_p_sync_ms.get_or(1000.0f));
+    if (!s_sync_pending || chVTTimeElapsedSinceX(s_last_sync) < TIME_MS2I(period))
+    {
+        return;
+    }
+
+    const uint32_t t0 = timestamp_us();
+    if (f_sync(&s_file) != FR_OK)
+    {
+        s_flush_err++;
+        error_report(ErrorCode::SD_WRITE_FAIL);
+    }
+    account_write(t0);
+    s_sync_pending = false;
+    s_last_sync    = chVTGetSystemTimeX();
+}
+
+/* Przekazanie pelnego bufora do LoggerThread */
+static void post_buf(LogBuf *buf)
+{
+    const uint32_t queued = s_bufs_queued.fetch_add(1) + 1;
+    if (queued > s_bufs_peak)
+    {
+        s_bufs_peak = queued;
+    }
+    chFifoSendObject(&s_pool_fifo, buf);
+}
+
+/* Pierscien → bufor (+ lustro RAM logu). Prawie pelny bufor zamyka
+ * ramke i idzie do zapisu w calych sektorach; reszta (koniec tej ramki)
+ * przechodzi do nastepnego, gdzie otwiera sie nowa. Przy rotacji bufor
+ * idzie caly jako ostatni pliku, a nastepny zaczyna nowy plik od
+ * naglowka. Bez wolnego bufora (po czasie wait) rekordy czekaja w
+ * pierscieniu. */
+static LogBuf *pack_ring(LogBuf *cur, sysinterval_t wait)
+{
+    while (true)
+    {
+        uint32_t     recs = 0;
+        const size_t n    = s_ring.read(&cur->data[cur->len], BUF_SIZE - cur->len, &recs,
+                                        ram_log_push);
+        if (n > 0)
+        {
+            cur->len += n;
+            s_records += recs;
+        }
+
+        /* Bufor nie przyjmie najwiekszego rekordu → do zapisu */
+        if (cur->len + LOG_MAX_RECORD_SIZE > BUF_SIZE)
+        {
+            auto *next = static_cast<LogBuf *>(chFifoTakeObjectTimeout(&s_pool_fifo, wait));
+            if (next == nullptr)
+            {
+                s_pool_starved++;
+                return cur;
+            }
+
+            seal_frame(*cur, s_frames);
+            if (!s_stop_req.load() && rotate_due())
+            {
+                cur->last   = true;
+                cur->rotate = true;
+                post_buf(cur);
+                cur               = next;
+                s_frames          = stage_file_header(*cur);
+                s_pack_file_bytes = 0;
+                s_pack_file_start = chVTGetSystemTimeX();
+                open_frame(*cur);
+                continue;
+            }
+
+            const size_t cut = cur->len & ~(SECTOR - 1);
+            next->len        = cur->len - cut;
+            next->last       = false;
+            next->rotate     = false;
+            memcpy(next->data, &cur->data[cut], next->len);
+            cur->len = cut;
+            s_pack_file_bytes += static_cast<uint32_t>(cut);
+            post_buf(cur);
+            cur = next;
+            open_frame(*cur);
+            continue;
+        }
+
+        if (n == 0)
+        {
+            return cur;
+        }
+    }
+}
+
+static THD_FUNCTION(LogPackThread, arg)
+{
+    (void)arg;
+    chRegSetThreadName("log_pack");
+
+    while (true)
+    {
+        chThdSleepMilliseconds(DRAIN_MS);
+
+        LogBuf *cur = s_pack.load();
+        if (cur == nullptr)
+        {
+            /* Brak pliku: rekordy z IDLE (log.pretrig) tylko do RAM logu */
+            while (s_ring.read(s_ram_scratch, sizeof(s_ram_scratch), nullptr, ram_log_push) > 0)
+            {
+                /* kazdy rekord trafia do ram_log_push() z read() */
+            }
+            continue;
+        }
+
+        /* Przy zamykaniu czeka na wolny bufor — pierscien ma byc pusty,
+         * zanim wystartuje nastepny plik */
+        const bool stop = s_stop_req.load(); /* przed oproznieniem */
+        cur             = pack_ring(cur, stop ? TIME_MS2I(1000) : TIME_IMMEDIATE);
+
+        if (stop)
+        {
+            /* Rekordy po IDLE (log.pretrig) ida juz tylko do RAM logu */
+            seal_frame(*cur, s_frames);
+            cur->last = true;
+            s_pack.store(nullptr);
+            post_buf(cur);
+        }
+        else
+        {
+            s_pack.store(cur);
+        }
+    }
 }
 
 /* ── Public API ───────────────────────────────────────────────────────────── */
 
 bool logger_init()
 {
-    chBSemObjectInit(&s_flush_sem, true);
-
-    s_active        = 0;
-    s_write_pos     = 0;
-    s_flush_len     = 0;
-    s_flush_pending = false;
     s_state.store(LoggerState::IDLE);
-    s_records      = 0;
-    s_bytes        = 0;
-    s_flushes      = 0;
-    s_flush_err    = 0;
-    s_overflows    = 0;
+    s_records   = 0;
+    s_bytes     = 0;
+    s_flushes   = 0;
+    s_flush_err = 0;
+    s_drop_base = s_ring.dropped();
+    s_next_log  = 0; /* karta (ponownie) zamontowana — indeks od nowa */
 
     return sdmmc_is_mounted();
 }
@@ -107,6 +585,11 @@ bool logger_start()
         return true;
     }
 
+    if (!s_pool_ready.load() || s_file_open.load() || s_stop_req.load() || s_bench.load())
+    {
+        return false; /* watek nie wystartowal / poprzedni plik sie zamyka / bench */
+    }
+
     if (!sdmmc_is_mounted())
     {
         return false;
@@ -117,130 +600,118 @@ bool logger_start()
         return false;
     }
 
-    const FRESULT res = f_open(&s_file, s_filename, FA_WRITE | FA_CREATE_NEW);
-    if (res != FR_OK)
+    /* Plik zamkniety → LoggerThread oddal wszystkie bufory */
+    auto *first = static_cast<LogBuf *>(chFifoTakeObjectTimeout(&s_pool_fifo, TIME_IMMEDIATE));
+    if (first == nullptr)
     {
-        error_report(ErrorCode::SD_WRITE_FAIL);
         return false;
     }
 
-    s_file_open = true;
-
-    if (!write_file_header())
+    if (!open_file(s_filename, FA_WRITE | FA_CREATE_NEW, prealloc_per_file()))
     {
-        f_close(&s_file);
-        s_file_open = false;
+        chFifoReturnObject(&s_pool_fifo, first);
         error_report(ErrorCode::SD_WRITE_FAIL);
         return false;
     }
 
-    s_active        = 0;
-    s_write_pos     = 0;
-    s_flush_len     = 0;
-    s_flush_pending = false;
-    s_records       = 0;
-    s_bytes         = sizeof(LogFileHeader);
-    s_flushes       = 0;
-    s_flush_err     = 0;
-    s_overflows     = 0;
+    s_frames = stage_file_header(*first);
+    reset_write_stats();
+    open_frame(*first);
+    s_pack_file_bytes = 0;
+    s_pack_file_start = chVTGetSystemTimeX();
+
+    s_file_open.store(true);
+    s_pack.store(first);
     s_state.store(LoggerState::LOGGING);
 
+    /* Historia sprzed startu (pad) → PRE_NNN.BIN */
+    if (s_p_pretrig.get_or(0.0f) > 0.5f)
+    {
+        logger_request_dump();
+    }
+
     return true;
 }
 
 void logger_stop()
 {
-    if (s_state.load() != LoggerState::LOGGING)
+    /* Also after ERROR — the file still has to be truncated and closed */
+    if (s_state.load() != LoggerState::LOGGING && !s_file_open.load())
     {
         return;
     }
 
-    /* Setting IDLE first makes the flush thread skip future swap signals.
-     * Any in-flight flush still completes — we must wait for it before we
-     * touch the file handle, otherwise f_close races with f_write/f_sync. */
+    /* IDLE first: producers stop appending. LogPackThread drains the ring
+     * and posts the last buffer; LoggerThread writes it and closes. */
     s_state.store(LoggerState::IDLE);
+    s_stop_req.store(true);
 
-    /* Wait for the in-flight flush (if any) to drain. FatFs operations are
-     * bounded by FF_FS_TIMEOUT (1 s) plus SDC driver timeouts, so this loop
-     * is finite even on a stuck card. If it still doesn't drain, leave the
-     * file open rather than racing the writer — the file will be closed on
-     * next reboot via FatFs metadata recovery. */
+    /* FatFs operations are bounded by FF_FS_TIMEOUT (1 s) plus SDC driver
+     * timeouts, so this wait is finite even on a stuck card. If it still
+     * doesn't finish, the thread closes the file later on its own. */
     constexpr int kMaxWaitMs = 5000;
     int           waited     = 0;
-    while (s_flush_pending && waited < kMaxWaitMs)
+    while (s_stop_req.load() && waited < kMaxWaitMs)
     {
         chThdSleepMilliseconds(10);
         waited += 10;
     }
-    if (s_flush_pending)
+    if (s_stop_req.load())
     {
         error_report(ErrorCode::SD_WRITE_FAIL);
-        return;
     }
+}
 
-    /* Flush whatever remains in the active buffer. */
-    chSysLock();
-    const size_t  remaining = s_write_pos;
-    const uint8_t which     = s_active;
-    s_write_pos             = 0;
-    chSysUnlock();
-
-    if (remaining > 0 && s_file_open)
+bool logger_log(const void *data, size_t len)
+{
+    /* IDLE + log.pretrig: rekord trafia tylko do RAM logu */
+    const LoggerState st = s_state.load(std::memory_order_relaxed);
+    if (st != LoggerState::LOGGING &&
+        !(st == LoggerState::IDLE && s_p_pretrig.get_or(0.0f) > 0.5f))
     {
-        UINT bw = 0;
-        f_write(&s_file, s_buf[which], remaining, &bw);
-        f_sync(&s_file);
-        s_bytes += bw;
+        return false;
     }
 
-    if (s_file_open)
+    if (len == 0 || len > LOG_MAX_RECORD_SIZE)
     {
-        f_close(&s_file);
-        s_file_open = false;
+        return false;
     }
-}
 
-void logger_log(const void *data, size_t len)
-{
-    if (s_state.load() != LoggerState::LOGGING)
+    /* Odrzucony przez profil: przyjety, tylko nie zapisany */
+    if (!s_decim.admit(static_cast<const uint8_t *>(data)[0]))
     {
-        return;
+        return true;
     }
 
-    if (len > LOG_MAX_RECORD_SIZE)
+    /* Bez sekcji krytycznej: rezerwacja CAS, kopia, commit */
+    return s_ring.write(data, len);
+}
+
+void logger_set_profile(LogProfileId id)
+{
+    if (id >= LogProfileId::COUNT || s_decim.active() == id)
     {
         return;
     }
+    s_decim.select(id);
 
-    chSysLock();
-
-    /* RAM-log mirror: must be inside chSysLock — ram_log_push has no
-     * internal locking, and logger_log() runs from multiple threads. */
-    ram_log_push(data, len);
-
-    if (s_write_pos + len > BUF_SIZE)
-    {
-        if (s_flush_pending)
-        {
-            /* Both buffers occupied — drop this record. */
-            s_overflows++;
-            chSysUnlock();
-            return;
-        }
-
-        /* Swap buffers and signal the flush thread. */
-        s_flush_len     = s_write_pos;
-        s_flush_pending = true;
-        s_active ^= 1;
-        s_write_pos = 0;
-        chBSemSignalI(&s_flush_sem);
-    }
+    /* Znacznik w logu: od tego miejsca inne czestotliwosci */
+    LogEvent ev{};
+    ev.hdr.msg_id       = static_cast<uint8_t>(LogMsgId::EVENT);
+    ev.hdr.timestamp_us = timestamp_us();
+    ev.event_code       = static_cast<uint8_t>(LogEventCode::PROFILE);
+    ev.aux              = static_cast<uint16_t>(id);
+    (void)logger_log(ev);
+}
 
-    memcpy(&s_buf[s_active][s_write_pos], data, len);
-    s_write_pos += len;
-    s_records++;
+LogProfileId logger_profile()
+{
+    return s_decim.active();
+}
 
-    chSysUnlock();
+uint16_t logger_profile_every(LogMsgId id)
+{
+    return s_decim.every(id);
 }
 
 LoggerStats logger_stats()
@@ -248,15 +719,40 @@ LoggerStats logger_stats()
     LoggerStats st{};
 
     chSysLock();
-    st.state           = s_state.load();
-    st.records_written = s_records;
-    st.bytes_written   = s_bytes;
-    st.flush_count     = s_flushes;
-    st.flush_errors    = s_flush_err;
-    st.overflow_count  = s_overflows;
+    st.state               = s_state.load();
+    st.records_written     = s_records;
+    st.bytes_written       = s_bytes;
+    st.files               = s_files;
+    st.flush_count         = s_flushes;
+    st.flush_errors        = s_flush_err;
+    st.overflow_count      = s_ring.dropped() - s_drop_base;
+    st.contiguous          = s_contig;
+    st.prealloc_mb         = s_contig ? s_prealloc_mb : 0;
+    st.write_max_us        = s_write_hist.max();
+    st.write_hist          = s_write_hist;
+    st.pool_buffers        = POOL_BUFS;
+    st.pool_peak           = s_bufs_peak;
+    st.pool_starved        = s_pool_starved;
+    st.pretrig_dumps       = s_dumps;
+    st.pretrig_bytes       = s_dump_bytes;
+    memcpy(st.pretrig_file, s_dump_name, sizeof(s_dump_name));
+    const uint64_t busy_us = s_write_busy_us;
+    const systime_t start  = s_start_time;
     memcpy(st.filename, s_filename, sizeof(s_filename));
     chSysUnlock();
 
+    /* Dzielenia 64-bit poza sekcja krytyczna */
+    const uint64_t bytes      = st.bytes_written;
+    const uint32_t elapsed_ms = TIME_I2MS(chVTTimeElapsedSinceX(start));
+    if (busy_us > 0)
+    {
+        st.write_kibps = static_cast<uint32_t>(bytes * 1000000U / 1024U / busy_us);
+    }
+    if (elapsed_ms > 0)
+    {
+        st.log_kibps = static_cast<uint32_t>(bytes * 1000U / 1024U / elapsed_ms);
+    }
+
     return st;
 }
 
@@ -274,12 +770,54 @@ void logger_print_status(BaseSequentialStream *chp)
     }
 
     chprintf(chp, "Logger state:   %s\r\n", state_str);
-    chprintf(chp, "File:           %s\r\n", (st.filename[0] != '\0') ? st.filename : "(none)");
+    chprintf(chp, "File:           %s", (st.filename[0] != '\0') ? st.filename : "(none)");
+    if (st.files > 1)
+    {
+        chprintf(chp, " (file %lu of this log)", st.files);
+    }
+    chprintf(chp, "\r\n");
+    chprintf(chp, "Rotation:       ");
+    const auto rot_mb = static_cast<uint32_t>(s_p_rotate_mb.get_or(0.0f));
+    const auto rot_s  = static_cast<uint32_t>(s_p_rotate_s.get_or(0.0f));
+    if (rot_mb == 0 && rot_s == 0)
+    {
+        chprintf(chp, "off");
+    }
+    if (rot_mb > 0)
+    {
+        chprintf(chp, "every %lu MiB ", rot_mb);
+    }
+    if (rot_s > 0)
+    {
+        chprintf(chp, "every %lu s", rot_s);
+    }
+    chprintf(chp, "\r\n");
+    chprintf(chp, "Profile:        %s\r\n", log_profile(logger_profile()).name);
     chprintf(chp, "Records:        %lu\r\n", st.records_written);
     chprintf(chp, "Bytes written:  %lu\r\n", st.bytes_written);
     chprintf(chp, "Flushes:        %lu\r\n", st.flush_count);
     chprintf(chp, "Flush errors:   %lu\r\n", st.flush_errors);
     chprintf(chp, "Overflows:      %lu\r\n", st.overflow_count);
+    if (st.contiguous)
+    {
+        chprintf(chp, "Write mode:     contiguous (%lu MiB preallocated)\r\n", st.prealloc_mb);
+    }
+    else
+    {
+        chprintf(chp, "Write mode:     FatFs (f_sync every log.sync_ms)\r\n");
+    }
+    chprintf(chp, "Throughput:     %lu KiB/s card, %lu KiB/s logged\r\n", st.write_kibps,
+             st.log_kibps);
+    logger_print_latency(chp, st.write_hist);
+    chprintf(chp, "Pre-trigger:    RAM capture %s, %lu dumps",
+             (s_p_pretrig.get_or(0.0f) > 0.5f) ? "on" : "off", st.pretrig_dumps);
+    if (st.pretrig_file[0] != '\0')
+    {
+        chprintf(chp, ", last %s (%lu B)", st.pretrig_file, st.pretrig_bytes);
+    }
+    chprintf(chp, "\r\n");
+    chprintf(chp, "Buffer queue:   peak %lu / %lu x %u KiB, %lu times full\r\n", st.pool_peak,
+             st.pool_buffers, static_cast<unsigned>(BUF_SIZE / 1024), st.pool_starved);
 
     if (sdmmc_is_mounted())
     {
@@ -296,59 +834,266 @@ void logger_print_status(BaseSequentialStream *chp)
     }
 }
 
-/* ── LoggerThread ─────────────────────────────────────────────────────────── */
+void logger_request_dump(uint32_t last_ms)
+{
+    s_dump_window_ms.store(std::min(last_ms, LOGGER_DUMP_MAX_MS));
+    s_dump_req.store(true);
+}
 
-void logger_thread(void *arg)
+bool logger_bench(uint32_t size_mib, LoggerBench &out)
 {
-    (void)arg;
-    chRegSetThreadName("logger");
+    out = LoggerBench{};
+    if (size_mib == 0 || !sdmmc_is_mounted() || !s_pool_ready.load())
+    {
+        return false;
+    }
 
-    while (true)
+    /* Tylko gdy logger stoi; s_bench blokuje logger_start() na czas testu */
+    bool expected = false;
+    if (s_file_open.load() || s_stop_req.load() ||
+        !s_bench.compare_exchange_strong(expected, true))
     {
-        chBSemWait(&s_flush_sem);
+        return false;
+    }
 
-        if (!s_file_open || s_state.load() != LoggerState::LOGGING)
+    auto *buf = static_cast<LogBuf *>(chFifoTakeObjectTimeout(&s_pool_fifo, TIME_IMMEDIATE));
+    if (buf == nullptr || !open_file(BENCH_FILE, FA_WRITE | FA_CREATE_ALWAYS, size_mib))
+    {
+        if (buf != nullptr)
         {
-            s_flush_pending = false;
-            continue;
+            chFifoReturnObject(&s_pool_fifo, buf);
         }
+        s_bench.store(false);
+        return false;
+    }
 
-        const uint8_t flush_buf = s_active ^ 1;
-        const size_t  flush_len = s_flush_len;
+    /* Wzor niezerowy — niektore karty skracaja zapis pustych blokow */
+    for (size_t i = 0; i < BUF_SIZE; ++i)
+    {
+        buf->data[i] = static_cast<uint8_t>(i * 131U + 7U);
+    }
 
-        UINT    bw  = 0;
-        FRESULT res = f_write(&s_file, s_buf[flush_buf], flush_len, &bw);
+    const LoggerState state_before = s_state.load();
+    reset_write_stats();
+    out.contiguous = s_contig;
 
-        if (res == FR_OK && bw == flush_len)
+    /* Ta sama sciezka co LoggerThread: bufor po buforze przez write_buf() */
+    const uint64_t total = uint64_t{size_mib} << 20U;
+    while (s_bytes < total && s_flush_err == 0)
+    {
+        buf->len  = static_cast<size_t>(std::min<uint64_t>(BUF_SIZE, total - s_bytes));
+        buf->last = false;
+        write_buf(*buf);
+    }
+    if (s_sync_pending)
+    {
+        const uint32_t t0 = timestamp_us();
+        (void)f_sync(&s_file);
+        account_write(t0);
+    }
+
+    out.bytes      = s_bytes;
+    out.errors     = s_flush_err;
+    out.elapsed_ms = TIME_I2MS(chVTTimeElapsedSinceX(s_start_time));
+    out.busy_us    = s_write_busy_us;
+    out.hist       = s_write_hist;
+
+    f_close(&s_file);
+    (void)f_unlink(BENCH_FILE);
+    s_contig       = false;
+    s_sync_pending = false;
+    s_state.store(state_before); /* blad zapisu w tescie nie zatrzymuje loggera */
+
+    chFifoReturnObject(&s_pool_fifo, buf);
+    s_bench.store(false);
+    return out.errors == 0;
+}
+
+void logger_print_latency(BaseSequentialStream *chp, const WriteLatencyHist &h)
+{
+    chprintf(chp, "Write latency:  p50 <= %lu us, p99 <= %lu us, max %lu us (%lu writes)\r\n",
+             h.quantile_upper(0.5f), h.quantile_upper(0.99f), h.max(), h.total());
+
+    for (size_t k = 0; k < WriteLatencyHist::kBuckets; ++k)
+    {
+        if (h.count(k) == 0)
         {
-            res = f_sync(&s_file);
+            continue;
         }
+        if (k + 1 == WriteLatencyHist::kBuckets)
+        {
+            chprintf(chp, "  >= %7lu us: %lu\r\n", WriteLatencyHist::bucket_lo(k), h.count(k));
+        }
+        else
+        {
+            chprintf(chp, "  < %8lu us: %lu\r\n", WriteLatencyHist::bucket_hi(k) + 1U,
+                     h.count(k));
+        }
+    }
+}
+
+/* ── Pre-trigger dump ─────────────────────────────────────────────────────── */
+
+/* PRE_NNN.BIN: NNN biezacego logu, bez logu — numer, ktory dostanie
+ * nastepny (historia z padu nalezy do niego). Kolejne zrzuty tego samego
+ * logu (start + bledy krytyczne) to PRE_NNNB..PRE_NNNZ — nazwy 8.3, bez
+ * LFN; nigdy numer innego logu. */
+static bool open_dump_file()
+{
+    int nnn = s_log_index;
+    if (!s_file_open.load())
+    {
+        nnn = (s_next_log != 0) ? s_next_log : read_log_index() % 999 + 1;
+    }
 
-        if (res == FR_OK && bw == flush_len)
+    for (char k = 'A'; k <= 'Z'; k++)
+    {
+        if (k == 'A')
         {
-            s_bytes += bw;
-            s_flushes++;
+            chsnprintf(s_dump_name, sizeof(s_dump_name), "PRE_%03d.BIN", nnn);
         }
         else
         {
-            s_flush_err++;
+            chsnprintf(s_dump_name, sizeof(s_dump_name), "PRE_%03d%c.BIN", nnn, k);
+        }
+        if (f_open(&s_dump_file, s_dump_name, FA_WRITE | FA_CREATE_NEW) == FR_OK)
+        {
+            return true;
+        }
+    }
+    return false;
+}
 
-            if (res == FR_OK && bw < flush_len)
+static void finish_dump()
+{
+    f_close(&s_dump_file);
+    chFifoReturnObject(&s_pool_fifo, s_dump_buf);
+    s_dump_buf    = nullptr;
+    s_dump_active = false;
+}
+
+/* Jeden krok zrzutu (≤ 1 bufor) — miedzy zapisami biezacego logu, zeby
+ * zrzut nigdy nie opoznil kolejki buforow */
+static void dump_step()
+{
+    if (!s_dump_active)
+    {
+        if (!s_dump_req.load() || !sdmmc_is_mounted() || s_bench.load())
+        {
+            return;
+        }
+
+        s_dump_buf = static_cast<LogBuf *>(chFifoTakeObjectTimeout(&s_pool_fifo, TIME_IMMEDIATE));
+        if (s_dump_buf == nullptr)
+        {
+            return; /* pula zajeta — sprobuje pozniej */
+        }
+        s_dump_req.store(false);
+
+        if (!open_dump_file())
+        {
+            chFifoReturnObject(&s_pool_fifo, s_dump_buf);
+            s_dump_buf = nullptr;
+            error_report(ErrorCode::SD_WRITE_FAIL);
+            return;
+        }
+
+        /* Okno czasowe: wyszukiwanie binarne po indeksie RAM logu */
+        /* Poczatek okna na zegarze timestamp_us() — modulo jego okresu */
+        const uint32_t window_us = s_dump_window_ms.load() * 1000U;
+        const uint32_t now       = timestamp_us();
+        const uint32_t since     = (now >= window_us) ? now - window_us
+                                                      : now + (TIMESTAMP_WRAP_US - window_us);
+        s_dump_cur = (window_us == 0) ? ram_log_snapshot() : ram_log_seek(since);
+        s_dump_frames = stage_file_header(*s_dump_buf);
+        s_dump_bytes  = 0;
+        s_dump_active = true;
+    }
+
+    /* Porcja = jedna ramka */
+    LogBuf &buf = *s_dump_buf;
+    open_frame(buf);
+    buf.len += ram_log_copy(s_dump_cur, &buf.data[buf.len], BUF_SIZE - buf.len);
+    seal_frame(buf, s_dump_frames);
+
+    UINT bw = 0;
+    if (f_write(&s_dump_file, buf.data, buf.len, &bw) != FR_OK || bw != buf.len)
+    {
+        error_report(ErrorCode::SD_WRITE_FAIL);
+        finish_dump();
+        return;
+    }
+    s_dump_bytes += bw;
+    buf.len = 0;
+
+    if (ram_log_done(s_dump_cur))
+    {
+        s_dumps++;
+        finish_dump();
+    }
+}
+
+static void on_critical_error(ErrorCode code)
+{
+    (void)code;
+    logger_set_profile(LogProfileId::FULL); /* awaria — wszystko w pelnej rozdzielczosci */
+    if (s_p_pretrig.get_or(0.0f) > 0.5f)
+    {
+        logger_request_dump();
+    }
+}
+
+/* ── LoggerThread ─────────────────────────────────────────────────────────── */
+
+void logger_thread(void *arg)
+{
+    (void)arg;
+    chRegSetThreadName("logger");
+
+    s_p_prealloc  = param_bind("log.prealloc_mb");
+    s_p_sync_ms   = param_bind("log.sync_ms");
+    s_p_pretrig   = param_bind("log.pretrig");
+    s_p_rotate_mb = param_bind("log.rotate_mb");
+    s_p_rotate_s  = param_bind("log.rotate_s");
+    error_set_critical_hook(on_critical_error);
+
+    chFifoObjectInit(&s_pool_fifo, sizeof(LogBuf), POOL_BUFS, s_pool, s_pool_msgs);
+    s_pool_ready.store(true);
+    chThdCreateStatic(waLogPack, sizeof(waLogPack), NORMALPRIO - 15, LogPackThread, nullptr);
+
+    while (true)
+    {
+        /* Trwajacy zrzut: nie czekaj na bufory, tylko przeplataj */
+        const sysinterval_t wait = s_dump_active ? TIME_IMMEDIATE : TIME_MS2I(DRAIN_MS);
+        void               *obj  = nullptr;
+        if (chFifoReceiveObjectTimeout(&s_pool_fifo, &obj, wait) == MSG_OK)
+        {
+            auto *buf = static_cast<LogBuf *>(obj);
+            if (s_state.load() != LoggerState::ERROR)
+            {
+                write_buf(*buf);
+            }
+            if (buf->last && !buf->rotate)
             {
-                error_report(ErrorCode::SD_FULL);
-                s_state.store(LoggerState::ERROR);
+                close_file();
             }
-            else
+            else if (buf->last && s_state.load() != LoggerState::ERROR)
             {
-                error_report(ErrorCode::SD_WRITE_FAIL);
-                if (s_flush_err >= 10)
-                {
-                    s_state.store(LoggerState::ERROR);
-                }
+                rotate_file();
             }
+            chFifoReturnObject(&s_pool_fifo, buf);
+            s_bufs_queued.fetch_sub(1);
         }
 
-        s_flush_pending = false;
+        if (s_file_open.load())
+        {
+            sync_if_due();
+        }
+        if (s_index_dirty.exchange(false))
+        {
+            write_log_index();
+        }
+        dump_step();
     }
 }
 
@@ -1,15 +1,39 @@
 /*
  * ACS4 Flight Computer — Flight Logger (Black Box)
  *
- * Dual-buffer binary logger writing packed log records to SD card via FatFs.
- * Any thread may call log() to append a record; when the active buffer fills
- * up, it is swapped and LoggerThread flushes the inactive buffer to disk.
+ * Binary logger writing packed log records to SD card via FatFs. Any
+ * thread or ISR may call log() to append a record to a lock-free ring
+ * (LogRing). LogPackThread drains it every 10 ms into a pool of 8 KiB
+ * buffers and queues each full one (whole 512-byte sectors) through an
+ * objects FIFO to LoggerThread, which does all file I/O. A slow write
+ * (card garbage collection, 100+ ms) only deepens the queue; records are
+ * dropped once the pool and the ring are both full.
  *
- * Thread safety: log() uses a short critical section (<1µs) to copy the
- * record into the active buffer and bump the write pointer. The swap and
- * semaphore signal are also inside the critical section.
+ * Write path: logger_start() preallocates log.prealloc_mb MiB of
+ * contiguous clusters (f_expand) and syncs the directory entry once;
+ * LoggerThread then streams multi-block writes straight to the SDMMC
+ * driver, with no FAT or directory updates until logger_stop() truncates
+ * the file to its data. Without contiguous space (or past the
+ * preallocation) it falls back to f_write with f_sync every log.sync_ms.
+ * After a power loss a contiguous log keeps its preallocated size: the
+ * tail past the last write is stale card data (zeros on a fresh card).
  *
- * Memory: 2 × 16 KiB buffers in AXI SRAM = 32 KiB total.
+ * Files: LOG_NNN.BIN, numbered from LOG_IDX.TXT (last NNN used) so
+ * logger_start() normally needs one f_stat. Past log.rotate_mb MiB or
+ * log.rotate_s seconds (0 = off) the log continues in the next number,
+ * each file with its own header and schema — a damaged file costs only
+ * its own span of the flight.
+ *
+ * Profiles: logger_set_profile() switches the per-type decimation table
+ * (log_profile.h) — e.g. pad / full / descent by flight phase. Thinned
+ * records are dropped in logger_log() before the ring; a critical error
+ * switches back to FULL.
+ *
+ * Thread safety: log() never masks interrupts — it claims ring space with
+ * one CAS, copies the record and publishes it with a release store, so
+ * producers only contend on the CAS, even for a 580-byte IMU block.
+ *
+ * Memory: 16 KiB ring + 6 × 8 KiB pool in AXI SRAM = 64 KiB total.
  */
 
 #pragma once
@@ -17,6 +41,9 @@
 #include <cstdint>
 
 #include "logger/log_format.h"
+#include "logger/log_profile.h"
+#include "utils/timestamp.h"
+#include "utils/log2_histogram.h"
 
 extern "C" {
 #include "ch.h"
@@ -37,18 +64,34 @@ enum class LoggerState : uint8_t
     ERROR,     /* SD write error, stopped */
 };
 
+/* Write latency [µs], buckets up to ≥ 262 ms (card GC stalls) */
+using WriteLatencyHist = Log2Histogram<20>;
+
 /**
  * @brief Runtime statistics for the logger.
  */
 struct LoggerStats
 {
-    LoggerState state;
-    uint32_t    records_written;
-    uint32_t    bytes_written;
-    uint32_t    flush_count;
-    uint32_t    flush_errors;
-    uint32_t    overflow_count;  /* records dropped because both buffers full */
-    char        filename[32];
+    LoggerState      state;
+    uint32_t         records_written;
+    uint32_t         bytes_written;  /* all files since logger_start() */
+    uint32_t         files;          /* files since logger_start() (rotation) */
+    uint32_t         flush_count;
+    uint32_t         flush_errors;
+    uint32_t         overflow_count; /* records dropped because the ring was full */
+    bool             contiguous;     /* raw sector writes into a preallocated file */
+    uint32_t         prealloc_mb;    /* preallocation size (contiguous mode) */
+    uint32_t         write_kibps;    /* bytes / time spent in writes + syncs */
+    uint32_t         log_kibps;      /* bytes / time since logger_start() */
+    uint32_t         write_max_us;   /* worst single buffer write or f_sync */
+    WriteLatencyHist write_hist;     /* every buffer write and f_sync (DWT) */
+    uint32_t         pool_buffers;   /* buffers in the pool */
+    uint32_t         pool_peak;      /* most buffers queued for writing at once */
+    uint32_t         pool_starved;   /* times a full buffer found no free one */
+    uint32_t         pretrig_dumps;  /* completed RAM log dumps */
+    uint32_t         pretrig_bytes;  /* size of the last dump */
+    char             pretrig_file[16];
+    char             filename[32];
 };
 
 /**
@@ -65,31 +108,77 @@ bool logger_start();
 
 /**
  * @brief Stop logging, flush remaining data, and close the log file.
+ *
+ * LoggerThread does the final drain and f_close(); this waits up to 5 s
+ * for it.
  */
 void logger_stop();
 
+/* Longest dump window: half the timestamp_us() period (~3.9 s), the
+ * furthest back a clock stamp can point unambiguously */
+inline constexpr uint32_t LOGGER_DUMP_MAX_MS = TIMESTAMP_WRAP_US / 2U / 1000U;
+
+/**
+ * @brief Dump the RAM log (pre-trigger history) to PRE_NNN.BIN.
+ *
+ * Any thread; only sets a flag. LoggerThread writes the dump one 8 KiB
+ * buffer at a time between live log writes (NNN of the open log, else
+ * of the next one; further dumps for the same NNN are PRE_NNNB.BIN ..
+ * PRE_NNNZ.BIN). Fired automatically by logger_start() and by
+ * the first occurrence of each critical error (incl. WATCHDOG_TIMEOUT)
+ * when log.pretrig = 1.
+ *
+ * @param last_ms  Dump only records from the last last_ms milliseconds
+ *                 (0 = everything in the RAM log), clamped to
+ *                 LOGGER_DUMP_MAX_MS.
+ */
+void logger_request_dump(uint32_t last_ms = 0);
+
 /**
  * @brief Append a log record (any packed struct from log_format.h).
  *
- * Safe to call from any thread context (uses chSysLock/chSysUnlock).
- * The record is memcpy'd into the active buffer. If the buffer is full
- * and the inactive buffer is also not yet flushed, the record is dropped
- * and overflow_count is incremented.
+ * Safe to call from any thread or ISR; never blocks and never masks
+ * interrupts. If the ring is full the record is dropped and
+ * overflow_count is incremented. While IDLE with log.pretrig = 1 records
+ * are accepted into the RAM log only (pre-trigger capture on the pad).
  *
- * @param data   Pointer to packed log record (starts with LogHeader).
+ * @param data   Pointer to packed log record (starts with the msg_id byte).
  * @param len    Size of the record in bytes (must be <= LOG_MAX_RECORD_SIZE).
+ * @return true if the record was buffered or thinned out by the active
+ *         profile. Stateful producers (IMU delta chain) must resync after
+ *         a false.
  */
-void logger_log(const void *data, size_t len);
+bool logger_log(const void *data, size_t len);
 
 /**
  * @brief Convenience template — logs any log record struct directly.
  */
 template <typename T>
-inline void logger_log(const T &record)
+inline bool logger_log(const T &record)
 {
-    logger_log(&record, sizeof(T));
+    return logger_log(&record, sizeof(T));
 }
 
+/**
+ * @brief Switch the logging profile (flight phase or event).
+ *
+ * Any thread or ISR; one atomic store, then an EVENT record (PROFILE,
+ * aux = id) marks the switch in the log. No-op if id is already active.
+ * FULL from boot.
+ */
+void logger_set_profile(LogProfileId id);
+
+/**
+ * @brief Active logging profile.
+ */
+[[nodiscard]] LogProfileId logger_profile();
+
+/**
+ * @brief Keep-1-in-N ratio of a type under the active profile — for
+ *        producers that thin samples themselves (IMU_BLOCK).
+ */
+[[nodiscard]] uint16_t logger_profile_every(LogMsgId id);
+
 /**
  * @brief Get current logger statistics.
  */
@@ -100,11 +189,43 @@ inline void logger_log(const T &record)
  */
 void logger_print_status(BaseSequentialStream *chp);
 
+/**
+ * @brief Result of logger_bench().
+ */
+struct LoggerBench
+{
+    uint32_t         bytes;
+    uint32_t         elapsed_ms;
+    uint64_t         busy_us;    /* time inside writes + final sync */
+    uint32_t         errors;
+    bool             contiguous; /* preallocation succeeded (raw sector writes) */
+    WriteLatencyHist hist;
+};
+
+/**
+ * @brief SD card qualification: write size_mib MiB to BENCH.BIN through
+ *        the production path (preallocation, 8 KiB buffers, write_buf),
+ *        then delete the file.
+ *
+ * Shell thread only; refused while a log file is open. Blocks for the
+ * whole run (~1–10 s per 16 MiB). Leaves the figures in logger_stats()
+ * until the next logger_start().
+ *
+ * @return true if every write succeeded.
+ */
+bool logger_bench(uint32_t size_mib, LoggerBench &out);
+
+/**
+ * @brief Print p50 / p99 / max and the non-empty histogram buckets.
+ */
+void logger_print_latency(BaseSequentialStream *chp, const WriteLatencyHist &h);
+
 /**
  * @brief LoggerThread entry point. Created by main.cpp.
  *
- * Waits on a binary semaphore; when signalled, flushes the inactive
- * buffer to the open FatFs file and syncs.
+ * Sets up the buffer pool and starts LogPackThread, then writes queued
+ * buffers to the open file, runs the periodic f_sync, switches files on
+ * rotation and closes the file after the last buffer of a logger_stop().
  */
 void logger_thread(void *arg);
 
@@ -0,0 +1,311 @@
+/*
+ * ACS4 Flight Computer — Delta-Encoded IMU Log Records Implementation
+ */
+
+#include "logger/imu_delta_codec.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace acs
+{
+
+static int16_t quantize(float v, float lsb_per_unit)
+{
+    const float q = std::nearbyint(v * lsb_per_unit);
+    if (!(q > -32768.0f))
+    {
+        return -32768; /* takze NaN */
+    }
+    if (q > 32767.0f)
+    {
+        return 32767;
+    }
+    return static_cast<int16_t>(q);
+}
+
+ImuFixed imu_fixed_from(const ImuReading &r)
+{
+    ImuFixed f{};
+    f.timestamp_us = r.timestamp_us;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        f.accel[i] = quantize(r.accel_mps2[i], 1000.0f);
+        f.gyro[i]  = quantize(r.gyro_rads[i], 100.0f);
+    }
+    return f;
+}
+
+size_t varint_put(uint32_t v, uint8_t *out)
+{
+    size_t n = 0;
+    while (v >= 0x80U)
+    {
+        out[n++] = static_cast<uint8_t>(v | 0x80U);
+        v >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(v);
+    return n;
+}
+
+size_t varint_get(const uint8_t *in, size_t avail, uint32_t &v)
+{
+    v = 0;
+    for (size_t n = 0; n < avail && n < 5; ++n)
+    {
+        v |= static_cast<uint32_t>(in[n] & 0x7FU) << (7 * n);
+        if ((in[n] & 0x80U) == 0)
+        {
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+/* =====================================================================
+ * Encoder
+ * ===================================================================== */
+
+size_t ImuDeltaEncoder::encode(const ImuFixed &s, uint8_t *out)
+{
+    if (since_key_ >= interval_)
+    {
+        LogImu rec{};
+        rec.hdr.msg_id       = static_cast<uint8_t>(LogMsgId::IMU);
+        rec.hdr.timestamp_us = s.timestamp_us;
+        memcpy(rec.accel, s.accel, sizeof(rec.accel));
+        memcpy(rec.gyro, s.gyro, sizeof(rec.gyro));
+        memcpy(out, &rec, sizeof(rec));
+
+        prev_      = s;
+        prev_dt_   = 0;
+        since_key_ = 1;
+        return sizeof(rec);
+    }
+
+    /* Arytmetyka modulo 2^32 — przejscie timestampu przez zero jest OK */
+    const uint32_t dt = s.timestamp_us - prev_.timestamp_us;
+
+    size_t n = 0;
+    out[n++] = static_cast<uint8_t>(LogMsgId::IMU_DELTA);
+    n += varint_put(zigzag_encode(static_cast<int32_t>(dt - prev_dt_)), &out[n]);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        n += varint_put(zigzag_encode(int32_t{s.accel[i]} - prev_.accel[i]), &out[n]);
+    }
+    for (size_t i = 0; i < 3; ++i)
+    {
+        n += varint_put(zigzag_encode(int32_t{s.gyro[i]} - prev_.gyro[i]), &out[n]);
+    }
+
+    prev_    = s;
+    prev_dt_ = dt;
+    ++since_key_;
+    return n;
+}
+
+/* =====================================================================
+ * Decoder
+ * ===================================================================== */
+
+bool ImuDeltaDecoder::decode(const uint8_t *rec, size_t avail, ImuFixed &out, size_t &used)
+{
+    used = 0;
+    if (avail == 0)
+    {
+        return false;
+    }
+
+    if (rec[0] == static_cast<uint8_t>(LogMsgId::IMU))
+    {
+        if (avail < sizeof(LogImu))
+        {
+            return false;
+        }
+        LogImu r;
+        memcpy(&r, rec, sizeof(r));
+        prev_.timestamp_us = r.hdr.timestamp_us;
+        memcpy(prev_.accel, r.accel, sizeof(prev_.accel));
+        memcpy(prev_.gyro, r.gyro, sizeof(prev_.gyro));
+        prev_dt_ = 0;
+        synced_  = true;
+        used     = sizeof(r);
+        out      = prev_;
+        return true;
+    }
+
+    if (rec[0] != static_cast<uint8_t>(LogMsgId::IMU_DELTA))
+    {
+        return false;
+    }
+
+    /* ddt + 6 osi */
+    uint32_t field[7];
+    size_t   n = 1;
+    for (uint32_t &f : field)
+    {
+        const size_t k = varint_get(&rec[n], avail - n, f);
+        if (k == 0)
+        {
+            return false;
+        }
+        n += k;
+    }
+    used = n;
+
+    if (!synced_)
+    {
+        return false;
+    }
+
+    const uint32_t dt = prev_dt_ + static_cast<uint32_t>(zigzag_decode(field[0]));
+    prev_.timestamp_us += dt;
+    prev_dt_ = dt;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        prev_.accel[i] = static_cast<int16_t>(prev_.accel[i] + zigzag_decode(field[1 + i]));
+        prev_.gyro[i]  = static_cast<int16_t>(prev_.gyro[i] + zigzag_decode(field[4 + i]));
+    }
+    out = prev_;
+    return true;
+}
+
+/* =====================================================================
+ * IMU block
+ * ===================================================================== */
+
+void ImuBlockEncoder::clear()
+{
+    len_       = 0;
+    count_     = 0;
+    period_us_ = 0;
+}
+
+bool ImuBlockEncoder::fits(const ImuFixed &s) const
+{
+    if (count_ == 0)
+    {
+        return true;
+    }
+    if (full())
+    {
+        return false;
+    }
+
+    const uint32_t dt = s.timestamp_us - first_.timestamp_us;
+    if (count_ == 1)
+    {
+        return dt > 0 && dt <= UINT16_MAX;
+    }
+
+    /* Odchylka od siatki base + k·period, modulo 2^32 */
+    const auto dev = static_cast<int32_t>(dt - static_cast<uint32_t>(count_) * period_us_);
+    return dev >= -static_cast<int32_t>(kImuBlockJitterUs) &&
+           dev <= static_cast<int32_t>(kImuBlockJitterUs);
+}
+
+void ImuBlockEncoder::append(const ImuFixed &s)
+{
+    if (count_ == 0)
+    {
+        first_ = s;
+        len_   = sizeof(LogImuBlock);
+    }
+    else
+    {
+        if (count_ == 1)
+        {
+            period_us_ = s.timestamp_us - first_.timestamp_us;
+        }
+        for (size_t i = 0; i < 3; ++i)
+        {
+            len_ += varint_put(zigzag_encode(int32_t{s.accel[i]} - prev_.accel[i]), &buf_[len_]);
+        }
+        for (size_t i = 0; i < 3; ++i)
+        {
+            len_ += varint_put(zigzag_encode(int32_t{s.gyro[i]} - prev_.gyro[i]), &buf_[len_]);
+        }
+    }
+    prev_ = s;
+    ++count_;
+
+    /* Naglowek aktualny po kazdej probce — data() zawsze gotowe do zapisu */
+    LogImuBlock hdr{};
+    hdr.hdr.msg_id       = static_cast<uint8_t>(LogMsgId::IMU_BLOCK);
+    hdr.hdr.timestamp_us = first_.timestamp_us;
+    hdr.period_us        = static_cast<uint16_t>(period_us_);
+    hdr.count            = static_cast<uint8_t>(count_);
+    hdr.payload_len      = static_cast<uint16_t>(len_ - sizeof(LogImuBlock));
+    memcpy(hdr.accel, first_.accel, sizeof(hdr.accel));
+    memcpy(hdr.gyro, first_.gyro, sizeof(hdr.gyro));
+    memcpy(buf_, &hdr, sizeof(hdr));
+}
+
+size_t imu_block_decode(const uint8_t *rec, size_t avail, ImuFixed *out, size_t &count)
+{
+    count = 0;
+    if (avail < sizeof(LogImuBlock) || rec[0] != static_cast<uint8_t>(LogMsgId::IMU_BLOCK))
+    {
+        return 0;
+    }
+
+    LogImuBlock hdr;
+    memcpy(&hdr, rec, sizeof(hdr));
+    const size_t len = sizeof(hdr) + hdr.payload_len;
+    if (hdr.count == 0 || hdr.count > LOG_IMU_BLOCK_MAX_SAMPLES || len > avail ||
+        len > LOG_IMU_BLOCK_MAX_SIZE)
+    {
+        return 0;
+    }
+
+    ImuFixed s{};
+    s.timestamp_us = hdr.hdr.timestamp_us;
+    memcpy(s.accel, hdr.accel, sizeof(s.accel));
+    memcpy(s.gyro, hdr.gyro, sizeof(s.gyro));
+    out[0] = s;
+
+    size_t pos = sizeof(hdr);
+    for (size_t k = 1; k < hdr.count; ++k)
+    {
+        uint32_t       field[6];
+        const uint8_t *p = &rec[pos];
+        if (len - pos >= 6 && ((p[0] | p[1] | p[2] | p[3] | p[4] | p[5]) & 0x80U) == 0)
+        {
+            /* Typowa probka: szesc jednobajtowych varintow (szum < ±64 LSB) */
+            for (size_t i = 0; i < 6; ++i)
+            {
+                field[i] = p[i];
+            }
+            pos += 6;
+        }
+        else
+        {
+            for (uint32_t &f : field)
+            {
+                const size_t n = varint_get(&rec[pos], len - pos, f);
+                if (n == 0)
+                {
+                    return 0;
+                }
+                pos += n;
+            }
+        }
+        s.timestamp_us = hdr.hdr.timestamp_us + static_cast<uint32_t>(k) * hdr.period_us;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            s.accel[i] = static_cast<int16_t>(s.accel[i] + zigzag_decode(field[i]));
+            s.gyro[i]  = static_cast<int16_t>(s.gyro[i] + zigzag_decode(field[3 + i]));
+        }
+        out[k] = s;
+    }
+
+    /* payload_len musi sie zgadzac co do bajtu */
+    if (pos != len)
+    {
+        return 0;
+    }
+    count = hdr.count;
+    return len;
+}
+
+}  // namespace acs
@@ -0,0 +1,216 @@
+/*
+ * ACS4 Flight Computer — Delta-Encoded IMU Log Records
+ *
+ * Turns the quantized IMU stream into a keyframe (LogImu, 17 bytes) every
+ * kImuKeyframeInterval samples plus IMU_DELTA records in between: the
+ * change in sample period and in every axis, zig-zag mapped and packed as
+ * LEB128 varints (wire layout in log_format.h).
+ *
+ * At 1 kHz the period is constant and sensor noise stays within ±63 LSB,
+ * so a delta record is 8 bytes — about half of a LogImu. The same 16 KiB
+ * log ring then carries 2–4 kHz IMU data.
+ *
+ * The chain only survives if every record reaches the file: the producer
+ * must call force_keyframe() whenever logger_log() rejects a record.
+ *
+ * ImuBlockEncoder packs up to 32 samples into one self-contained
+ * IMU_BLOCK record (base timestamp + fixed period + varint deltas), so
+ * the producer pays one logger_log() reservation and one header per
+ * block instead of per sample. SensorLogThread uses blocks.
+ *
+ * No RTOS dependencies — host-testable. ImuDeltaDecoder mirrors the
+ * decoder in tools/log_decoder.py.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "logger/log_format.h"
+#include "sensors/sensor_types.h"
+
+namespace acs
+{
+
+/* Keyframe period [samples] — 128 ms of data lost at most on a bad block */
+inline constexpr uint16_t kImuKeyframeInterval = 128;
+
+/**
+ * @brief IMU sample in log units (LogImu scaling).
+ */
+struct ImuFixed
+{
+    uint32_t timestamp_us;
+    int16_t  accel[3]; /* [milli-m/s²] */
+    int16_t  gyro[3];  /* [centi-rad/s] */
+};
+
+/**
+ * @brief Quantize a board-frame reading to log units (saturating).
+ */
+ImuFixed imu_fixed_from(const ImuReading &r);
+
+/* ── Varint primitives ────────────────────────────────────────────────── */
+
+constexpr uint32_t zigzag_encode(int32_t v)
+{
+    return (static_cast<uint32_t>(v) << 1) ^ (0U - (static_cast<uint32_t>(v) >> 31));
+}
+
+constexpr int32_t zigzag_decode(uint32_t u)
+{
+    return static_cast<int32_t>((u >> 1) ^ (0U - (u & 1U)));
+}
+
+/**
+ * @brief Append a LEB128 varint (1–5 bytes).
+ * @return Bytes written.
+ */
+size_t varint_put(uint32_t v, uint8_t *out);
+
+/**
+ * @brief Parse a LEB128 varint.
+ * @return Bytes consumed, 0 if truncated or longer than 5 bytes.
+ */
+size_t varint_get(const uint8_t *in, size_t avail, uint32_t &v);
+
+/* ── Encoder / decoder ────────────────────────────────────────────────── */
+
+class ImuDeltaEncoder
+{
+  public:
+    explicit ImuDeltaEncoder(uint16_t keyframe_interval = kImuKeyframeInterval)
+        : interval_(keyframe_interval == 0 ? 1 : keyframe_interval), since_key_(interval_)
+    {
+    }
+
+    /**
+     * @brief Encode the next sample as a keyframe or a delta record.
+     *
+     * @param out  Record buffer, at least LOG_IMU_DELTA_MAX_SIZE bytes.
+     * @return Record length (sizeof(LogImu) or 8..LOG_IMU_DELTA_MAX_SIZE).
+     */
+    size_t encode(const ImuFixed &s, uint8_t *out);
+
+    /**
+     * @brief Make the next record a keyframe (record dropped, log restarted).
+     */
+    void force_keyframe()
+    {
+        since_key_ = interval_;
+    }
+
+  private:
+    uint16_t interval_;
+    uint16_t since_key_; /* >= interval_ → next record is a keyframe */
+    ImuFixed prev_{};
+    uint32_t prev_dt_ = 0;
+};
+
+class ImuDeltaDecoder
+{
+  public:
+    /**
+     * @brief Decode one IMU or IMU_DELTA record.
+     *
+     * @param rec    Record start (msg_id byte).
+     * @param avail  Bytes available from rec.
+     * @param out    Decoded sample, valid only when true is returned.
+     * @param used   Record length; 0 if truncated or not an IMU record.
+     * @return true if out holds a sample (false for a delta before the
+     *         first keyframe or an invalid record).
+     */
+    bool decode(const uint8_t *rec, size_t avail, ImuFixed &out, size_t &used);
+
+    [[nodiscard]] bool synced() const
+    {
+        return synced_;
+    }
+
+    void reset()
+    {
+        synced_ = false;
+    }
+
+  private:
+    bool     synced_ = false;
+    ImuFixed prev_{};
+    uint32_t prev_dt_ = 0;
+};
+
+/* ── IMU block ────────────────────────────────────────────────────────── */
+
+/* Max deviation from base + k · period before a block is closed [µs];
+ * decoded timestamps are exact to within this */
+inline constexpr uint32_t kImuBlockJitterUs = 10;
+
+/**
+ * @brief Builds one IMU_BLOCK record in place.
+ *
+ * @code
+ *   if (!enc.fits(s)) { logger_log(enc.data(), enc.size()); enc.clear(); }
+ *   enc.append(s);
+ * @endcode
+ */
+class ImuBlockEncoder
+{
+  public:
+    ImuBlockEncoder()
+    {
+        clear();
+    }
+
+    /**
+     * @brief True if s can extend the current block (not full, on the
+     *        period grid within kImuBlockJitterUs). Always true if empty.
+     */
+    [[nodiscard]] bool fits(const ImuFixed &s) const;
+
+    /**
+     * @brief Add a sample; the caller checks fits() first.
+     */
+    void append(const ImuFixed &s);
+
+    void clear();
+
+    [[nodiscard]] size_t count() const
+    {
+        return count_;
+    }
+
+    [[nodiscard]] bool full() const
+    {
+        return count_ >= LOG_IMU_BLOCK_MAX_SAMPLES;
+    }
+
+    /** Finished record (valid while count() > 0). */
+    [[nodiscard]] const uint8_t *data() const
+    {
+        return buf_;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return len_;
+    }
+
+  private:
+    uint8_t  buf_[LOG_IMU_BLOCK_MAX_SIZE];
+    size_t   len_   = 0;
+    size_t   count_ = 0;
+    uint32_t period_us_ = 0;
+    ImuFixed first_{};
+    ImuFixed prev_{};
+};
+
+/**
+ * @brief Decode one IMU_BLOCK record.
+ *
+ * @param out    Decoded samples (room for LOG_IMU_BLOCK_MAX_SAMPLES).
+ * @param count  Number of samples written to out.
+ * @return Record length, 0 if truncated or malformed.
+ */
+size_t imu_block_decode(const uint8_t *rec, size_t avail, ImuFixed *out, size_t &count);
+
+}  // namespace acs
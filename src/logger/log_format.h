@@ -2,7 +2,7 @@
  * ACS4 Flight Computer — Binary Log Record Format
  *
  * All records are packed structs with a common header (msg_id + timestamp).
- * Written sequentially to a dual-buffer, flushed to SD card by LoggerThread.
+ * Written sequentially to a lock-free ring, flushed to SD card by LoggerThread.
  *
  * Endianness: little-endian (ARM Cortex-M7 native).
  * Integer encodings chosen to minimise record size while preserving
@@ -14,22 +14,31 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 
+#include "utils/crc32.h"
+
 namespace acs
 {
 
 /* ── Message IDs ──────────────────────────────────────────────────────────── */
 
+/* 0x00 is never a message ID: zero bytes are padding (the unwritten tail
+ * of a preallocated log file after a power loss) and decoders skip them. */
+inline constexpr uint8_t LOG_PAD_BYTE = 0x00;
+
 enum class LogMsgId : uint8_t
 {
-    IMU     = 0x01,
-    NAV     = 0x02,
-    CTRL    = 0x03,
-    BARO    = 0x04,
-    MAG     = 0x05,
-    EVENT   = 0x06,
+    IMU       = 0x01,
+    NAV       = 0x02,
+    CTRL      = 0x03,
+    BARO      = 0x04,
+    MAG       = 0x05,
+    EVENT     = 0x06,
+    IMU_DELTA = 0x07,
+    IMU_BLOCK = 0x08,
 };
 
 /* ── Common header (5 bytes) ──────────────────────────────────────────────── */
@@ -43,6 +52,7 @@ struct __attribute__((packed)) LogHeader
 static_assert(sizeof(LogHeader) == 5, "LogHeader must be 5 bytes");
 
 /* ── MSG 0x01: IMU (17 bytes) ─────────────────────────────────────────────
+ *   logged from the decimated 1 kHz stream (independent of IMU ODR)
  *   accel: 0.001 m/s² per LSB  (±32.767 m/s² range)
  *   gyro:  0.01  rad/s per LSB (±327.67 rad/s range)
  *   temp:  0.01  °C per LSB    (±327.67 °C)
@@ -120,9 +130,59 @@ struct __attribute__((packed)) LogEvent
 
 static_assert(sizeof(LogEvent) == 8, "LogEvent must be 8 bytes");
 
+/* Event codes (0 = unspecified) */
+enum class LogEventCode : uint8_t
+{
+    PROFILE = 0x01, /* logging profile switched, aux = LogProfileId (log_profile.h) */
+};
+
+/* ── MSG 0x07: IMU delta (variable, 8–24 bytes) ──────────────────────────
+ *   Compact IMU sample relative to the previous IMU / IMU_DELTA record.
+ *   No LogHeader — every field after msg_id is a zig-zag LEB128 varint:
+ *
+ *     msg_id = 0x07
+ *     ddt             (dt − previous dt) [µs], dt = timestamp − previous
+ *     daccel[3]       accel − previous accel  [milli-m/s²]
+ *     dgyro[3]        gyro  − previous gyro   [centi-rad/s]
+ *
+ *   A LogImu (0x01) record is the keyframe: it restarts the chain with
+ *   previous dt = 0. The encoder emits one every kImuKeyframeInterval
+ *   samples and after any dropped record (logger/imu_delta_codec.h).
+ *   Deltas seen before the first keyframe cannot be decoded.
+ *   Typical 1 kHz sample: 1 + 1 + 6 × 1 = 8 bytes (vs 17 for LogImu).
+ */
+inline constexpr size_t LOG_IMU_DELTA_MAX_SIZE = 1 + 5 + 6 * 3; /* 24 bytes */
+
+/* ── MSG 0x08: IMU block (22 + payload bytes) ────────────────────────────
+ *   Up to LOG_IMU_BLOCK_MAX_SAMPLES consecutive samples in one record:
+ *   one header, one base timestamp, a fixed period (sample k is at
+ *   timestamp + k · period_us). Sample 0 is stored raw; each following
+ *   sample is 6 zig-zag LEB128 varints — the change in accel[3], gyro[3]
+ *   from the previous sample. Self-contained (no chain across records).
+ *   Typical 1 kHz block of 32: 22 + 31 × 6 = 208 bytes, 6.5 B/sample.
+ */
+struct __attribute__((packed)) LogImuBlock
+{
+    LogHeader hdr;          /* msg_id = 0x08, timestamp of sample 0 */
+    uint16_t  period_us;    /* sample spacing (0 when count = 1) */
+    uint8_t   count;        /* samples in the block, 1..32 */
+    uint16_t  payload_len;  /* varint bytes following this struct */
+    int16_t   accel[3];     /* sample 0 [milli-m/s²] */
+    int16_t   gyro[3];      /* sample 0 [centi-rad/s] */
+};
+
+static_assert(sizeof(LogImuBlock) == 22, "LogImuBlock must be 22 bytes");
+
+inline constexpr size_t LOG_IMU_BLOCK_MAX_SAMPLES = 32;
+inline constexpr size_t LOG_IMU_BLOCK_MAX_SIZE =
+    sizeof(LogImuBlock) + (LOG_IMU_BLOCK_MAX_SAMPLES - 1) * 6 * 3; /* 580 bytes */
+
 /* ── Maximum record size (for buffer math) ───────────────────────────────── */
 
-inline constexpr size_t LOG_MAX_RECORD_SIZE = sizeof(LogNav); /* 31 bytes */
+inline constexpr size_t LOG_MAX_RECORD_SIZE = LOG_IMU_BLOCK_MAX_SIZE; /* 580 bytes */
+
+static_assert(sizeof(LogNav) <= LOG_MAX_RECORD_SIZE, "fixed records must fit");
+static_assert(LOG_IMU_DELTA_MAX_SIZE <= LOG_MAX_RECORD_SIZE, "IMU delta must fit a record");
 
 /* ── File magic & version header written at start of each log file ─────── */
 
@@ -137,6 +197,331 @@ struct __attribute__((packed)) LogFileHeader
 static_assert(sizeof(LogFileHeader) == 14, "LogFileHeader must be 14 bytes");
 
 inline constexpr uint8_t  LOG_MAGIC[4]       = {'A', 'C', 'S', '4'};
-inline constexpr uint16_t LOG_FORMAT_VERSION  = 1;
+inline constexpr uint16_t LOG_FORMAT_VERSION  = 5; /* v2: IMU_DELTA, v3: IMU_BLOCK, v4: schema,
+                                                       v5: CRC frames */
+
+/* ── Schema registry ─────────────────────────────────────────────────────
+ *   One entry per message type: name (also the decoders' CSV file stem),
+ *   length rule, and the fields that follow the LogHeader with their wire
+ *   type, scale (physical = raw · scale) and print precision.
+ *   static_asserts below tie every entry to its struct.
+ *
+ *   Since v4 the logger writes the registry right after LogFileHeader
+ *   (log_schema_write()), so a decoder can parse any fixed-layout record —
+ *   including types added after it was written — and skip variable ones.
+ */
+
+enum class LogFieldType : uint8_t
+{
+    U8  = 1,
+    U16 = 2,
+    U32 = 3,
+    I16 = 4,
+    I32 = 5,
+};
+
+constexpr size_t log_field_size(LogFieldType type)
+{
+    return (type == LogFieldType::U8)                               ? 1
+           : (type == LogFieldType::U16 || type == LogFieldType::I16) ? 2
+                                                                      : 4;
+}
+
+enum class LogLayout : uint8_t
+{
+    FIXED   = 0, /* LogHeader + fields */
+    LEN16   = 1, /* LogHeader + fields + payload; u16 payload length at byte layout_arg */
+    VARINTS = 2, /* msg_id + layout_arg LEB128 varints, no LogHeader, no fields */
+};
+
+struct LogFieldDesc
+{
+    const char  *name;
+    LogFieldType type;
+    double       scale;
+    uint8_t      decimals;
+};
+
+struct LogMsgDesc
+{
+    LogMsgId            id;
+    const char         *name;
+    LogLayout           layout;
+    uint8_t             layout_arg;
+    const LogFieldDesc *fields;
+    uint8_t             n_fields;
+};
+
+namespace log_schema_detail
+{
+
+using T = LogFieldType;
+
+inline constexpr double Q15 = 1.0 / 32767.0;
+
+inline constexpr LogFieldDesc IMU[] = {
+    {"accel_x", T::I16, 0.001, 4},
+    {"accel_y", T::I16, 0.001, 4},
+    {"accel_z", T::I16, 0.001, 4},
+    {"gyro_x", T::I16, 0.01, 5},
+    {"gyro_y", T::I16, 0.01, 5},
+    {"gyro_z", T::I16, 0.01, 5},
+};
+
+inline constexpr LogFieldDesc NAV[] = {
+    {"qw", T::I16, Q15, 6},
+    {"qx", T::I16, Q15, 6},
+    {"qy", T::I16, Q15, 6},
+    {"qz", T::I16, Q15, 6},
+    {"pos_n", T::I32, 0.001, 4},
+    {"pos_e", T::I32, 0.001, 4},
+    {"pos_d", T::I32, 0.001, 4},
+    {"vel_n", T::I16, 0.01, 4},
+    {"vel_e", T::I16, 0.01, 4},
+    {"vel_d", T::I16, 0.01, 4},
+};
+
+inline constexpr LogFieldDesc CTRL[] = {
+    {"servo0", T::I16, 0.01, 2},
+    {"servo1", T::I16, 0.01, 2},
+    {"servo2", T::I16, 0.01, 2},
+    {"servo3", T::I16, 0.01, 2},
+    {"flight_state", T::U8, 1.0, 0},
+};
+
+inline constexpr LogFieldDesc BARO[] = {
+    {"pressure_pa", T::U32, 1.0, 0},
+    {"altitude_m", T::I32, 0.001, 3},
+};
+
+inline constexpr LogFieldDesc MAG[] = {
+    {"field_x", T::I16, 0.01, 3},
+    {"field_y", T::I16, 0.01, 3},
+    {"field_z", T::I16, 0.01, 3},
+};
+
+inline constexpr LogFieldDesc EVENT[] = {
+    {"event_code", T::U8, 1.0, 0},
+    {"aux", T::U16, 1.0, 0},
+};
+
+inline constexpr LogFieldDesc IMU_BLOCK[] = {
+    {"period_us", T::U16, 1.0, 0},
+    {"count", T::U8, 1.0, 0},
+    {"payload_len", T::U16, 1.0, 0},
+    {"accel_x", T::I16, 0.001, 4},
+    {"accel_y", T::I16, 0.001, 4},
+    {"accel_z", T::I16, 0.001, 4},
+    {"gyro_x", T::I16, 0.01, 5},
+    {"gyro_y", T::I16, 0.01, 5},
+    {"gyro_z", T::I16, 0.01, 5},
+};
+
+template <size_t N>
+constexpr uint8_t count_of(const LogFieldDesc (&)[N])
+{
+    return static_cast<uint8_t>(N);
+}
+
+}  // namespace log_schema_detail
+
+inline constexpr LogMsgDesc LOG_SCHEMA[] = {
+    {LogMsgId::IMU, "imu", LogLayout::FIXED, 0, log_schema_detail::IMU,
+     log_schema_detail::count_of(log_schema_detail::IMU)},
+    {LogMsgId::NAV, "nav", LogLayout::FIXED, 0, log_schema_detail::NAV,
+     log_schema_detail::count_of(log_schema_detail::NAV)},
+    {LogMsgId::CTRL, "ctrl", LogLayout::FIXED, 0, log_schema_detail::CTRL,
+     log_schema_detail::count_of(log_schema_detail::CTRL)},
+    {LogMsgId::BARO, "baro", LogLayout::FIXED, 0, log_schema_detail::BARO,
+     log_schema_detail::count_of(log_schema_detail::BARO)},
+    {LogMsgId::MAG, "mag", LogLayout::FIXED, 0, log_schema_detail::MAG,
+     log_schema_detail::count_of(log_schema_detail::MAG)},
+    {LogMsgId::EVENT, "events", LogLayout::FIXED, 0, log_schema_detail::EVENT,
+     log_schema_detail::count_of(log_schema_detail::EVENT)},
+    {LogMsgId::IMU_DELTA, "imu_delta", LogLayout::VARINTS, 7, nullptr, 0},
+    {LogMsgId::IMU_BLOCK, "imu_block", LogLayout::LEN16, 8, log_schema_detail::IMU_BLOCK,
+     log_schema_detail::count_of(log_schema_detail::IMU_BLOCK)},
+};
+
+/** Registry entry for id, nullptr if unknown. */
+constexpr const LogMsgDesc *log_msg_desc(LogMsgId id)
+{
+    for (const LogMsgDesc &m : LOG_SCHEMA)
+    {
+        if (m.id == id)
+        {
+            return &m;
+        }
+    }
+    return nullptr;
+}
+
+/** Bytes before any variable payload (msg_id alone for VARINTS). */
+constexpr size_t log_msg_fixed_size(const LogMsgDesc &m)
+{
+    size_t n = (m.layout == LogLayout::VARINTS) ? 1 : sizeof(LogHeader);
+    for (size_t i = 0; i < m.n_fields; ++i)
+    {
+        n += log_field_size(m.fields[i].type);
+    }
+    return n;
+}
+
+static_assert(log_msg_fixed_size(*log_msg_desc(LogMsgId::IMU)) == sizeof(LogImu));
+static_assert(log_msg_fixed_size(*log_msg_desc(LogMsgId::NAV)) == sizeof(LogNav));
+static_assert(log_msg_fixed_size(*log_msg_desc(LogMsgId::CTRL)) == sizeof(LogCtrl));
+static_assert(log_msg_fixed_size(*log_msg_desc(LogMsgId::BARO)) == sizeof(LogBaro));
+static_assert(log_msg_fixed_size(*log_msg_desc(LogMsgId::MAG)) == sizeof(LogMag));
+static_assert(log_msg_fixed_size(*log_msg_desc(LogMsgId::EVENT)) == sizeof(LogEvent));
+static_assert(log_msg_fixed_size(*log_msg_desc(LogMsgId::IMU_BLOCK)) == sizeof(LogImuBlock));
+static_assert(log_msg_desc(LogMsgId::IMU_BLOCK)->layout_arg ==
+                  offsetof(LogImuBlock, payload_len),
+              "IMU_BLOCK length rule must point at payload_len");
+
+/* ── Schema block (v4+, right after LogFileHeader) ────────────────────────
+ *   "SCHM"  u16 len (bytes after this field)  u8 n_msgs
+ *   per message:  u8 id  u8 layout  u8 layout_arg  u8 n_fields
+ *                 u8 name_len  name
+ *   per field:    u8 type  u8 decimals  f64 scale  u8 name_len  name
+ */
+
+inline constexpr uint8_t LOG_SCHEMA_MAGIC[4] = {'S', 'C', 'H', 'M'};
+
+namespace log_schema_detail
+{
+
+constexpr size_t str_len(const char *s)
+{
+    size_t n = 0;
+    while (s[n] != '\0')
+    {
+        ++n;
+    }
+    return n;
+}
+
+}  // namespace log_schema_detail
+
+/** Size of the serialized schema block. */
+constexpr size_t log_schema_size()
+{
+    size_t n = 4 + 2 + 1;
+    for (const LogMsgDesc &m : LOG_SCHEMA)
+    {
+        n += 5 + log_schema_detail::str_len(m.name);
+        for (size_t i = 0; i < m.n_fields; ++i)
+        {
+            n += 1 + 1 + 8 + 1 + log_schema_detail::str_len(m.fields[i].name);
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Serialize LOG_SCHEMA into out.
+ * @return Bytes written (log_schema_size()), 0 if max is too small.
+ */
+inline size_t log_schema_write(uint8_t *out, size_t max)
+{
+    constexpr size_t total = log_schema_size();
+    static_assert(total - 6 <= UINT16_MAX, "schema block too large");
+    if (max < total)
+    {
+        return 0;
+    }
+
+    size_t n   = 0;
+    auto   put = [&](const void *p, size_t len) {
+        memcpy(&out[n], p, len);
+        n += len;
+    };
+    auto put8 = [&](size_t v) {
+        out[n++] = static_cast<uint8_t>(v);
+    };
+    auto put_str = [&](const char *str) {
+        const size_t len = log_schema_detail::str_len(str);
+        put8(len);
+        put(str, len);
+    };
+
+    const auto len = static_cast<uint16_t>(total - 6);
+    put(LOG_SCHEMA_MAGIC, 4);
+    put(&len, 2);
+    put8(sizeof(LOG_SCHEMA) / sizeof(LOG_SCHEMA[0]));
+    for (const LogMsgDesc &m : LOG_SCHEMA)
+    {
+        put8(static_cast<uint8_t>(m.id));
+        put8(static_cast<uint8_t>(m.layout));
+        put8(m.layout_arg);
+        put8(m.n_fields);
+        put_str(m.name);
+        for (size_t i = 0; i < m.n_fields; ++i)
+        {
+            const LogFieldDesc &f = m.fields[i];
+            put8(static_cast<uint8_t>(f.type));
+            put8(f.decimals);
+            put(&f.scale, 8);
+            put_str(f.name);
+        }
+    }
+    return n;
+}
+
+/* ── Frames (v5) ─────────────────────────────────────────────────────────
+ *   After the header and schema, records travel in frames — one per flush
+ *   buffer (~8 KiB):
+ *
+ *     LogFrameHeader  payload[len] (whole records, none split)
+ *
+ *   crc covers seq, len and the payload, seeded with the CRC of the
+ *   file's LogFileHeader (log_frame_seed()) — stale frames of a deleted
+ *   log left in preallocated sectors never pass as this file's. A torn or
+ *   garbled write costs the frames it touches: the decoder drops a frame
+ *   whose CRC fails and scans for the next sync word. seq counts frames
+ *   from 0 per file, so a gap shows how many were lost. Frames start
+ *   anywhere (not on a sector boundary); zero padding may sit between them.
+ */
+
+inline constexpr uint8_t LOG_FRAME_SYNC[4] = {0xA5, 0x5A, 'F', 'R'};
+
+struct __attribute__((packed)) LogFrameHeader
+{
+    uint8_t  sync[4]; /* LOG_FRAME_SYNC */
+    uint32_t seq;
+    uint16_t len;     /* payload bytes */
+    uint32_t crc;     /* crc32 of seq, len, payload (seeded) */
+};
+
+static_assert(sizeof(LogFrameHeader) == 14, "LogFrameHeader must be 14 bytes");
+
+/** Per-file CRC seed: crc32 of the file's LogFileHeader. */
+inline uint32_t log_frame_seed(const LogFileHeader &hdr)
+{
+    return crc32(&hdr, sizeof(hdr));
+}
+
+/** CRC of the frame starting at frame (header fields + len payload bytes). */
+inline uint32_t log_frame_crc(const uint8_t *frame, size_t len, uint32_t seed)
+{
+    const uint32_t crc = crc32_update(seed, &frame[offsetof(LogFrameHeader, seq)],
+                                      offsetof(LogFrameHeader, crc) -
+                                              offsetof(LogFrameHeader, seq));
+    return crc32_update(crc, &frame[sizeof(LogFrameHeader)], len);
+}
+
+/**
+ * @brief Fill in the header of a frame whose len payload bytes are
+ *        already in place after it.
+ */
+inline void log_frame_seal(uint8_t *frame, uint32_t seq, size_t len, uint32_t seed)
+{
+    LogFrameHeader h{};
+    memcpy(h.sync, LOG_FRAME_SYNC, sizeof(h.sync));
+    h.seq = seq;
+    h.len = static_cast<uint16_t>(len);
+    memcpy(frame, &h, sizeof(h));
+    h.crc = log_frame_crc(frame, len, seed);
+    memcpy(frame, &h, sizeof(h));
+}
 
 }  // namespace acs
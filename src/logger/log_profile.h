@@ -0,0 +1,194 @@
+/*
+ * ACS4 Flight Computer — Logging Profiles (per-type decimation)
+ *
+ * A profile is a table of keep-1-in-N ratios indexed by msg_id: on the
+ * pad IMU and NAV go down to ~10 Hz, from liftoff to apogee everything
+ * is logged, under the parachute ~50 Hz. LogDecimator holds the active
+ * profile as one atomic pointer, so a switch is a single store and a
+ * producer sees either the old table or the new one, never a mix.
+ *
+ * admit() runs on every logger_log(): one acquire load, one table read
+ * and — only for a thinned type — one relaxed fetch_add on that type's
+ * counter, so threads and ISRs may share a type. Counters keep running
+ * across a switch: the first record kept under a new ratio is anywhere
+ * in its first N, and ratio 1 takes effect immediately.
+ *
+ * The IMU entry applies to IMU samples in any encoding: IMU records are
+ * thinned by admit(), IMU_BLOCK samples by their producer before packing
+ * (sensor_log). IMU_BLOCK and IMU_DELTA records themselves always pass —
+ * a block is already thinned and a delta chain cannot lose links. EVENT
+ * always passes too (static_asserts below).
+ *
+ * No RTOS or hardware dependencies — safe for unit tests on host.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+#include "logger/log_format.h"
+
+namespace acs
+{
+
+/* msg_id 0x00..0x0F have a ratio; higher IDs are never thinned */
+inline constexpr size_t LOG_PROFILE_TYPES = 16;
+
+struct LogProfile
+{
+    const char *name;
+    uint16_t    every[LOG_PROFILE_TYPES]; /* keep 1 in N; 0 = drop the type, 1 = all */
+};
+
+enum class LogProfileId : uint8_t
+{
+    FULL    = 0, /* everything (boost to apogee, default) */
+    PAD     = 1, /* waiting on the pad */
+    DESCENT = 2, /* under the parachute */
+    COUNT,
+};
+
+namespace log_profile_detail
+{
+
+struct Ratio
+{
+    LogMsgId id;
+    uint16_t every;
+};
+
+constexpr LogProfile make(const char *name, std::initializer_list<Ratio> ratios)
+{
+    LogProfile p{name, {}};
+    for (uint16_t &e : p.every)
+    {
+        e = 1;
+    }
+    for (const Ratio &r : ratios)
+    {
+        p.every[static_cast<uint8_t>(r.id)] = r.every;
+    }
+    return p;
+}
+
+}  // namespace log_profile_detail
+
+/* Ratios against the producer rates — IMU 1 kHz (nav stream), NAV 1 kHz,
+ * CTRL 400 Hz, BARO 50 Hz, MAG 100 Hz: pad ~10 Hz, descent ~50 Hz */
+inline constexpr LogProfile LOG_PROFILES[] = {
+    log_profile_detail::make("full", {}),
+    log_profile_detail::make("pad",
+                             {
+                                 {LogMsgId::IMU, 100},
+                                 {LogMsgId::NAV, 100},
+                                 {LogMsgId::CTRL, 40},
+                                 {LogMsgId::BARO, 5},
+                                 {LogMsgId::MAG, 10},
+                             }),
+    log_profile_detail::make("descent",
+                             {
+                                 {LogMsgId::IMU, 20},
+                                 {LogMsgId::NAV, 20},
+                                 {LogMsgId::CTRL, 8},
+                                 {LogMsgId::MAG, 2},
+                             }),
+};
+
+static_assert(sizeof(LOG_PROFILES) / sizeof(LOG_PROFILES[0]) ==
+                      static_cast<size_t>(LogProfileId::COUNT),
+              "one LOG_PROFILES entry per LogProfileId");
+
+namespace log_profile_detail
+{
+
+constexpr bool passes_always()
+{
+    for (const LogProfile &p : LOG_PROFILES)
+    {
+        if (p.every[static_cast<uint8_t>(LogMsgId::IMU_DELTA)] != 1 ||
+            p.every[static_cast<uint8_t>(LogMsgId::IMU_BLOCK)] != 1 ||
+            p.every[static_cast<uint8_t>(LogMsgId::EVENT)] != 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace log_profile_detail
+
+static_assert(log_profile_detail::passes_always(),
+              "IMU_DELTA, IMU_BLOCK and EVENT must never be thinned");
+
+inline const LogProfile &log_profile(LogProfileId id)
+{
+    return LOG_PROFILES[static_cast<size_t>(id)];
+}
+
+/**
+ * @brief Profile by name (shell).
+ * @return false if no profile has that name.
+ */
+inline bool log_profile_find(const char *name, LogProfileId &out)
+{
+    for (size_t i = 0; i < static_cast<size_t>(LogProfileId::COUNT); ++i)
+    {
+        if (std::strcmp(LOG_PROFILES[i].name, name) == 0)
+        {
+            out = static_cast<LogProfileId>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+class LogDecimator
+{
+  public:
+    LogDecimator() = default;
+
+    /** Switch profiles (any thread / ISR): one release store. */
+    void select(LogProfileId id)
+    {
+        active_.store(&log_profile(id), std::memory_order_release);
+    }
+
+    [[nodiscard]] LogProfileId active() const
+    {
+        return static_cast<LogProfileId>(active_.load(std::memory_order_acquire) - LOG_PROFILES);
+    }
+
+    /** Ratio of a type under the active profile (producers that thin samples). */
+    [[nodiscard]] uint16_t every(LogMsgId id) const
+    {
+        return active_.load(std::memory_order_acquire)->every[static_cast<uint8_t>(id)];
+    }
+
+    /**
+     * @brief Keep this record? Called once per record.
+     */
+    bool admit(uint8_t msg_id)
+    {
+        if (msg_id >= LOG_PROFILE_TYPES)
+        {
+            return true;
+        }
+        const uint16_t n = active_.load(std::memory_order_acquire)->every[msg_id];
+        if (n <= 1)
+        {
+            return n == 1;
+        }
+        return count_[msg_id].fetch_add(1, std::memory_order_relaxed) % n == 0;
+    }
+
+  private:
+    std::atomic<const LogProfile *>                      active_{&LOG_PROFILES[0]};
+    std::array<std::atomic<uint32_t>, LOG_PROFILE_TYPES> count_{};
+};
+
+}  // namespace acs
@@ -0,0 +1,185 @@
+/*
+ * ACS4 Flight Computer — Lock-Free Multi-Producer Log Ring
+ *
+ * Byte-record ring with any number of producers (threads or ISRs) and one
+ * consumer, without masking interrupts:
+ *
+ *   reserve  — CAS on the reserve counter claims 1 + ⌈len/4⌉ words
+ *              (LDREX/STREX on Cortex-M7); fails at once if full
+ *   write    — payload copied into the claimed words, outside any lock
+ *   commit   — header word (commit bit | len) stored with release
+ *
+ * The consumer walks records in reservation order and stops at the first
+ * header without the commit bit, so a producer preempted between reserve
+ * and commit delays (never loses or reorders) the records behind it.
+ * Consumed words are zeroed before the tail moves on, which is what keeps
+ * a stale header from ever looking committed on the next lap.
+ *
+ * Storage is relaxed std::atomic<uint32_t> words (as in AtomicWords), so
+ * the concurrent copy is well-defined C++; on Cortex-M7 those are plain
+ * LDR/STR.
+ *
+ * No RTOS or hardware dependencies — safe for unit tests on host.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace acs
+{
+
+template <size_t Capacity>
+class LogRing
+{
+    static_assert(Capacity >= 64 && (Capacity & (Capacity - 1)) == 0,
+                  "LogRing capacity must be a power of two bytes (>= 64)");
+
+  public:
+    static constexpr size_t kCapacity  = Capacity;
+    static constexpr size_t kMaxRecord = Capacity / 4; /* longest record accepted */
+
+    LogRing()                           = default;
+    LogRing(const LogRing &)            = delete;
+    LogRing &operator=(const LogRing &) = delete;
+
+    /**
+     * @brief Append one record (any context, never blocks).
+     * @return false if the ring is full or len is 0 / > kMaxRecord
+     *         (counted in dropped()).
+     */
+    bool write(const void *data, size_t len)
+    {
+        if (len == 0 || len > kMaxRecord)
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const uint32_t need  = 1 + words_for(len);
+        uint32_t       start = reserve_.load(std::memory_order_relaxed);
+        do
+        {
+            if (start + need - tail_.load(std::memory_order_acquire) > kWords)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!reserve_.compare_exchange_weak(
+            start, start + need, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        const auto *src = static_cast<const uint8_t *>(data);
+        for (uint32_t i = 0; i + 1 < need; ++i)
+        {
+            const size_t off = size_t{i} * 4;
+            uint32_t     w   = 0;
+            std::memcpy(&w, src + off, std::min<size_t>(4, len - off));
+            words_[(start + 1 + i) & kMask].store(w, std::memory_order_relaxed);
+        }
+
+        words_[start & kMask].store(kCommitted | static_cast<uint32_t>(len),
+                                    std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Move committed records out, oldest first (single consumer).
+     *
+     * Records are copied whole and back to back (no ring headers); stops
+     * at the first uncommitted record or when the next one would not fit.
+     *
+     * @param records  Optional count of records copied.
+     * @return Bytes written to out.
+     */
+    size_t read(uint8_t *out, size_t max, uint32_t *records = nullptr)
+    {
+        return read(out, max, records, [](const uint8_t *, size_t) {});
+    }
+
+    /**
+     * @brief read(), also calling on_record(rec, len) for each record
+     *        copied (rec points into out) — for consumers that need the
+     *        record boundaries.
+     */
+    template <typename OnRecord>
+    size_t read(uint8_t *out, size_t max, uint32_t *records, OnRecord &&on_record)
+    {
+        uint32_t t    = tail_.load(std::memory_order_relaxed);
+        size_t   n    = 0;
+        uint32_t recs = 0;
+
+        while (true)
+        {
+            const uint32_t hdr = words_[t & kMask].load(std::memory_order_acquire);
+            if ((hdr & kCommitted) == 0)
+            {
+                break;
+            }
+            const size_t len = hdr & kLenMask;
+            if (n + len > max)
+            {
+                break;
+            }
+
+            const uint32_t body = words_for(len);
+            for (uint32_t i = 0; i < body; ++i)
+            {
+                auto          &slot = words_[(t + 1 + i) & kMask];
+                const uint32_t w    = slot.load(std::memory_order_relaxed);
+                const size_t   off  = size_t{i} * 4;
+                std::memcpy(out + n + off, &w, std::min<size_t>(4, len - off));
+                slot.store(0, std::memory_order_relaxed);
+            }
+            words_[t & kMask].store(0, std::memory_order_relaxed);
+            on_record(out + n, len);
+
+            t += 1 + body;
+            n += len;
+            ++recs;
+            tail_.store(t, std::memory_order_release);
+        }
+
+        if (records != nullptr)
+        {
+            *records = recs;
+        }
+        return n;
+    }
+
+    /** Bytes reserved and not yet consumed (ring headers included). */
+    [[nodiscard]] size_t used() const
+    {
+        return size_t{reserve_.load(std::memory_order_acquire) -
+                      tail_.load(std::memory_order_acquire)} *
+               4;
+    }
+
+    /** Records rejected since construction (full ring or bad length). */
+    [[nodiscard]] uint32_t dropped() const
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr uint32_t kWords     = Capacity / 4;
+    static constexpr uint32_t kMask      = kWords - 1;
+    static constexpr uint32_t kCommitted = 0x80000000U;
+    static constexpr uint32_t kLenMask   = 0x0000FFFFU;
+
+    static constexpr uint32_t words_for(size_t len)
+    {
+        return static_cast<uint32_t>((len + 3) / 4);
+    }
+
+    std::array<std::atomic<uint32_t>, kWords> words_{};
+    std::atomic<uint32_t>                     reserve_{0};
+    std::atomic<uint32_t>                     tail_{0};
+    std::atomic<uint32_t>                     dropped_{0};
+};
+
+}  // namespace acs
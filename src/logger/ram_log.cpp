@@ -7,6 +7,8 @@
 #include <cstring>
 
 #include "logger/log_format.h"
+#include "logger/record_ring.h"
+#include "utils/timestamp.h"
 
 extern "C" {
 #include "ch.h"
@@ -17,67 +19,108 @@ extern "C" {
 namespace acs
 {
 
-static constexpr size_t RAM_LOG_SIZE = 53248; /* 52 KiB */
+static constexpr size_t RAM_LOG_SIZE  = 49152; /* 48 KiB rekordow */
+static constexpr size_t RAM_LOG_INDEX = 1024;  /* 8 KiB indeksu (8 B / rekord) */
 
-static uint8_t s_ram_buf[RAM_LOG_SIZE] __attribute__((aligned(4)));
+/* Ring trzyma ~10 s, zegar µs zawija co ~7.8 s — indeks po czasie ciaglym */
+static RecordRing<RAM_LOG_SIZE, RAM_LOG_INDEX> s_ring(TIMESTAMP_WRAP_US);
 
-static size_t s_head = 0;
-static size_t s_used = 0;
+static uint32_t s_last_ts = 0;
+static mutex_t  s_mtx;
 
-void ram_log_init()
+/* IMU_DELTA nie ma LogHeader — dziedziczy znacznik poprzedniego rekordu */
+static uint32_t record_timestamp(const uint8_t *rec, size_t len)
 {
-    s_head = 0;
-    s_used = 0;
+    if (len >= sizeof(LogHeader) && rec[0] != static_cast<uint8_t>(LogMsgId::IMU_DELTA))
+    {
+        LogHeader hdr;
+        memcpy(&hdr, rec, sizeof(hdr));
+        s_last_ts = hdr.timestamp_us;
+    }
+    return s_last_ts;
 }
 
-void ram_log_push(const void *data, size_t len)
+void ram_log_init()
 {
-    if (len == 0 || len > RAM_LOG_SIZE)
-    {
-        return;
-    }
+    chMtxObjectInit(&s_mtx);
+    s_ring.clear();
+    s_last_ts = 0;
+}
 
-    const auto *src = static_cast<const uint8_t *>(data);
+void ram_log_push(const void *rec, size_t len)
+{
+    const auto *p = static_cast<const uint8_t *>(rec);
 
-    const size_t remaining = RAM_LOG_SIZE - s_head;
-    if (len <= remaining)
-    {
-        memcpy(&s_ram_buf[s_head], src, len);
-    }
-    else
-    {
-        memcpy(&s_ram_buf[s_head], src, remaining);
-        memcpy(s_ram_buf, src + remaining, len - remaining);
-    }
+    chMtxLock(&s_mtx);
+    (void)s_ring.push(p, len, record_timestamp(p, len));
+    chMtxUnlock(&s_mtx);
+}
 
-    s_head = (s_head + len) % RAM_LOG_SIZE;
+RamLogCursor ram_log_snapshot()
+{
+    chMtxLock(&s_mtx);
+    const RamLogCursor cur{s_ring.first_seq(), s_ring.end_seq()};
+    chMtxUnlock(&s_mtx);
+    return cur;
+}
 
-    s_used += len;
-    if (s_used > RAM_LOG_SIZE)
-    {
-        s_used = RAM_LOG_SIZE;
-    }
+RamLogCursor ram_log_seek(uint32_t since_us)
+{
+    chMtxLock(&s_mtx);
+    const RamLogCursor cur{s_ring.seek(since_us), s_ring.end_seq()};
+    chMtxUnlock(&s_mtx);
+    return cur;
 }
 
-void ram_log_get(const uint8_t *&buf, size_t &size, size_t &head, size_t &used)
+size_t ram_log_copy(RamLogCursor &cur, uint8_t *out, size_t max)
 {
-    buf  = s_ram_buf;
-    size = RAM_LOG_SIZE;
-    head = s_head;
-    used = s_used;
+    chMtxLock(&s_mtx);
+    const size_t n = s_ring.copy(cur.seq, cur.end, out, max);
+    chMtxUnlock(&s_mtx);
+    return n;
 }
 
 void ram_log_print_status(BaseSequentialStream *chp)
 {
-    chprintf(chp, "RAM log buffer: %u / %u bytes used\r\n",
-             static_cast<unsigned>(s_used),
-             static_cast<unsigned>(RAM_LOG_SIZE));
+    static constexpr size_t MSG_IDS = 16;
+    uint32_t                per_id[MSG_IDS] = {};
+
+    chMtxLock(&s_mtx);
+    const size_t   records = s_ring.size();
+    const size_t   bytes   = s_ring.bytes();
+    const uint32_t evicted = s_ring.evicted();
+    uint32_t       t_first = 0;
+    uint32_t       t_last  = 0;
+    if (records > 0)
+    {
+        t_first = s_ring.at(s_ring.first_seq()).time_us;
+        t_last  = s_ring.at(s_ring.end_seq() - 1).time_us;
+    }
+    for (uint32_t seq = s_ring.first_seq(); seq != s_ring.end_seq(); ++seq)
+    {
+        const uint8_t id = s_ring.at(seq).data[0];
+        per_id[(id < MSG_IDS) ? id : 0]++;
+    }
+    chMtxUnlock(&s_mtx);
+
+    chprintf(chp, "RAM log buffer: %u / %u bytes, %u / %u records, %lu evicted\r\n",
+             static_cast<unsigned>(bytes), static_cast<unsigned>(RAM_LOG_SIZE),
+             static_cast<unsigned>(records), static_cast<unsigned>(RAM_LOG_INDEX), evicted);
 
-    if (s_used > 0)
+    if (records > 0)
     {
-        const uint32_t est_records = static_cast<uint32_t>(s_used) / sizeof(LogImu);
-        chprintf(chp, "~%lu records (avg %uB)\r\n", est_records,
-                 sizeof(LogImu));
+        chprintf(chp, "span: %lu ms\r\n", (t_last - t_first) / 1000U);
+        for (size_t id = 1; id < MSG_IDS; ++id)
+        {
+            if (per_id[id] > 0)
+            {
+                chprintf(chp, "  id 0x%02x: %lu\r\n", static_cast<unsigned>(id), per_id[id]);
+            }
+        }
+        if (per_id[0] > 0)
+        {
+            chprintf(chp, "  unknown: %lu\r\n", per_id[0]);
+        }
     }
 }
 
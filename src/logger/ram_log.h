@@ -2,17 +2,30 @@
  * ACS4 Flight Computer — RAM Log (Black Box Backup)
  *
  * Circular buffer in RAM holding the last ~10 seconds of log records.
- * Survives SD card failures — data can be extracted via debugger or
- * dumped to SD once the card recovers.
+ * Survives SD card failures and, with log.pretrig = 1, keeps filling
+ * while the logger is IDLE on the pad — LoggerThread dumps it to
+ * PRE_NNN.BIN when a trigger fires (logger start, first critical error,
+ * watchdog timeout, `log dump`).
  *
- * Budget: 52 KiB (10s × 1000Hz × ~52 bytes/record average)
- * Located in AXI SRAM.
+ * Budget: 48 KiB of records + 8 KiB index (1024 records). IMU comes in
+ * 32-sample blocks (~210 B per 32 ms), so the records last well over 10 s;
+ * the budget is independent of the IMU ODR (up to 8 kHz with FIFO
+ * oversampling). Located in AXI SRAM.
  *
- * Thread safety: push uses chSysLock (same as flight_logger::log).
+ * Storage: RecordRing (logger/record_ring.h) — whole records plus an
+ * index of {offset, length, timestamp}. The oldest records are evicted
+ * whole, so the count is exact, a dump always starts on a record boundary,
+ * and ram_log_seek() finds a timestamp by binary search.
+ *
+ * Thread safety: one writer (LogPackThread) and readers (the dump in
+ * LoggerThread, the shell), serialized by a mutex held for one record
+ * (or one dump chunk) at a time.
+ * Log producers never touch it.
  */
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 extern "C" {
@@ -22,35 +35,65 @@ extern "C" {
 namespace acs
 {
 
+/**
+ * @brief Read position for a chunked dump (see ram_log_snapshot()).
+ */
+struct RamLogCursor
+{
+    uint32_t seq; /* next record to copy (sequence number) */
+    uint32_t end; /* end at snapshot time — later records are not dumped */
+};
+
 /**
  * @brief Initialize the RAM log ring buffer.
  */
 void ram_log_init();
 
 /**
- * @brief Push a record into the RAM log (circular, overwrites oldest).
+ * @brief Push one record into the RAM log (circular, evicts oldest records).
+ *
+ * Single writer: LogPackThread mirrors every record it drains from the
+ * log ring, as it packs them for the SD card. The index timestamp comes
+ * from the LogHeader (IMU_DELTA, which has none, reuses the previous one).
  *
- * Must be called from within a chSysLock/chSysUnlock pair, or from
- * a context where interrupts are already masked. flight_logger::log()
- * calls this automatically before writing to the SD buffer.
+ * @param rec  One whole packed log record.
+ * @param len  Record size in bytes.
+ */
+void ram_log_push(const void *rec, size_t len);
+
+/**
+ * @brief Start a dump of everything currently in the RAM log.
+ */
+[[nodiscard]] RamLogCursor ram_log_snapshot();
+
+/**
+ * @brief Start a dump at the first record with timestamp ≥ since_us.
  *
- * @param data  Pointer to packed log record.
- * @param len   Size of the record in bytes.
+ * since_us is a timestamp_us() value at most half its period (~3.9 s)
+ * before the newest record; the ring itself orders records by unwrapped
+ * time, so its ~10 s span across clock wraps is fine.
  */
-void ram_log_push(const void *data, size_t len);
+[[nodiscard]] RamLogCursor ram_log_seek(uint32_t since_us);
 
 /**
- * @brief Get the RAM log ring buffer contents for dump.
+ * @brief Copy the next whole records into out, back to back.
  *
- * @param[out] buf   Pointer set to the internal buffer start.
- * @param[out] size  Total buffer capacity.
- * @param[out] head  Current write head position.
- * @param[out] used  Total bytes currently stored (may wrap).
+ * Records evicted since the snapshot are skipped. Takes the mutex only for
+ * the copy, so it can be called repeatedly between other work.
+ *
+ * @return Bytes copied; 0 once the cursor reaches the snapshot end (or
+ *         if the next record does not fit in max).
  */
-void ram_log_get(const uint8_t *&buf, size_t &size, size_t &head, size_t &used);
+size_t ram_log_copy(RamLogCursor &cur, uint8_t *out, size_t max);
+
+[[nodiscard]] inline bool ram_log_done(const RamLogCursor &cur)
+{
+    return static_cast<int32_t>(cur.end - cur.seq) <= 0;
+}
 
 /**
- * @brief Print RAM log summary to a stream (record count estimate).
+ * @brief Print RAM log summary to a stream (exact record count, time span,
+ *        records per message id).
  */
 void ram_log_print_status(BaseSequentialStream *chp);
 
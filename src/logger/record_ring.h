@@ -0,0 +1,293 @@
+/*
+ * ACS4 Flight Computer — Indexed Record Ring
+ *
+ * Byte ring of whole records plus a side index of {offset, length,
+ * timestamp} per record — the storage behind the RAM log:
+ *
+ *   records    — each stored contiguously (a record that would straddle
+ *                the end starts the next lap at offset 0 instead), so a
+ *                reader gets a plain pointer, never a split copy
+ *   eviction   — the oldest records go whole, until the new one fits and
+ *                the index has a free slot; the count is always exact
+ *   sequence   — every record gets the next uint32 sequence number; the
+ *                live records are [first_seq(), end_seq()), and a reader
+ *                holding an evicted number just skips to first_seq()
+ *   seek       — binary search over the index times, O(log n)
+ *
+ * Time: push() stamps come from a clock with a given period (the DWT µs
+ * clock wraps every ~7.8 s, less than the RAM log holds). The index keeps
+ * them unwrapped — each push adds the wrap-aware step from the previous
+ * stamp — so index times rise monotonically over the whole ring and are
+ * compared as int32 differences (good for ~35 min). A stamp at most half
+ * a period behind the previous one counts as a step back, not a wrap.
+ * Records are indexed in push order; seek() assumes that order is (close
+ * to) time order.
+ *
+ * Not thread-safe: the owner serializes push() and readers.
+ *
+ * No RTOS or hardware dependencies — safe for unit tests on host.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace acs
+{
+
+template <size_t DataBytes, size_t IndexCap>
+class RecordRing
+{
+    static_assert(DataBytes >= 64 && DataBytes <= 65536, "RecordRing: 64 B .. 64 KiB of data");
+    static_assert(IndexCap >= 2 && (IndexCap & (IndexCap - 1)) == 0,
+                  "RecordRing index capacity must be a power of two");
+
+  public:
+    static constexpr size_t kDataBytes = DataBytes;
+    static constexpr size_t kIndexCap  = IndexCap;
+    static constexpr size_t kMaxRecord = DataBytes / 4; /* longest record accepted */
+
+    /** One record as stored (valid until the next push()). */
+    struct View
+    {
+        const uint8_t *data;
+        size_t         len;
+        uint32_t       time_us; /* unwrapped push stamp (see above) */
+    };
+
+    /**
+     * @param wrap_us  Period of the push() timestamps (0 = natural 2³² wrap).
+     */
+    explicit RecordRing(uint32_t wrap_us = 0) : wrap_us_(wrap_us) {}
+
+    /**
+     * @brief Append one record, evicting the oldest ones as needed.
+     * @return false if len is 0 or > kMaxRecord (nothing changes).
+     */
+    bool push(const void *rec, size_t len, uint32_t timestamp_us)
+    {
+        if (len == 0 || len > kMaxRecord)
+        {
+            return false;
+        }
+
+        size_t at = wr_;
+        if (at + len > DataBytes)
+        {
+            /* Nowe okrazenie — reszta poprzedniego za 'at' jest najstarsza */
+            while (size() > 0 && entry(first_).off >= at)
+            {
+                evict();
+            }
+            at = 0;
+        }
+
+        while (size() > 0 && (size() == IndexCap || overlaps(entry(first_), at, len)))
+        {
+            evict();
+        }
+
+        std::memcpy(&data_[at], rec, len);
+        entry(next_) = Entry{unwrap(timestamp_us), static_cast<uint16_t>(at),
+                             static_cast<uint16_t>(len)};
+        ++next_;
+        wr_ = at + len;
+        bytes_ += len;
+        return true;
+    }
+
+    /** Drop everything (sequence numbers keep counting). */
+    void clear()
+    {
+        first_ = next_;
+        wr_    = 0;
+        bytes_ = 0;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return next_ - first_;
+    }
+
+    /** Record bytes held (index and lap gap excluded). */
+    [[nodiscard]] size_t bytes() const
+    {
+        return bytes_;
+    }
+
+    /** Records evicted to make room since construction. */
+    [[nodiscard]] uint32_t evicted() const
+    {
+        return evicted_;
+    }
+
+    /** Sequence number of the oldest live record. */
+    [[nodiscard]] uint32_t first_seq() const
+    {
+        return first_;
+    }
+
+    /** Sequence number the next push() gets. */
+    [[nodiscard]] uint32_t end_seq() const
+    {
+        return next_;
+    }
+
+    /** Record seq; seq must be in [first_seq(), end_seq()). */
+    [[nodiscard]] View at(uint32_t seq) const
+    {
+        const Entry &e = entry(seq);
+        return View{&data_[e.off], e.len, e.ts};
+    }
+
+    /**
+     * @brief First live record with timestamp ≥ t (end_seq() if none).
+     *
+     * t is a stamp on the push() clock, taken as at most half a period
+     * before the newest record; anything later is past the newest record.
+     */
+    [[nodiscard]] uint32_t seek(uint32_t t) const
+    {
+        if (size() == 0)
+        {
+            return next_;
+        }
+        const uint32_t back = elapsed(t, last_stamp_);
+        if (back > half_period())
+        {
+            return next_;
+        }
+        const uint32_t target = time_ - back;
+
+        uint32_t lo = first_;
+        uint32_t n  = next_ - first_;
+        while (n > 0)
+        {
+            const uint32_t half = n / 2;
+            if (static_cast<int32_t>(entry(lo + half).ts - target) < 0)
+            {
+                lo += half + 1;
+                n -= half + 1;
+            }
+            else
+            {
+                n = half;
+            }
+        }
+        return lo;
+    }
+
+    /**
+     * @brief Copy whole records [seq, end) back to back into out.
+     *
+     * A seq already evicted is moved up to first_seq(). Stops before the
+     * first record that does not fit; seq is advanced past the copied ones.
+     *
+     * @return Bytes written to out.
+     */
+    size_t copy(uint32_t &seq, uint32_t end, uint8_t *out, size_t max) const
+    {
+        if (static_cast<int32_t>(seq - first_) < 0)
+        {
+            seq = first_;
+        }
+        if (static_cast<int32_t>(end - next_) > 0)
+        {
+            end = next_;
+        }
+
+        size_t n = 0;
+        while (static_cast<int32_t>(end - seq) > 0)
+        {
+            const Entry &e = entry(seq);
+            if (n + e.len > max)
+            {
+                break;
+            }
+            std::memcpy(&out[n], &data_[e.off], e.len);
+            n += e.len;
+            ++seq;
+        }
+        return n;
+    }
+
+  private:
+    struct Entry
+    {
+        uint32_t ts; /* unwrapped */
+        uint16_t off;
+        uint16_t len;
+    };
+
+    static constexpr uint32_t kMask = IndexCap - 1;
+
+    uint32_t elapsed(uint32_t from, uint32_t to) const
+    {
+        if (wrap_us_ == 0)
+        {
+            return to - from;
+        }
+        return (to >= from) ? to - from : to + (wrap_us_ - from);
+    }
+
+    uint32_t half_period() const
+    {
+        return (wrap_us_ == 0) ? 0x80000000U : wrap_us_ / 2U;
+    }
+
+    /* Znacznik zegara → czas ciagly; krok > pol okresu to cofniecie */
+    uint32_t unwrap(uint32_t stamp)
+    {
+        if (!have_time_)
+        {
+            have_time_ = true;
+            time_      = stamp;
+        }
+        else
+        {
+            const uint32_t step = elapsed(last_stamp_, stamp);
+            time_ += (step <= half_period()) ? step : step - ((wrap_us_ == 0) ? 0U : wrap_us_);
+        }
+        last_stamp_ = stamp;
+        return time_;
+    }
+
+    static bool overlaps(const Entry &e, size_t at, size_t len)
+    {
+        return e.off >= at && e.off < at + len;
+    }
+
+    Entry &entry(uint32_t seq)
+    {
+        return index_[seq & kMask];
+    }
+
+    const Entry &entry(uint32_t seq) const
+    {
+        return index_[seq & kMask];
+    }
+
+    void evict()
+    {
+        bytes_ -= entry(first_).len;
+        ++first_;
+        ++evicted_;
+    }
+
+    std::array<uint8_t, DataBytes> data_{};
+    std::array<Entry, IndexCap>    index_{};
+    uint32_t                       first_      = 0;
+    uint32_t                       next_       = 0;
+    size_t                         wr_         = 0;
+    size_t                         bytes_      = 0;
+    uint32_t                       evicted_    = 0;
+    uint32_t                       wrap_us_;
+    uint32_t                       last_stamp_ = 0; /* stamp of the newest push */
+    uint32_t                       time_       = 0; /* its unwrapped time */
+    bool                           have_time_  = false;
+};
+
+}  // namespace acs
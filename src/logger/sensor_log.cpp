@@ -0,0 +1,141 @@
+/*
+ * ACS4 Flight Computer — Sensor Log Producer Implementation
+ */
+
+#include "logger/sensor_log.h"
+
+#include "logger/flight_logger.h"
+#include "logger/imu_delta_codec.h"
+#include "sensors/sensor_hub.h"
+#include "system/params.h"
+#include "utils/profiler.h"
+
+extern "C" {
+#include "ch.h"
+
+#include "hal.h"
+}
+
+namespace acs
+{
+
+static constexpr uint32_t kSensorLogPeriodMs = 10;
+
+/* Batch odczytu z pierscienia — 8 kHz × 10 ms = 80 probek na tick */
+static constexpr size_t kLogBatch = 32;
+
+static int g_prof_slog = -1;
+
+static ImuReading g_log_batch[kLogBatch];
+
+static THD_WORKING_AREA(waSensorLogThread, 1024);
+
+/* ~600 B — statycznie, nie na stosie watku */
+static ImuBlockEncoder g_imu_block;
+
+/* Przerzedzanie probek wg profilu logowania: co g_imu_every-ta (0 = zadna) */
+static uint16_t g_imu_every = 1;
+static uint32_t g_imu_skip  = 0;
+
+static void flush_imu_block()
+{
+    if (g_imu_block.count() > 0)
+    {
+        (void)logger_log(g_imu_block.data(), g_imu_block.size());
+        g_imu_block.clear();
+    }
+}
+
+/* Oproznia pierscien przez kursor do blokow IMU_BLOCK */
+template <typename Ring>
+static uint32_t log_imu_ring(const Ring &ring, SampleCursor &cur)
+{
+    uint32_t count = 0;
+    size_t   n     = 0;
+
+    do
+    {
+        n = ring.read(cur, g_log_batch, kLogBatch);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (g_imu_every == 0 || g_imu_skip++ % g_imu_every != 0)
+            {
+                continue;
+            }
+            const ImuFixed s = imu_fixed_from(g_log_batch[i]);
+            if (!g_imu_block.fits(s))
+            {
+                flush_imu_block();
+            }
+            g_imu_block.append(s);
+            if (g_imu_block.full())
+            {
+                flush_imu_block();
+            }
+        }
+        count += static_cast<uint32_t>(n);
+    } while (n == kLogBatch);
+
+    return count;
+}
+
+static THD_FUNCTION(SensorLogThread, arg)
+{
+    (void)arg;
+    chRegSetThreadName("sensor_log");
+
+    g_prof_slog = profiler_register("sensor_log");
+
+    const ParamRef imu_raw = param_bind("log.imu_raw");
+
+    const ImuNavRing &nav_ring = sensor_hub().imu_nav_history();
+    const ImuRing    &raw_ring = sensor_hub().imu_history();
+
+    SampleCursor nav_cur = nav_ring.subscribe();
+    SampleCursor raw_cur = raw_ring.subscribe();
+    bool         raw_src = false;
+
+    systime_t next = chVTGetSystemTimeX();
+
+    while (true)
+    {
+        next += TIME_MS2I(kSensorLogPeriodMs);
+
+        PROFILE_BEGIN(g_prof_slog);
+
+        const bool want_raw = imu_raw.get_or(0.0f) > 0.5f;
+        if (want_raw != raw_src)
+        {
+            /* Zmiana zrodla — nowy blok od biezacej glowy pierscienia */
+            flush_imu_block();
+            nav_cur = nav_ring.subscribe();
+            raw_cur = raw_ring.subscribe();
+            raw_src = want_raw;
+        }
+
+        const uint16_t every = logger_profile_every(LogMsgId::IMU);
+        if (every != g_imu_every)
+        {
+            /* Nowy profil — otwarty blok zamkniety, nastepny z nowym okresem */
+            flush_imu_block();
+            g_imu_every = every;
+            g_imu_skip  = 0;
+        }
+
+        const uint32_t n = raw_src ? log_imu_ring(raw_ring, raw_cur)
+                                   : log_imu_ring(nav_ring, nav_cur);
+        profiler_items(g_prof_slog, n);
+
+        PROFILE_END(g_prof_slog);
+
+        chThdSleepUntil(next);
+    }
+}
+
+void start_sensor_log()
+{
+    chThdCreateStatic(
+        waSensorLogThread, sizeof(waSensorLogThread), NORMALPRIO - 10, SensorLogThread, nullptr);
+}
+
+}  // namespace acs
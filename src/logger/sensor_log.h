@@ -0,0 +1,34 @@
+/*
+ * ACS4 Flight Computer — Sensor Log Producer
+ *
+ * SensorLogThread (100 Hz, prio NORMALPRIO - 10, 1 KB stack):
+ *   Drains the SensorHub IMU ring with its own cursor and packs the
+ *   samples into IMU_BLOCK records (logger/imu_delta_codec.h): up to 32
+ *   samples per record, one logger_log() call per block. A block is
+ *   closed when full or when a sample falls off its period grid (gap,
+ *   rate change); an open block waits for the next tick, so log latency
+ *   is at most 32 samples.
+ *
+ * Source selected by param log.imu_raw (read every tick):
+ *   0 — decimated 1 kHz nav stream (imu_nav_history)
+ *   1 — full IMU ODR stream, 2–8 kHz (imu_history)
+ *
+ * Samples are thinned by the IMU ratio of the active logging profile
+ * (logger_profile_every(), read every tick): keep 1 in N of the selected
+ * stream, so the pad profile's 100 gives 10 Hz from the nav stream. A
+ * ratio change closes the open block; the next one uses the new period.
+ *
+ * Blocks are self-contained: a block rejected by logger_log() (not
+ * logging, ring full) is simply lost, the next one decodes.
+ *
+ * Call start_sensor_log() once after logger_init(). Custom PCB only.
+ */
+
+#pragma once
+
+namespace acs
+{
+
+void start_sensor_log();
+
+}  // namespace acs
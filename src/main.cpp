@@ -27,13 +27,16 @@ extern "C" {
 
 #include "actuators/actuator_hub.h"
 #include "actuators/actuator_threads.h"
+#include "control/control_thread.h"
 #include "drivers/iim42653.h"
 #include "drivers/mmc5983ma.h"
 #include "drivers/ms5611.h"
 #include "drivers/servo_t75.h"
+#include "sensors/sensor_hub.h"
 #include "sensors/sensor_threads.h"
 #include "system/debug_shell.h"
 #include "system/error_handler.h"
+#include "system/params.h"
 #include "system/watchdog.h"
 #include "utils/timestamp.h"
 
@@ -42,6 +45,7 @@ extern "C" {
     #include "hal/spi_bus.h"
     #include "logger/flight_logger.h"
     #include "logger/ram_log.h"
+    #include "logger/sensor_log.h"
     #include "system/usb_cdc.h"
 #endif
 
@@ -177,15 +181,45 @@ static THD_FUNCTION(LoggerThread, arg)
 /*---------------------------------------------------------------------------*/
 
 #if defined(STM32H725xx)
+/* imu.decim zaokraglony w dol do 1/2/4/8 (ODR musi byc wielokrotnoscia 1 kHz) */
+static uint8_t imu_decimation_factor()
+{
+    float decim = 1.0f;
+    (void)acs::param_get("imu.decim", decim);
+
+    uint8_t factor = 1;
+    while (factor < acs::kDecimMaxFactor && static_cast<float>(factor * 2) <= decim + 0.5f)
+    {
+        factor = static_cast<uint8_t>(factor * 2);
+    }
+    return factor;
+}
+
 static void init_sensors(BaseSequentialStream *serial)
 {
     if (g_spi.init(&SPID2))
     {
         if (g_imu.init(g_spi, LINE_IMU_CS, imu_spi_cfg))
         {
-            if (g_imu.configure(acs::Iim42653Config::rocket_default()))
+            /* FIFO batch mode: INT1 on watermark, ImuThread drains in bulk.
+             * ODR = decim × 1 kHz; SensorHub decimates back to 1 kHz. */
+            const uint8_t decim   = imu_decimation_factor();
+            auto          imu_cfg = acs::Iim42653Config::rocket_fifo_oversampled(decim);
+            float         wm      = 0.0f;
+            if (acs::param_get("imu.fifo_wm", wm))
+            {
+                imu_cfg.fifo_watermark = static_cast<uint16_t>(wm + 0.5f);
+            }
+
+            if (g_imu.configure(imu_cfg) &&
+                acs::sensor_hub().configure_imu_decimation(
+                    decim, acs::DecimatorKind::FIR, acs::TIMESTAMP_WRAP_US))
             {
-                chprintf(serial, "IMU: IIM-42653 OK\r\n");
+                chprintf(serial,
+                         "IMU: IIM-42653 OK (FIFO %lu Hz, wm=%u, decim=%u)\r\n",
+                         g_imu.odr_hz(),
+                         g_imu.fifo_watermark(),
+                         decim);
             }
             else
             {
@@ -256,6 +290,7 @@ static void init_sd_logger(BaseSequentialStream *serial)
     }
 
     chThdCreateStatic(waLogger, sizeof(waLogger), NORMALPRIO - 20, LoggerThread, nullptr);
+    acs::start_sensor_log();
 }
 #endif
 
@@ -305,7 +340,8 @@ int main()
 
     acs::start_sensor_threads();
 
-    /* Start actuator write-out thread (custom PCB only — no-op on Nucleo). */
+    /* Start attitude control + actuator write-out threads (custom PCB only). */
+    acs::start_control_thread();
     acs::start_actuator_threads();
 
 #if defined(STM32H725xx)
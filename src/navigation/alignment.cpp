@@ -0,0 +1,48 @@
+/**
+ * @file alignment.cpp
+ * @brief Static attitude alignment (TRIAD) — implementation.
+ */
+
+#include "navigation/alignment.h"
+
+namespace acs::nav
+{
+
+bool triad_align(const Vec3 &accel_body, const Vec3 &mag_body, Quat &q)
+{
+    const float f_norm = accel_body.norm();
+    if (!(f_norm > 1e-3f))
+    {
+        return false;
+    }
+    const Vec3 b1 = accel_body / f_norm;
+
+    /* Druga os: b1 × m; gdy pole prawie rownolegle do g (lub brak mag),
+     * kierunek "do przodu" plytki (+Y) pelni role polnocy */
+    Vec3 w = b1.cross(mag_body);
+    if (w.norm() < 1e-3f * mag_body.norm() || w.norm() < 1e-9f)
+    {
+        w = b1.cross(Vec3::UnitY());
+        if (w.norm() < 1e-3f)
+        {
+            w = b1.cross(Vec3::UnitX());
+        }
+    }
+
+    Mat3 B;
+    B.col(0) = b1;
+    B.col(1) = w.normalized();
+    B.col(2) = b1.cross(B.col(1));
+
+    /* Ta sama triada w NED: gora = (0,0,-1), polnoc = (1,0,0) */
+    const Vec3 r1(0.0f, 0.0f, -1.0f);
+    Mat3       N;
+    N.col(0) = r1;
+    N.col(1) = r1.cross(Vec3::UnitX());
+    N.col(2) = r1.cross(N.col(1));
+
+    q = quat_normalize(Quat(Mat3(N * B.transpose())));
+    return true;
+}
+
+}  // namespace acs::nav
@@ -0,0 +1,39 @@
+/**
+ * @file alignment.h
+ * @brief Static (launch-pad) attitude alignment — TRIAD.
+ *
+ * Two non-parallel vector observations in body frame, paired with their
+ * known NED directions, fix the attitude:
+ *
+ *   primary    specific force at rest  ↔  up    (0, 0, -1)   — exact
+ *   secondary  magnetic field          ↔  north (1, 0, 0)    — only the
+ *              component perpendicular to gravity is used
+ *
+ * The primary vector is matched exactly, so roll/pitch come from the
+ * accelerometer alone and magnetic errors only affect yaw. Yaw 0 is
+ * magnetic north; declination is left to the caller.
+ *
+ * Thread safety: pure function.
+ */
+
+#pragma once
+
+#include "navigation/quaternion.h"
+
+namespace acs::nav
+{
+
+/**
+ * @brief Body → NED attitude from averaged accel and mag at rest.
+ *
+ * If the field is missing or (nearly) parallel to gravity, the board's
+ * forward axis (+Y) is taken as north instead.
+ *
+ * @param accel_body  Mean specific force [m/s²] (any scale).
+ * @param mag_body    Mean magnetic field (any unit, may be zero).
+ * @param[out] q      Attitude, valid only when true is returned.
+ * @return false if the accelerometer vector is degenerate.
+ */
+[[nodiscard]] bool triad_align(const Vec3 &accel_body, const Vec3 &mag_body, Quat &q);
+
+}  // namespace acs::nav
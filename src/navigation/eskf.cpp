@@ -0,0 +1,243 @@
+/**
+ * @file eskf.cpp
+ * @brief Error-state Kalman filter — implementation.
+ */
+
+#include "navigation/eskf.h"
+
+#include <cmath>
+
+namespace acs::nav
+{
+
+namespace
+{
+
+using Rows3 = Eigen::Matrix<float, 3, 15>;
+using Cols3 = Eigen::Matrix<float, 15, 3>;
+
+/* Gorna granica wariancji — powyzej filtr uznajemy za rozbiegniety */
+constexpr float kMaxVariance = 1e8f;
+
+void add_diag(Mat15 &P, int idx, float var)
+{
+    P(idx + 0, idx + 0) += var;
+    P(idx + 1, idx + 1) += var;
+    P(idx + 2, idx + 2) += var;
+}
+
+void symmetrize(Mat15 &P)
+{
+    for (int r = 0; r < 15; ++r)
+    {
+        for (int c = r + 1; c < 15; ++c)
+        {
+            const float m = 0.5f * (P(r, c) + P(c, r));
+            P(r, c)       = m;
+            P(c, r)       = m;
+        }
+    }
+}
+
+}  // namespace
+
+/* =====================================================================
+ * Inicjalizacja
+ * ===================================================================== */
+
+Eskf::Eskf()
+{
+    init(EskfConfig::rocket_default(), Quat::Identity());
+}
+
+void Eskf::init(const EskfConfig &cfg, const Quat &q0, const Vec3 &p0)
+{
+    cfg_   = cfg;
+    x_.q   = quat_normalize(q0);
+    x_.v   = Vec3::Zero();
+    x_.p   = p0;
+    x_.bg  = Vec3::Zero();
+    x_.ba  = Vec3::Zero();
+    innov_ = 0.0f;
+
+    P_.setZero();
+    add_diag(P_, kIdxTheta, cfg.init_att_rad * cfg.init_att_rad);
+    add_diag(P_, kIdxVel, cfg.init_vel_mps * cfg.init_vel_mps);
+    add_diag(P_, kIdxPos, cfg.init_pos_m * cfg.init_pos_m);
+    add_diag(P_, kIdxBg, cfg.init_bg_rads * cfg.init_bg_rads);
+    add_diag(P_, kIdxBa, cfg.init_ba_mps2 * cfg.init_ba_mps2);
+}
+
+void Eskf::set_mag_reference(const Vec3 &mag_ned)
+{
+    if (mag_ned.x() != 0.0f || mag_ned.y() != 0.0f)
+    {
+        mag_ref_heading_ = std::atan2(mag_ned.y(), mag_ned.x());
+    }
+}
+
+/* =====================================================================
+ * Predykcja
+ * ===================================================================== */
+
+EskfStatus Eskf::predict(const DeltaState &d)
+{
+    const float dt = d.dt;
+    if (!(dt > 0.0f))
+    {
+        return EskfStatus::OK;
+    }
+
+    /* Przyrosty skorygowane o biasy (stale w przedziale) */
+    const Vec3 dtheta = d.dtheta - x_.bg * dt;
+    const Vec3 dvel   = d.dvel - x_.ba * dt;
+
+    const Mat3 R  = quat_to_dcm(x_.q);
+    const Vec3 dv = R * dvel + Vec3(0.0f, 0.0f, kGravity * dt);
+
+    /* Stan nominalny — trapez dla pozycji */
+    x_.p += (x_.v + 0.5f * dv) * dt;
+    x_.v += dv;
+    x_.q = apply_delta_angle(x_.q, dtheta);
+
+    const Mat3 Et    = quat_to_dcm(quat_from_rotation_vector(dtheta)).transpose();
+    const Mat3 F_vth = -R * skew(dvel);
+    const Mat3 F_vba = -R * dt;
+    propagate_covariance(Et, F_vth, F_vba, dt);
+
+    /* Q = σ²·dt dla gestosci szumu bialego / bladzenia losowego */
+    add_diag(P_, kIdxTheta, cfg_.gyro_noise * cfg_.gyro_noise * dt);
+    add_diag(P_, kIdxVel, cfg_.accel_noise * cfg_.accel_noise * dt);
+    add_diag(P_, kIdxBg, cfg_.gyro_bias_rw * cfg_.gyro_bias_rw * dt);
+    add_diag(P_, kIdxBa, cfg_.accel_bias_rw * cfg_.accel_bias_rw * dt);
+    symmetrize(P_);
+
+    return check_health();
+}
+
+void Eskf::propagate_covariance(const Mat3 &Et, const Mat3 &F_vth, const Mat3 &F_vba, float dt)
+{
+    /* M = F·P — tylko wiersze δθ, δv, δp sie zmieniaja (biasy: wiersz jednostkowy).
+     * Wiersz δp liczony przed nadpisaniem δv, bo korzysta ze starego P_v. */
+    const Rows3 m_th = Et * P_.middleRows<3>(kIdxTheta) - dt * P_.middleRows<3>(kIdxBg);
+    const Rows3 m_v  = P_.middleRows<3>(kIdxVel) + F_vth * P_.middleRows<3>(kIdxTheta) +
+                      F_vba * P_.middleRows<3>(kIdxBa);
+    P_.middleRows<3>(kIdxPos) += dt * P_.middleRows<3>(kIdxVel);
+    P_.middleRows<3>(kIdxTheta) = m_th;
+    P_.middleRows<3>(kIdxVel)   = m_v;
+
+    /* P' = M·Fᵀ — te same operacje na kolumnach */
+    const Cols3 c_th = P_.middleCols<3>(kIdxTheta) * Et.transpose() -
+                       dt * P_.middleCols<3>(kIdxBg);
+    const Cols3 c_v = P_.middleCols<3>(kIdxVel) + P_.middleCols<3>(kIdxTheta) * F_vth.transpose() +
+                      P_.middleCols<3>(kIdxBa) * F_vba.transpose();
+    P_.middleCols<3>(kIdxPos) += dt * P_.middleCols<3>(kIdxVel);
+    P_.middleCols<3>(kIdxTheta) = c_th;
+    P_.middleCols<3>(kIdxVel)   = c_v;
+}
+
+/* =====================================================================
+ * Aktualizacje pomiarowe
+ * ===================================================================== */
+
+EskfStatus Eskf::update_baro(float alt_m, const NavState &at)
+{
+    if (!std::isfinite(alt_m))
+    {
+        return EskfStatus::REJECTED;
+    }
+
+    /* h(x) = ref - p_z  →  H = -1 na δp_z */
+    constexpr int kPz = kIdxPos + 2;
+    const float   y   = alt_m - (baro_ref_m_ - at.p.z());
+    const float   S   = P_(kPz, kPz) + cfg_.baro_noise_m * cfg_.baro_noise_m;
+    innov_            = y;
+
+    if (cfg_.gate_sigma > 0.0f && y * y > cfg_.gate_sigma * cfg_.gate_sigma * S)
+    {
+        return EskfStatus::REJECTED;
+    }
+
+    const Vec15 K = P_.col(kPz) * (-1.0f / S);
+    inject(K * y);
+    P_.noalias() -= (S * K) * K.transpose();
+
+    return check_health();
+}
+
+EskfStatus Eskf::update_mag(const Vec3 &mag_body, const NavState &at)
+{
+    /* Pole w NED wg orientacji z chwili pomiaru; kurs z rzutu poziomego */
+    const Vec3  m_ned  = quat_to_dcm(at.q) * mag_body;
+    const float horiz2 = m_ned.x() * m_ned.x() + m_ned.y() * m_ned.y();
+    if (!(horiz2 > 1e-12f) || !std::isfinite(horiz2))
+    {
+        return EskfStatus::REJECTED;
+    }
+
+    /* Blad kursu ε (szacowany - prawdziwy) obraca pomiar o +ε, wiec
+     * y = ψ_ref - ψ_meas = -ε = e_zᵀ·R·δθ  →  H = 3. wiersz R na δθ */
+    constexpr float kPi      = 3.14159265358979f;
+    const float     psi_meas = std::atan2(m_ned.y(), m_ned.x());
+    float           y        = mag_ref_heading_ - psi_meas;
+    if (y > kPi)
+    {
+        y -= 2.0f * kPi;
+    }
+    else if (y < -kPi)
+    {
+        y += 2.0f * kPi;
+    }
+    innov_ = y;
+
+    /* Jakobian w biezacym stanie — δθ jest w biezacym ukladzie body */
+    const Vec3  h   = quat_to_dcm(x_.q).row(2).transpose();
+    const Vec15 PHt = P_.middleCols<3>(kIdxTheta) * h;
+    const float S   = h.dot(PHt.segment<3>(kIdxTheta)) + cfg_.mag_noise * cfg_.mag_noise;
+
+    if (cfg_.gate_sigma > 0.0f && y * y > cfg_.gate_sigma * cfg_.gate_sigma * S)
+    {
+        return EskfStatus::REJECTED;
+    }
+
+    const Vec15 K = PHt * (1.0f / S);
+    inject(K * y);
+    P_.noalias() -= (S * K) * K.transpose();
+
+    return check_health();
+}
+
+/* =====================================================================
+ * Wstrzykniecie bledu i kontrola
+ * ===================================================================== */
+
+void Eskf::inject(const Vec15 &dx)
+{
+    /* Jakobian resetu G = I - [½δθ]× pomijamy — δθ po aktualizacji jest
+     * rzedu kilku mrad, a efekt na P jest drugiego rzedu. */
+    x_.q = apply_delta_angle(x_.q, dx.segment<3>(kIdxTheta));
+    x_.v += dx.segment<3>(kIdxVel);
+    x_.p += dx.segment<3>(kIdxPos);
+    x_.bg += dx.segment<3>(kIdxBg);
+    x_.ba += dx.segment<3>(kIdxBa);
+}
+
+EskfStatus Eskf::check_health() const
+{
+    if (!x_.q.coeffs().allFinite() || !x_.v.allFinite() || !x_.p.allFinite() ||
+        !x_.bg.allFinite() || !x_.ba.allFinite())
+    {
+        return EskfStatus::DIVERGED;
+    }
+    for (int i = 0; i < 15; ++i)
+    {
+        const float var = P_(i, i);
+        if (!(var >= 0.0f) || var > kMaxVariance)
+        {
+            return EskfStatus::DIVERGED;
+        }
+    }
+    return EskfStatus::OK;
+}
+
+}  // namespace acs::nav
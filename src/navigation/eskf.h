@@ -0,0 +1,237 @@
+/**
+ * @file eskf.h
+ * @brief Error-state Kalman filter: attitude, velocity, position, IMU biases.
+ *
+ * Nominal state (full, nonlinear):
+ *   q   body → NED attitude        v   NED velocity [m/s]
+ *   p   NED position [m]           bg  gyro bias [rad/s]   ba  accel bias [m/s²]
+ *
+ * Error state δx (15, linear, reset to zero after every injection):
+ *   [ δθ(0..2)  δv(3..5)  δp(6..8)  δbg(9..11)  δba(12..14) ]
+ *   with q_true = q ⊗ Exp(δθ)  (local / body-frame attitude error).
+ *
+ * Prediction consumes coning/sculling-compensated DeltaState intervals
+ * (see preintegration.h), so it can run at the nav rate rather than the
+ * IMU rate. Covariance propagation exploits the block sparsity of F
+ * (rows/columns ordered δθ δv δp δbg δba, E = Exp(Δθ), R = C(q)):
+ *
+ *   δθ'  = Eᵀ·δθ - dt·δbg
+ *   δv'  = δv - R[Δv]×·δθ - R·dt·δba
+ *   δp'  = δp + dt·δv
+ *   δbg' = δbg,  δba' = δba
+ *
+ * F·P·Fᵀ is formed as three row-block and three column-block updates
+ * (~1k MAC) instead of two dense 15×15 products (~6.7k MAC).
+ *
+ * Measurement updates:
+ *   baro — scalar altitude, H = -1 on δp_z, P -= S·K·Kᵀ
+ *   mag  — scalar heading, H = e_zᵀ·R on the δθ block only; the field's
+ *          inclination and magnitude are ignored, so local magnetic
+ *          disturbances cannot tilt roll/pitch
+ *
+ * Delayed measurements: both updates accept the nominal state at the
+ * measurement's sample time (from StateHistory). The innovation is formed
+ * against that past state; the Jacobian, gain and correction use the
+ * current state and covariance, i.e. the error state is carried over the
+ * lag with Φ ≈ I (lags here are tens of ms).
+ *
+ * Every matrix is fixed-size Eigen (no heap); the unit tests run the
+ * filter with Eigen's runtime malloc check enabled.
+ *
+ * Thread safety: none — one instance owned by NavThread.
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+#include <cstdint>
+
+#include "navigation/preintegration.h"
+#include "navigation/quaternion.h"
+
+namespace acs::nav
+{
+
+using Mat15 = Eigen::Matrix<float, 15, 15>;
+using Vec15 = Eigen::Matrix<float, 15, 1>;
+
+/* Error-state block offsets */
+inline constexpr int kIdxTheta = 0;
+inline constexpr int kIdxVel   = 3;
+inline constexpr int kIdxPos   = 6;
+inline constexpr int kIdxBg    = 9;
+inline constexpr int kIdxBa    = 12;
+
+inline constexpr float kGravity = 9.80665f;
+
+/**
+ * @brief Filter tuning (continuous-time densities and measurement sigmas).
+ */
+struct EskfConfig
+{
+    float gyro_noise;    /* rad/s/√Hz   — angle random walk */
+    float accel_noise;   /* m/s²/√Hz    — velocity random walk */
+    float gyro_bias_rw;  /* rad/s²/√Hz  — gyro bias instability */
+    float accel_bias_rw; /* m/s³/√Hz    — accel bias instability */
+    float baro_noise_m;  /* 1σ baro altitude [m] */
+    float mag_noise;     /* 1σ magnetic heading [rad] */
+    float gate_sigma;    /* innovation gate, in σ (0 = disabled) */
+
+    /* Initial 1σ uncertainty */
+    float init_att_rad;
+    float init_vel_mps;
+    float init_pos_m;
+    float init_bg_rads;
+    float init_ba_mps2;
+
+    static constexpr EskfConfig rocket_default()
+    {
+        return {
+            .gyro_noise    = 0.01f,
+            .accel_noise   = 0.5f,
+            .gyro_bias_rw  = 1e-4f,
+            .accel_bias_rw = 1e-3f,
+            .baro_noise_m  = 0.5f,
+            .mag_noise     = 0.05f,
+            .gate_sigma    = 5.0f,
+            .init_att_rad  = 0.05f,
+            .init_vel_mps  = 0.1f,
+            .init_pos_m    = 0.1f,
+            .init_bg_rads  = 0.01f,
+            .init_ba_mps2  = 0.2f,
+        };
+    }
+};
+
+/**
+ * @brief Nominal navigation state.
+ */
+struct NavState
+{
+    Quat q;
+    Vec3 v;
+    Vec3 p;
+    Vec3 bg;
+    Vec3 ba;
+};
+
+enum class EskfStatus : uint8_t
+{
+    OK       = 0,
+    REJECTED = 1, /* innovation outside gate — measurement ignored */
+    DIVERGED = 2, /* non-finite or runaway covariance/state */
+};
+
+class Eskf
+{
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    Eskf();
+
+    /**
+     * @brief (Re)start the filter at a known attitude, zero velocity.
+     */
+    void init(const EskfConfig &cfg, const Quat &q0, const Vec3 &p0 = Vec3::Zero());
+
+    /**
+     * @brief Update tuning without resetting state or covariance.
+     */
+    void set_config(const EskfConfig &cfg)
+    {
+        cfg_ = cfg;
+    }
+
+    /**
+     * @brief Propagate nominal state and covariance over one interval.
+     * @return DIVERGED if the result is non-finite.
+     */
+    EskfStatus predict(const DeltaState &d);
+
+    /**
+     * @brief Baro altitude update (up-positive, relative to the reference).
+     * @param alt_m  Barometric altitude [m] in the same datum as set_baro_reference().
+     */
+    EskfStatus update_baro(float alt_m)
+    {
+        return update_baro(alt_m, x_);
+    }
+
+    /**
+     * @brief Delayed baro update — innovation against the state at sample time.
+     * @param at  Nominal state interpolated at the measurement timestamp.
+     */
+    EskfStatus update_baro(float alt_m, const NavState &at);
+
+    /**
+     * @brief Magnetometer heading update (yaw only).
+     * @param mag_body  Measured field in body frame (any unit).
+     * @return REJECTED if the field is (nearly) vertical or outside the gate.
+     */
+    EskfStatus update_mag(const Vec3 &mag_body)
+    {
+        return update_mag(mag_body, x_);
+    }
+
+    /**
+     * @brief Delayed mag update — heading innovation against the state at
+     *        sample time.
+     */
+    EskfStatus update_mag(const Vec3 &mag_body, const NavState &at);
+
+    /** Baro altitude corresponding to p_z = 0 (launch pad). */
+    void set_baro_reference(float alt0_m)
+    {
+        baro_ref_m_ = alt0_m;
+    }
+
+    /** Earth field in NED (any unit; only the horizontal direction is used). */
+    void set_mag_reference(const Vec3 &mag_ned);
+
+    [[nodiscard]] const NavState &state() const
+    {
+        return x_;
+    }
+
+    [[nodiscard]] const Mat15 &covariance() const
+    {
+        return P_;
+    }
+
+    /** Overwrite the nominal state and covariance (delayed-fusion replay). */
+    void restore(const NavState &x, const Mat15 &P)
+    {
+        x_ = x;
+        P_ = P;
+    }
+
+    /** Last innovation (baro: m, mag: rad) — for logging. */
+    [[nodiscard]] float last_innovation() const
+    {
+        return innov_;
+    }
+
+  private:
+    void       propagate_covariance(const Mat3 &Et, const Mat3 &F_vth, const Mat3 &F_vba, float dt);
+    void       inject(const Vec15 &dx);
+    EskfStatus check_health() const;
+
+    EskfConfig cfg_;
+    NavState   x_;
+    Mat15      P_;
+    float      innov_           = 0.0f;
+    float      baro_ref_m_      = 0.0f;
+    float      mag_ref_heading_ = 0.0f; /* heading of the reference field (declination) */
+};
+
+/**
+ * @brief Skew-symmetric cross-product matrix: [v]× · w = v × w.
+ */
+[[nodiscard]] inline Mat3 skew(const Vec3 &v)
+{
+    Mat3 m;
+    m << 0.0f, -v.z(), v.y(), v.z(), 0.0f, -v.x(), -v.y(), v.x(), 0.0f;
+    return m;
+}
+
+}  // namespace acs::nav
@@ -0,0 +1,435 @@
+/*
+ * ACS4 Flight Computer — Navigation Thread
+ *
+ * Event-driven: ImuThread signals a binary semaphore after every push
+ * into SensorHub; NavThread drains all pending full-rate IMU samples,
+ * then all pending baro / mag samples, and publishes once per wakeup.
+ *
+ * Baro / mag freshness comes from NavThread's own SampleRing cursors
+ * rather than SensorHub::snapshot() flags, so a shell `sensors` call
+ * cannot swallow a measurement.
+ *
+ * Baro / mag are fused at their sample time: the nominal state after
+ * every predict goes into a StateHistory, and each measurement is fused
+ * against the state interpolated at its timestamp.
+ */
+
+#include "navigation/nav_thread.h"
+
+#include "navigation/alignment.h"
+#include "navigation/eskf.h"
+#include "navigation/preintegration.h"
+#include "navigation/state_history.h"
+#include "sensors/sensor_hub.h"
+#include "system/error_handler.h"
+#include "system/params.h"
+#include "system/watchdog.h"
+#include "utils/profiler.h"
+#include "utils/seqlock.h"
+#include "utils/timestamp.h"
+
+extern "C" {
+#include "ch.h"
+
+#include "hal.h"
+}
+
+namespace acs
+{
+
+/* Opublikowane rozwiazanie — czytelnicy z dowolnego watku */
+static SeqLatch<NavSolution> g_solution;
+
+bool nav_solution(NavSolution &out)
+{
+    return g_solution.read(out) != 0;
+}
+
+#if defined(STM32H725xx)
+
+using nav::Quat;
+using nav::Vec3;
+
+/* =====================================================================
+ * Stan watku
+ * ===================================================================== */
+
+static int g_prof_nav = -1;
+static int g_wdg_nav  = -1;
+
+static BSEMAPHORE_DECL(g_imu_ready, true);
+
+/* Surowe probki czytane z pierscienia na raz (ODR ≤ 8 kHz) */
+static constexpr size_t kNavBatchMax = 64;
+
+/* Brak sygnalu z ImuThread — budzimy sie i tak (watchdog 50 ms) */
+static constexpr uint32_t kNavWaitMs = 10;
+
+/* Dluzsza przerwa w strumieniu IMU → restart preintegracji */
+static constexpr uint32_t kImuGapUs = 20000;
+
+/* Parametry filtru odczytywane co ~1 s (param_get to strcmp po tabeli) */
+static constexpr uint32_t kConfigReloadSteps = 1000;
+
+/* Historia stanow: 128 krokow nav @ 1 kHz = 128 ms (baro ~20 ms opoznienia) */
+static constexpr size_t kStateHistory = 128;
+
+/* MMC5983MA w trybie ciaglym 100 Hz, odczyt co 10 ms: probka w rejestrze
+ * ma srednio pol okresu, a znacznik czasu to chwila odczytu */
+static constexpr uint32_t kMagAgeUs = 5000;
+
+static ImuReading  g_imu_batch[kNavBatchMax];
+static BaroReading g_baro_batch[kBaroHistory];
+static MagReading  g_mag_batch[kMagHistory];
+
+/* Filtr statycznie — P (15×15) nie miesci sie rozsadnie na stosie */
+static nav::Eskf                        g_eskf;
+static nav::ImuPreintegrator            g_preint;
+static nav::StateHistory<kStateHistory> g_history(TIMESTAMP_WRAP_US);
+
+struct NavContext
+{
+    NavMode      mode = NavMode::IDLE;
+    SampleCursor imu_cur;
+    SampleCursor baro_cur;
+    SampleCursor mag_cur;
+    uint32_t     imu_overruns    = 0;
+    uint32_t     last_ts_us      = 0;
+    bool         have_ts         = false;
+    uint8_t      imu_per_step    = 1; /* surowe probki na krok nav (= decymacja) */
+    uint32_t     steps_since_cfg = 0;
+    uint8_t      resets          = 0;
+    bool         baro_ref_set    = false;
+    Vec3         rate            = Vec3::Zero(); /* ω ostatniego kroku, bez biasu */
+
+    /* Akumulatory wyrownania (spoczynek) */
+    Vec3     sum_dtheta = Vec3::Zero();
+    Vec3     sum_dvel   = Vec3::Zero();
+    float    sum_dt     = 0.0f;
+    uint32_t align_n    = 0;
+    Vec3     sum_mag    = Vec3::Zero();
+    uint32_t mag_n      = 0;
+    float    sum_alt    = 0.0f;
+    uint32_t baro_n     = 0;
+
+    NavSolution last{};
+};
+
+static NavContext g_ctx;
+
+static THD_WORKING_AREA(waNavThread, 4096);
+
+/* =====================================================================
+ * Pomocnicze
+ * ===================================================================== */
+
+static nav::EskfConfig load_config()
+{
+    nav::EskfConfig cfg = nav::EskfConfig::rocket_default();
+    (void)param_get("nav.accel_noise", cfg.accel_noise);
+    (void)param_get("nav.gyro_noise", cfg.gyro_noise);
+    (void)param_get("nav.baro_noise", cfg.baro_noise_m);
+    (void)param_get("nav.mag_noise", cfg.mag_noise);
+    return cfg;
+}
+
+static void publish(uint32_t t_us)
+{
+    const nav::NavState &x = g_eskf.state();
+
+    NavSolution s{};
+    s.timestamp_us = t_us;
+    s.q            = {x.q.w(), x.q.x(), x.q.y(), x.q.z()};
+    s.vel_ned      = {x.v.x(), x.v.y(), x.v.z()};
+    s.pos_ned      = {x.p.x(), x.p.y(), x.p.z()};
+    s.gyro_bias    = {x.bg.x(), x.bg.y(), x.bg.z()};
+    s.accel_bias   = {x.ba.x(), x.ba.y(), x.ba.z()};
+    s.rate_body    = {g_ctx.rate.x(), g_ctx.rate.y(), g_ctx.rate.z()};
+    s.mode         = g_ctx.mode;
+    s.resets       = g_ctx.resets;
+
+    g_solution.write(s);
+    g_ctx.last = s;
+}
+
+/* Rozbieznosc: zglos i wystartuj od ostatniego opublikowanego stanu */
+static void restart_filter()
+{
+    error_report(ErrorCode::ESKF_DIVERGED);
+
+    const NavSolution &l = g_ctx.last;
+    const Quat         q(l.q[0], l.q[1], l.q[2], l.q[3]);
+    g_eskf.init(load_config(), q, Vec3(l.pos_ned[0], l.pos_ned[1], l.pos_ned[2]));
+
+    nav::NavState x = g_eskf.state();
+    x.v             = Vec3(l.vel_ned[0], l.vel_ned[1], l.vel_ned[2]);
+    x.bg            = Vec3(l.gyro_bias[0], l.gyro_bias[1], l.gyro_bias[2]);
+    x.ba            = Vec3(l.accel_bias[0], l.accel_bias[1], l.accel_bias[2]);
+    g_eskf.restore(x, g_eskf.covariance());
+
+    g_preint.reset();
+    g_history.clear();
+    if (g_ctx.resets < UINT8_MAX)
+    {
+        ++g_ctx.resets;
+    }
+}
+
+static void check(nav::EskfStatus st)
+{
+    if (st == nav::EskfStatus::DIVERGED)
+    {
+        restart_filter();
+    }
+}
+
+/* =====================================================================
+ * Wyrownanie na wyrzutni (TRIAD)
+ * ===================================================================== */
+
+static void begin_alignment()
+{
+    g_ctx.mode       = NavMode::ALIGNING;
+    g_ctx.sum_dtheta = Vec3::Zero();
+    g_ctx.sum_dvel   = Vec3::Zero();
+    g_ctx.sum_dt     = 0.0f;
+    g_ctx.align_n    = 0;
+    g_ctx.sum_mag    = Vec3::Zero();
+    g_ctx.mag_n      = 0;
+    g_ctx.sum_alt    = 0.0f;
+    g_ctx.baro_n     = 0;
+}
+
+static void finish_alignment(uint32_t t_us)
+{
+    const Vec3 mean_f   = g_ctx.sum_dvel / g_ctx.sum_dt;
+    const Vec3 mean_w   = g_ctx.sum_dtheta / g_ctx.sum_dt;
+    const Vec3 mean_mag = (g_ctx.mag_n > 0) ? Vec3(g_ctx.sum_mag / static_cast<float>(g_ctx.mag_n))
+                                            : Vec3::Zero();
+
+    Quat q;
+    if (!nav::triad_align(mean_f, mean_mag, q))
+    {
+        begin_alignment(); /* brak wektora g — probujemy od nowa */
+        return;
+    }
+
+    g_eskf.init(load_config(), q);
+
+    /* W spoczynku sredni zyroskop = bias */
+    nav::NavState x = g_eskf.state();
+    x.bg            = mean_w;
+    g_eskf.restore(x, g_eskf.covariance());
+
+    if (g_ctx.mag_n > 0)
+    {
+        g_eskf.set_mag_reference(nav::quat_to_dcm(q) * mean_mag);
+    }
+    g_ctx.baro_ref_set = (g_ctx.baro_n > 0);
+    if (g_ctx.baro_ref_set)
+    {
+        g_eskf.set_baro_reference(g_ctx.sum_alt / static_cast<float>(g_ctx.baro_n));
+    }
+
+    g_history.clear();
+    g_ctx.mode = NavMode::RUNNING;
+    publish(t_us);
+}
+
+/* =====================================================================
+ * Przetwarzanie probek
+ * ===================================================================== */
+
+/* Jedna surowa probka IMU; true gdy zakonczyl sie krok nav */
+static bool feed_imu(const ImuReading &r)
+{
+    const uint32_t gap = timestamp_elapsed_us(g_ctx.last_ts_us, r.timestamp_us);
+    if (!g_ctx.have_ts || gap > kImuGapUs)
+    {
+        g_ctx.have_ts    = true;
+        g_ctx.last_ts_us = r.timestamp_us;
+        g_preint.reset();
+        return false;
+    }
+    g_ctx.last_ts_us = r.timestamp_us;
+
+    g_preint.add(Vec3(r.gyro_rads[0], r.gyro_rads[1], r.gyro_rads[2]),
+                 Vec3(r.accel_mps2[0], r.accel_mps2[1], r.accel_mps2[2]),
+                 static_cast<float>(gap) * 1e-6f,
+                 r.timestamp_us);
+    if (g_preint.samples() < g_ctx.imu_per_step)
+    {
+        return false;
+    }
+
+    const nav::DeltaState d = g_preint.take();
+    if (g_ctx.mode == NavMode::ALIGNING)
+    {
+        g_ctx.sum_dtheta += d.dtheta;
+        g_ctx.sum_dvel += d.dvel;
+        g_ctx.sum_dt += d.dt;
+        ++g_ctx.align_n;
+    }
+    else
+    {
+        check(g_eskf.predict(d));
+        g_history.push(d.t_end_us, g_eskf.state());
+        if (d.dt > 0.0f)
+        {
+            g_ctx.rate = d.dtheta / d.dt - g_eskf.state().bg;
+        }
+    }
+    return true;
+}
+
+/* Chwila pomiaru mag = chwila odczytu - kMagAgeUs (modulo zawiniecie DWT) */
+static uint32_t mag_sample_time(uint32_t read_us)
+{
+    return (read_us >= kMagAgeUs) ? read_us - kMagAgeUs : read_us + (TIMESTAMP_WRAP_US - kMagAgeUs);
+}
+
+/* Pomiary starsze niz historia stanow sa pomijane (zbyt nieaktualne) */
+static void drain_aiding()
+{
+    nav::NavState past;
+
+    const size_t nb = sensor_hub().baro_history().read(g_ctx.baro_cur, g_baro_batch, kBaroHistory);
+    for (size_t i = 0; i < nb; ++i)
+    {
+        const float alt = g_baro_batch[i].altitude_m;
+        if (g_ctx.mode == NavMode::ALIGNING)
+        {
+            g_ctx.sum_alt += alt;
+            ++g_ctx.baro_n;
+        }
+        else if (!g_ctx.baro_ref_set)
+        {
+            g_eskf.set_baro_reference(alt);
+            g_ctx.baro_ref_set = true;
+        }
+        else if (g_history.at(g_baro_batch[i].timestamp_us, past))
+        {
+            check(g_eskf.update_baro(alt, past));
+        }
+    }
+
+    const size_t nm = sensor_hub().mag_history().read(g_ctx.mag_cur, g_mag_batch, kMagHistory);
+    for (size_t i = 0; i < nm; ++i)
+    {
+        const Vec3 m(g_mag_batch[i].mag_ut[0], g_mag_batch[i].mag_ut[1], g_mag_batch[i].mag_ut[2]);
+        if (g_ctx.mode == NavMode::ALIGNING)
+        {
+            g_ctx.sum_mag += m;
+            ++g_ctx.mag_n;
+        }
+        else if (g_history.at(mag_sample_time(g_mag_batch[i].timestamp_us), past))
+        {
+            check(g_eskf.update_mag(m, past));
+        }
+    }
+}
+
+/* =====================================================================
+ * NavThread
+ * ===================================================================== */
+
+static THD_FUNCTION(NavThread, arg)
+{
+    (void)arg;
+    chRegSetThreadName("nav");
+
+    g_prof_nav = profiler_register("nav");
+    g_wdg_nav  = watchdog_register("nav", 50);
+
+    SensorHub &hub     = sensor_hub();
+    g_ctx.imu_per_step = hub.imu_decimator().factor();
+    g_ctx.imu_cur      = hub.imu_history().subscribe();
+    g_ctx.baro_cur     = hub.baro_history().subscribe();
+    g_ctx.mag_cur      = hub.mag_history().subscribe();
+    begin_alignment();
+
+    while (true)
+    {
+        (void)chBSemWaitTimeout(&g_imu_ready, TIME_MS2I(kNavWaitMs));
+
+        PROFILE_BEGIN(g_prof_nav);
+
+        uint32_t steps     = 0;
+        uint32_t newest_us = 0;
+        size_t   n         = 0;
+        while ((n = hub.imu_history().read(g_ctx.imu_cur, g_imu_batch, kNavBatchMax)) > 0)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (feed_imu(g_imu_batch[i]))
+                {
+                    ++steps;
+                    newest_us = g_imu_batch[i].timestamp_us;
+                }
+            }
+        }
+
+        /* Pierscien nas wyprzedzil — probki IMU stracone */
+        if (g_ctx.imu_cur.overruns != g_ctx.imu_overruns)
+        {
+            g_ctx.imu_overruns = g_ctx.imu_cur.overruns;
+            profiler_miss(g_prof_nav);
+        }
+
+        drain_aiding();
+
+        if (g_ctx.mode == NavMode::ALIGNING && g_ctx.align_n >= kAlignSamples)
+        {
+            finish_alignment(newest_us);
+        }
+        else if (g_ctx.mode == NavMode::RUNNING && steps > 0)
+        {
+            publish(newest_us);
+            profiler_latency(
+                g_prof_nav, timestamp_elapsed_us(newest_us, timestamp_us()), kNavDeadlineUs);
+        }
+
+        g_ctx.steps_since_cfg += steps;
+        if (g_ctx.steps_since_cfg >= kConfigReloadSteps)
+        {
+            g_ctx.steps_since_cfg = 0;
+            g_eskf.set_config(load_config());
+        }
+
+        profiler_items(g_prof_nav, steps);
+        PROFILE_END(g_prof_nav);
+
+        if (g_wdg_nav >= 0)
+        {
+            watchdog_feed(g_wdg_nav);
+        }
+    }
+}
+
+/* =====================================================================
+ * Public API
+ * ===================================================================== */
+
+void nav_notify_imu()
+{
+    chBSemSignal(&g_imu_ready);
+}
+
+void start_nav_thread()
+{
+    chThdCreateStatic(waNavThread, sizeof(waNavThread), HIGHPRIO - 5, NavThread, nullptr);
+}
+
+#else /* NUCLEO_H723 — no on-board sensors */
+
+void nav_notify_imu()
+{
+}
+
+void start_nav_thread()
+{
+}
+
+#endif
+
+}  // namespace acs
@@ -0,0 +1,85 @@
+/*
+ * ACS4 Flight Computer — Navigation Thread
+ *
+ * NavThread (prio HIGHPRIO-5, 4 KB stack) is the consumer side of
+ * SensorHub. It does not sleep on a period: ImuThread signals it after
+ * every pushed batch (nav_notify_imu()), and it then
+ *
+ *   1. drains the full-rate IMU ring through the coning/sculling
+ *      preintegrator and runs one ESKF predict per 1 kHz nav step
+ *      (= per decimated sample),
+ *   2. applies new baro / mag samples at their own sample time, against
+ *      the nominal state looked up in a short StateHistory (~128 ms),
+ *   3. publishes a NavSolution through a SeqLatch.
+ *
+ * Before the filter runs, the first kAlignSamples nav steps are averaged
+ * at rest for TRIAD alignment, initial gyro bias and the baro datum.
+ *
+ * Profiler slot "nav": execution time per wakeup, nav steps per wakeup,
+ * latency from the newest consumed IMU sample timestamp to publication,
+ * and deadline misses (latency over kNavDeadlineUs, or IMU samples lost
+ * because the thread fell behind the ring).
+ *
+ * ESKF divergence is reported as ErrorCode::ESKF_DIVERGED; the filter is
+ * then restarted from the last published solution.
+ *
+ * This header has no RTOS dependencies; nav_solution() may be called
+ * from any thread.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace acs
+{
+
+enum class NavMode : uint8_t
+{
+    IDLE     = 0, /* thread not running / no IMU */
+    ALIGNING = 1, /* averaging at rest */
+    RUNNING  = 2,
+};
+
+/**
+ * @brief Published navigation state (NED, body = board frame).
+ */
+struct NavSolution
+{
+    uint32_t             timestamp_us; /* IMU sample time the state refers to */
+    std::array<float, 4> q;            /* body → NED, w x y z */
+    std::array<float, 3> vel_ned;      /* m/s */
+    std::array<float, 3> pos_ned;      /* m, relative to the pad */
+    std::array<float, 3> gyro_bias;    /* rad/s */
+    std::array<float, 3> accel_bias;   /* m/s² */
+    std::array<float, 3> rate_body;    /* bias-corrected body rate of the last step, rad/s */
+    NavMode              mode;
+    uint8_t              resets; /* filter restarts after divergence */
+};
+
+/* Latency budget: sample timestamp → publication */
+inline constexpr uint32_t kNavDeadlineUs = 2000;
+
+/* Nav steps (1 kHz) averaged for launch-pad alignment */
+inline constexpr uint32_t kAlignSamples = 500;
+
+/**
+ * @brief Start NavThread. Called from start_sensor_threads().
+ */
+void start_nav_thread();
+
+/**
+ * @brief Wake NavThread — new IMU samples are in SensorHub.
+ *
+ * Called by ImuThread after each update_imu() / update_imu_batch().
+ */
+void nav_notify_imu();
+
+/**
+ * @brief Latest published solution.
+ * @return false until the first publication.
+ */
+bool nav_solution(NavSolution &out);
+
+}  // namespace acs
@@ -0,0 +1,81 @@
+/**
+ * @file preintegration.cpp
+ * @brief Coning / sculling compensated IMU preintegration — implementation.
+ */
+
+#include "navigation/preintegration.h"
+
+namespace acs::nav
+{
+
+void ImuPreintegrator::reset()
+{
+    alpha_.setZero();
+    upsilon_.setZero();
+    beta_.setZero();
+    scul_.setZero();
+    prev_dalpha_.setZero();
+    prev_dups_.setZero();
+    dt_       = 0.0f;
+    samples_  = 0;
+    t_end_us_ = 0;
+}
+
+void ImuPreintegrator::add(const Vec3 &gyro_rads, const Vec3 &accel_mps2, float dt, uint32_t t_us)
+{
+    if (!(dt > 0.0f))
+    {
+        return;
+    }
+
+    const Vec3 dalpha = gyro_rads * dt;
+    const Vec3 dups   = accel_mps2 * dt;
+
+    /* Pierwsza probka w przedziale: α = υ = 0, zostaje tylko czlon ⅙ z
+     * poprzedniego przyrostu (po reset() rowny zero). */
+    const Vec3 alpha_ref = alpha_ + prev_dalpha_ * (1.0f / 6.0f);
+    const Vec3 ups_ref   = upsilon_ + prev_dups_ * (1.0f / 6.0f);
+
+    beta_ += 0.5f * alpha_ref.cross(dalpha);
+    scul_ += 0.5f * (alpha_ref.cross(dups) + ups_ref.cross(dalpha));
+
+    alpha_ += dalpha;
+    upsilon_ += dups;
+    prev_dalpha_ = dalpha;
+    prev_dups_   = dups;
+
+    dt_ += dt;
+    ++samples_;
+    t_end_us_ = t_us;
+}
+
+DeltaState ImuPreintegrator::peek() const
+{
+    DeltaState d;
+    d.dtheta   = alpha_ + beta_;
+    d.dvel     = upsilon_ + 0.5f * alpha_.cross(upsilon_) + scul_;
+    d.dt       = dt_;
+    d.samples  = samples_;
+    d.t_end_us = t_end_us_;
+    return d;
+}
+
+DeltaState ImuPreintegrator::take()
+{
+    const DeltaState d = peek();
+
+    /* Δα_{i-1}, Δυ_{i-1} przechodza przez granice przedzialu (czlon ⅙) */
+    const Vec3 keep_dalpha = prev_dalpha_;
+    const Vec3 keep_dups   = prev_dups_;
+    reset();
+    prev_dalpha_ = keep_dalpha;
+    prev_dups_   = keep_dups;
+    return d;
+}
+
+Quat apply_delta_angle(const Quat &q, const Vec3 &dtheta)
+{
+    return quat_normalize(q * quat_from_rotation_vector(dtheta));
+}
+
+}  // namespace acs::nav
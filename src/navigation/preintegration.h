@@ -0,0 +1,114 @@
+/**
+ * @file preintegration.h
+ * @brief Coning / sculling compensated IMU preintegration.
+ *
+ * Accumulates the high-rate IMU stream (1–8 kHz) into one delta-angle and
+ * one delta-velocity per navigation step, so the strapdown update can run
+ * at 100–250 Hz without losing the non-commutativity terms a single
+ * rectangular ω·dt step would drop:
+ *
+ *   α      = Σ Δα_i                                  (plain angle sum)
+ *   β     += ½ (α_{i-1} + ⅙ Δα_{i-1}) × Δα_i         (coning, Savage 2-sample)
+ *   Δθ     = α + β
+ *
+ *   υ      = Σ Δυ_i                                  (plain velocity sum)
+ *   δυ_scl+= ½ [(α_{i-1} + ⅙ Δα_{i-1}) × Δυ_i
+ *             + (υ_{i-1} + ⅙ Δυ_{i-1}) × Δα_i]       (sculling)
+ *   δυ_rot = ½ α × υ                                 (rotation compensation)
+ *   Δv     = υ + δυ_rot + δυ_scl
+ *
+ * Δθ and Δv are expressed in the body frame at the start of the interval:
+ *   q_end = q_start ⊗ exp(Δθ)
+ *   v_end = v_start + C(q_start)·Δv + g·Δt
+ *
+ * Inputs are rate samples (rad/s, m/s²) that represent the mean over their
+ * sample interval — which is what the IMU FIR/boxcar decimation delivers.
+ *
+ * Thread safety: instances are not shared; one per consumer thread.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "navigation/quaternion.h"
+
+namespace acs::nav
+{
+
+/**
+ * @brief Result of one preintegration interval.
+ */
+struct DeltaState
+{
+    Vec3     dtheta;   /* coning-corrected delta-angle, body frame [rad] */
+    Vec3     dvel;     /* sculling-corrected delta-velocity, body frame [m/s] */
+    float    dt;       /* interval length [s] */
+    uint32_t samples;  /* IMU samples accumulated */
+    uint32_t t_end_us; /* timestamp of the last sample */
+};
+
+class ImuPreintegrator
+{
+  public:
+    ImuPreintegrator()
+    {
+        reset();
+    }
+
+    /**
+     * @brief Start a new interval (drops accumulated state).
+     */
+    void reset();
+
+    /**
+     * @brief Accumulate one IMU sample.
+     *
+     * @param gyro_rads   Mean angular rate over the sample interval [rad/s].
+     * @param accel_mps2  Mean specific force over the sample interval [m/s²].
+     * @param dt          Sample interval [s]; ignored if ≤ 0.
+     * @param t_us        Sample timestamp (kept as the interval end time).
+     */
+    void add(const Vec3 &gyro_rads, const Vec3 &accel_mps2, float dt, uint32_t t_us);
+
+    /**
+     * @brief Current accumulated deltas (interval continues).
+     */
+    [[nodiscard]] DeltaState peek() const;
+
+    /**
+     * @brief Return accumulated deltas and start a new interval.
+     *
+     * The last increment is kept for the next interval's ⅙ correction
+     * term; use reset() after a data gap.
+     */
+    DeltaState take();
+
+    [[nodiscard]] uint32_t samples() const
+    {
+        return samples_;
+    }
+
+    [[nodiscard]] float elapsed_s() const
+    {
+        return dt_;
+    }
+
+  private:
+    Vec3     alpha_;       /* Σ Δα */
+    Vec3     upsilon_;     /* Σ Δυ */
+    Vec3     beta_;        /* coning correction */
+    Vec3     scul_;        /* sculling correction */
+    Vec3     prev_dalpha_; /* Δα_{i-1} */
+    Vec3     prev_dups_;   /* Δυ_{i-1} */
+    float    dt_;
+    uint32_t samples_;
+    uint32_t t_end_us_;
+};
+
+/**
+ * @brief Apply a preintegrated attitude increment: q ⊗ exp(Δθ), normalized.
+ */
+[[nodiscard]] Quat apply_delta_angle(const Quat &q, const Vec3 &dtheta);
+
+}  // namespace acs::nav
@@ -0,0 +1,183 @@
+/**
+ * @file state_history.h
+ * @brief Ring of past nominal nav states keyed by IMU timestamp.
+ *
+ * Baro and mag samples reach the filter tens of milliseconds after the
+ * instant they describe (MS5611: ~1.5 conversions between the pressure
+ * midpoint and publication; MMC5983MA: up to one 100 Hz period in the
+ * data register; plus poll → nav latency). NavThread pushes the nominal
+ * state after every predict; a delayed measurement looks up the state at
+ * its own timestamp and is fused against that (see Eskf::update_baro /
+ * update_mag with an `at` state), instead of against the present.
+ *
+ * Lookup is a binary search over entry age relative to the newest entry,
+ * followed by linear (v, p, biases) / slerp (q) interpolation between the
+ * two neighbours. Ages are computed modulo the timestamp wrap period, so
+ * the DWT-based µs clock (wraps every ~7.8 s) works as well as a plain
+ * 32-bit one.
+ *
+ * Thread safety: none — owned by NavThread.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "navigation/eskf.h"
+
+namespace acs::nav
+{
+
+template <size_t Capacity>
+class StateHistory
+{
+    static_assert(Capacity >= 2, "StateHistory needs at least two entries");
+
+  public:
+    /**
+     * @param wrap_us  Timestamp period (0 = natural 2³² wrap).
+     */
+    explicit StateHistory(uint32_t wrap_us = 0) : wrap_us_(wrap_us) {}
+
+    void clear()
+    {
+        count_ = 0;
+    }
+
+    /**
+     * @brief Append the state valid at @p t_us (must not go backwards).
+     */
+    void push(uint32_t t_us, const NavState &x)
+    {
+        head_           = (head_ + 1) % Capacity;
+        entries_[head_] = {t_us, x};
+        if (count_ < Capacity)
+        {
+            ++count_;
+        }
+    }
+
+    /**
+     * @brief Nominal state at @p t_us.
+     *
+     * Times newer than the newest entry return the newest entry.
+     *
+     * @return false if empty or @p t_us is older than the oldest entry.
+     */
+    bool at(uint32_t t_us, NavState &out) const
+    {
+        if (count_ == 0)
+        {
+            return false;
+        }
+
+        const uint32_t newest = entries_[head_].t_us;
+        const uint32_t age    = elapsed(t_us, newest);
+        if (age == 0 || age > half_period())
+        {
+            out = entries_[head_].x; /* rowne lub "z przyszlosci" */
+            return true;
+        }
+        if (age > age_of(count_ - 1))
+        {
+            return false;
+        }
+
+        /* Wiek maleje z indeksem (0 = najstarszy): pierwszy wpis nie starszy
+         * niz zapytanie to sasiad "b", poprzedni to "a" */
+        size_t lo = 0;
+        size_t hi = count_ - 1;
+        while (lo < hi)
+        {
+            const size_t mid = (lo + hi) / 2;
+            if (age_of_index(mid) <= age)
+            {
+                hi = mid;
+            }
+            else
+            {
+                lo = mid + 1;
+            }
+        }
+
+        const Entry   &b     = entry(lo);
+        const uint32_t age_b = age_of_index(lo);
+        if (age_b == age || lo == 0)
+        {
+            out = b.x;
+            return true;
+        }
+        const Entry   &a     = entry(lo - 1);
+        const uint32_t age_a = age_of_index(lo - 1);
+        const float    frac  = static_cast<float>(age_a - age) / static_cast<float>(age_a - age_b);
+
+        out.q  = a.x.q.slerp(frac, b.x.q);
+        out.v  = a.x.v + frac * (b.x.v - a.x.v);
+        out.p  = a.x.p + frac * (b.x.p - a.x.p);
+        out.bg = a.x.bg + frac * (b.x.bg - a.x.bg);
+        out.ba = a.x.ba + frac * (b.x.ba - a.x.ba);
+        return true;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return count_;
+    }
+
+    [[nodiscard]] uint32_t newest_us() const
+    {
+        return entries_[head_].t_us;
+    }
+
+    /** Time span covered [µs]. */
+    [[nodiscard]] uint32_t span_us() const
+    {
+        return (count_ == 0) ? 0 : age_of(count_ - 1);
+    }
+
+  private:
+    struct Entry
+    {
+        uint32_t t_us;
+        NavState x;
+    };
+
+    uint32_t elapsed(uint32_t from, uint32_t to) const
+    {
+        if (wrap_us_ == 0)
+        {
+            return to - from;
+        }
+        return (to >= from) ? to - from : to + (wrap_us_ - from);
+    }
+
+    uint32_t half_period() const
+    {
+        return (wrap_us_ == 0) ? 0x80000000U : wrap_us_ / 2U;
+    }
+
+    /* i = 0 najstarszy, count_-1 najnowszy */
+    const Entry &entry(size_t i) const
+    {
+        return entries_[(head_ + Capacity - (count_ - 1 - i)) % Capacity];
+    }
+
+    uint32_t age_of_index(size_t i) const
+    {
+        return elapsed(entry(i).t_us, entries_[head_].t_us);
+    }
+
+    /* Wiek k-tego wpisu od najnowszego (k = 0 najnowszy) */
+    uint32_t age_of(size_t k) const
+    {
+        return age_of_index(count_ - 1 - k);
+    }
+
+    Entry    entries_[Capacity];
+    size_t   head_  = Capacity - 1;
+    size_t   count_ = 0;
+    uint32_t wrap_us_;
+};
+
+}  // namespace acs::nav
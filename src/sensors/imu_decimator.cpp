@@ -0,0 +1,228 @@
+/*
+ * ACS4 Flight Computer — IMU Decimating Anti-Alias Filter (Implementation)
+ */
+
+#include "sensors/imu_decimator.h"
+
+#include <cmath>
+
+namespace acs
+{
+
+/* =====================================================================
+ * Projekt filtra
+ * ===================================================================== */
+
+void design_lowpass(float *taps, size_t n_taps, float cutoff)
+{
+    if (taps == nullptr || n_taps == 0)
+    {
+        return;
+    }
+    if (n_taps == 1)
+    {
+        taps[0] = 1.0f;
+        return;
+    }
+
+    constexpr double kPi    = 3.14159265358979323846;
+    const double     center = static_cast<double>(n_taps - 1) * 0.5;
+    double           sum    = 0.0;
+
+    for (size_t i = 0; i < n_taps; ++i)
+    {
+        const double t    = static_cast<double>(i) - center;
+        const double sinc = (t == 0.0) ? 2.0 * cutoff
+                                       : std::sin(2.0 * kPi * cutoff * t) / (kPi * t);
+        const double win  = 0.54 - 0.46 * std::cos(2.0 * kPi * static_cast<double>(i) /
+                                                   static_cast<double>(n_taps - 1));
+        const double h    = sinc * win;
+        taps[i]           = static_cast<float>(h);
+        sum += h;
+    }
+
+    /* Wzmocnienie DC = 1 */
+    for (size_t i = 0; i < n_taps; ++i)
+    {
+        taps[i] = static_cast<float>(static_cast<double>(taps[i]) / sum);
+    }
+}
+
+/* =====================================================================
+ * Konfiguracja
+ * ===================================================================== */
+
+bool ImuDecimator::configure(uint8_t factor, DecimatorKind kind, uint32_t wrap_us)
+{
+    if (factor == 0 || factor > kDecimMaxFactor)
+    {
+        return false;
+    }
+
+    kind_    = kind;
+    factor_  = factor;
+    wrap_us_ = wrap_us;
+
+    if (factor == 1)
+    {
+        n_taps_ = 1; /* passthrough niezaleznie od rodzaju */
+    }
+    else if (kind == DecimatorKind::FIR)
+    {
+        n_taps_ = kTapsPerPhase * factor;
+        design_lowpass(taps_, n_taps_, 0.4f / static_cast<float>(factor));
+    }
+    else
+    {
+        n_taps_ = factor;
+    }
+
+    reset();
+    return true;
+}
+
+void ImuDecimator::reset()
+{
+    phase_    = 0;
+    pos_      = 0;
+    primed_   = false;
+    first_ts_ = 0;
+    for (auto &a : acc_)
+    {
+        a = 0.0f;
+    }
+}
+
+/* =====================================================================
+ * Przetwarzanie
+ * ===================================================================== */
+
+void ImuDecimator::load(const ImuReading &in, float (&x)[kChannels])
+{
+    x[0] = in.accel_mps2[0];
+    x[1] = in.accel_mps2[1];
+    x[2] = in.accel_mps2[2];
+    x[3] = in.gyro_rads[0];
+    x[4] = in.gyro_rads[1];
+    x[5] = in.gyro_rads[2];
+}
+
+void ImuDecimator::store(const float (&y)[kChannels], ImuReading &out)
+{
+    out.accel_mps2 = {y[0], y[1], y[2]};
+    out.gyro_rads  = {y[3], y[4], y[5]};
+}
+
+/* Srodek przedzialu [from, to] na zegarze o okresie wrap_us_ */
+uint32_t ImuDecimator::midpoint(uint32_t from, uint32_t to) const
+{
+    if (wrap_us_ == 0)
+    {
+        return from + (to - from) / 2;
+    }
+    const uint32_t dt = (to >= from) ? to - from : to + (wrap_us_ - from);
+    const uint32_t t  = from + dt / 2;
+    return (t >= wrap_us_) ? t - wrap_us_ : t;
+}
+
+bool ImuDecimator::push(const ImuReading &in, ImuReading &out)
+{
+    if (factor_ == 1)
+    {
+        out = in;
+        return true;
+    }
+
+    return (kind_ == DecimatorKind::FIR) ? push_fir(in, out) : push_boxcar(in, out);
+}
+
+bool ImuDecimator::push_boxcar(const ImuReading &in, ImuReading &out)
+{
+    float x[kChannels];
+    load(in, x);
+
+    if (phase_ == 0)
+    {
+        first_ts_ = in.timestamp_us;
+    }
+    for (size_t c = 0; c < kChannels; ++c)
+    {
+        acc_[c] += x[c];
+    }
+
+    if (++phase_ < factor_)
+    {
+        return false;
+    }
+
+    /* Integrate-and-dump: srednia z R probek, czas = srodek okna */
+    const float inv = 1.0f / static_cast<float>(factor_);
+    float       y[kChannels];
+    for (size_t c = 0; c < kChannels; ++c)
+    {
+        y[c]    = acc_[c] * inv;
+        acc_[c] = 0.0f;
+    }
+    store(y, out);
+    out.temp_c       = in.temp_c;
+    out.timestamp_us = midpoint(first_ts_, in.timestamp_us);
+    phase_           = 0;
+    return true;
+}
+
+bool ImuDecimator::push_fir(const ImuReading &in, ImuReading &out)
+{
+    float x[kChannels];
+    load(in, x);
+
+    /* Pierwsza probka wypelnia cala historie — brak stanu przejsciowego od zera */
+    if (!primed_)
+    {
+        for (size_t k = 0; k < n_taps_; ++k)
+        {
+            for (size_t c = 0; c < kChannels; ++c)
+            {
+                hist_[k][c] = x[c];
+            }
+            ts_hist_[k] = in.timestamp_us;
+        }
+        primed_ = true;
+    }
+
+    pos_ = (pos_ + 1 == n_taps_) ? 0 : pos_ + 1;
+    for (size_t c = 0; c < kChannels; ++c)
+    {
+        hist_[pos_][c] = x[c];
+    }
+    ts_hist_[pos_] = in.timestamp_us;
+
+    if (++phase_ < factor_)
+    {
+        return false;
+    }
+    phase_ = 0;
+
+    /* Splot tylko w chwilach wyjsciowych (polifazowo): y = sum h[k] * x[n-k] */
+    float  y[kChannels] = {};
+    size_t idx          = pos_;
+    for (size_t k = 0; k < n_taps_; ++k)
+    {
+        const float h = taps_[k];
+        for (size_t c = 0; c < kChannels; ++c)
+        {
+            y[c] += h * hist_[idx][c];
+        }
+        idx = (idx == 0) ? n_taps_ - 1 : idx - 1;
+    }
+    store(y, out);
+    out.temp_c = in.temp_c;
+
+    /* Opoznienie grupowe (L-1)/2 — L parzyste, wiec srodek dwoch probek */
+    const size_t half = n_taps_ / 2;
+    const size_t a    = (pos_ + n_taps_ - (half - 1)) % n_taps_;
+    const size_t b    = (pos_ + n_taps_ - half) % n_taps_;
+    out.timestamp_us  = midpoint(ts_hist_[b], ts_hist_[a]);
+    return true;
+}
+
+}  // namespace acs
@@ -0,0 +1,136 @@
+/*
+ * ACS4 Flight Computer — IMU Decimating Anti-Alias Filter
+ *
+ * Turns an oversampled IMU stream (2/4/8 kHz FIFO ODR) into the 1 kHz
+ * stream consumed by navigation, while the full-rate samples stay
+ * available in SensorHub for coning/sculling compensation.
+ *
+ * Two kernels, selectable at runtime:
+ *   BOXCAR — first-order CIC (integrate-and-dump, R-sample mean).
+ *            One add per sample; preserves the integral of ω and a over
+ *            each output interval exactly, but only ~13 dB alias rejection.
+ *   FIR    — Hamming-windowed sinc, kTapsPerPhase × R taps, cutoff at
+ *            0.4 × output rate. Polyphase evaluation: taps are only
+ *            applied at output instants, i.e. L/R MACs per input sample.
+ *
+ * Output timestamps are shifted by the kernel group delay, so they refer
+ * to the instant the filtered value actually represents. They are taken
+ * modulo the timestamp period given to configure(), so a window across
+ * the DWT µs clock wrap (~7.8 s) still yields a timestamp on that clock.
+ *
+ * No RTOS or hardware dependencies — safe for unit tests on host.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "sensors/sensor_types.h"
+
+namespace acs
+{
+
+enum class DecimatorKind : uint8_t
+{
+    BOXCAR = 0,
+    FIR    = 1,
+};
+
+inline constexpr uint8_t kDecimMaxFactor = 8;
+inline constexpr size_t  kTapsPerPhase   = 6;
+inline constexpr size_t  kDecimMaxTaps   = kTapsPerPhase * kDecimMaxFactor;
+
+/**
+ * @brief Design a unity-DC-gain Hamming-windowed sinc low-pass.
+ *
+ * @param[out] taps    Output coefficients (n_taps).
+ * @param      n_taps  Filter length (≥ 1).
+ * @param      cutoff  -6 dB cutoff as a fraction of the input rate (0, 0.5).
+ */
+void design_lowpass(float *taps, size_t n_taps, float cutoff);
+
+class ImuDecimator
+{
+  public:
+    /** Number of filtered channels: accel XYZ + gyro XYZ. */
+    static constexpr size_t kChannels = 6;
+
+    ImuDecimator()
+    {
+        (void)configure(1, DecimatorKind::BOXCAR);
+    }
+
+    /**
+     * @brief Select decimation factor and kernel. Resets filter state.
+     *
+     * @param factor   1..kDecimMaxFactor (1 = passthrough).
+     * @param wrap_us  Timestamp period (0 = natural 2³² wrap).
+     * @return false (state unchanged) if factor is out of range.
+     */
+    [[nodiscard]] bool configure(uint8_t factor, DecimatorKind kind, uint32_t wrap_us = 0);
+
+    /**
+     * @brief Clear history; the next sample re-primes the filter.
+     */
+    void reset();
+
+    /**
+     * @brief Feed one full-rate sample.
+     *
+     * @param[out] out  Decimated sample, valid only when true is returned.
+     * @return true once every `factor` inputs.
+     */
+    bool push(const ImuReading &in, ImuReading &out);
+
+    [[nodiscard]] uint8_t factor() const
+    {
+        return factor_;
+    }
+
+    [[nodiscard]] DecimatorKind kind() const
+    {
+        return kind_;
+    }
+
+    [[nodiscard]] size_t taps() const
+    {
+        return n_taps_;
+    }
+
+    /**
+     * @brief Group delay of the active kernel in input samples.
+     */
+    [[nodiscard]] float group_delay_samples() const
+    {
+        return static_cast<float>(n_taps_ - 1) * 0.5f;
+    }
+
+  private:
+    bool push_boxcar(const ImuReading &in, ImuReading &out);
+    bool push_fir(const ImuReading &in, ImuReading &out);
+
+    [[nodiscard]] uint32_t midpoint(uint32_t from, uint32_t to) const;
+
+    static void load(const ImuReading &in, float (&x)[kChannels]);
+    static void store(const float (&y)[kChannels], ImuReading &out);
+
+    DecimatorKind kind_    = DecimatorKind::BOXCAR;
+    uint8_t       factor_  = 1;
+    uint8_t       phase_   = 0;
+    size_t        n_taps_  = 1;
+    bool          primed_  = false;
+    uint32_t      wrap_us_ = 0; /* 0 = 2^32 */
+
+    /* FIR: coefficients + circular history (newest at pos_) */
+    float    taps_[kDecimMaxTaps]{};
+    float    hist_[kDecimMaxTaps][kChannels]{};
+    uint32_t ts_hist_[kDecimMaxTaps]{};
+    size_t   pos_ = 0;
+
+    /* BOXCAR: running sums over the current output interval */
+    float    acc_[kChannels]{};
+    uint32_t first_ts_ = 0;
+};
+
+}  // namespace acs
@@ -1,13 +1,12 @@
 /*
  * ACS4 Flight Computer — Sensor Hub Implementation
+ *
+ * No RTOS calls: publication goes through SeqLatch, so this file also
+ * builds on host for unit tests.
  */
 
 #include "sensors/sensor_hub.h"
 
-extern "C" {
-#include "ch.h"
-}
-
 namespace acs
 {
 
@@ -36,27 +35,77 @@ SensorHub &sensor_hub()
  *     board_z = +sensor_z
  */
 
+static ImuReading imu_to_board(const std::array<float, 3> &accel_mps2,
+                               const std::array<float, 3> &gyro_rads,
+                               float                       temp_c,
+                               uint32_t                    timestamp_us)
+{
+    ImuReading r;
+#ifdef ACS4_LAYOUT_JEDRZEJ
+    r.accel_mps2[0] = +accel_mps2[1];
+    r.accel_mps2[1] = -accel_mps2[0];
+    r.accel_mps2[2] = +accel_mps2[2];
+    r.gyro_rads[0]  = +gyro_rads[1];
+    r.gyro_rads[1]  = -gyro_rads[0];
+    r.gyro_rads[2]  = +gyro_rads[2];
+#else
+    r.accel_mps2 = accel_mps2;
+    r.gyro_rads  = gyro_rads;
+#endif
+    r.temp_c       = temp_c;
+    r.timestamp_us = timestamp_us;
+    return r;
+}
+
 void SensorHub::update_imu(const std::array<float, 3> &accel_mps2,
                            const std::array<float, 3> &gyro_rads,
                            float                       temp_c,
                            uint32_t                    timestamp_us)
 {
-    chSysLock();
-#ifdef ACS4_LAYOUT_JEDRZEJ
-    data_.accel_mps2[0] = +accel_mps2[1];
-    data_.accel_mps2[1] = -accel_mps2[0];
-    data_.accel_mps2[2] = +accel_mps2[2];
-    data_.gyro_rads[0]  = +gyro_rads[1];
-    data_.gyro_rads[1]  = -gyro_rads[0];
-    data_.gyro_rads[2]  = +gyro_rads[2];
-#else
-    data_.accel_mps2 = accel_mps2;
-    data_.gyro_rads  = gyro_rads;
-#endif
-    data_.imu_temp_c       = temp_c;
-    data_.imu_timestamp_us = timestamp_us;
-    data_.imu_valid        = true;
-    chSysUnlock();
+    const ImuReading r = imu_to_board(accel_mps2, gyro_rads, temp_c, timestamp_us);
+    imu_ring_.push(r);
+
+    ImuReading dec;
+    if (decimator_.push(r, dec))
+    {
+        imu_nav_ring_.push(dec);
+        imu_.write(dec);
+    }
+}
+
+/* Batch z FIFO: kazda probka do historii i decymatora, latch tylko z najnowszym wyjsciem */
+
+void SensorHub::update_imu_batch(const ImuReading *sensor_frame, size_t count)
+{
+    if (sensor_frame == nullptr || count == 0)
+    {
+        return;
+    }
+
+    ImuReading newest{};
+    bool       have_output = false;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const ImuReading &in = sensor_frame[i];
+        const ImuReading  r = imu_to_board(in.accel_mps2, in.gyro_rads, in.temp_c, in.timestamp_us);
+        imu_ring_.push(r);
+
+        if (decimator_.push(r, newest))
+        {
+            imu_nav_ring_.push(newest);
+            have_output = true;
+        }
+    }
+
+    if (have_output)
+    {
+        imu_.write(newest);
+    }
+}
+
+bool SensorHub::configure_imu_decimation(uint8_t factor, DecimatorKind kind, uint32_t wrap_us)
+{
+    return decimator_.configure(factor, kind, wrap_us);
 }
 
 /* Barometr */
@@ -66,14 +115,13 @@ void SensorHub::update_baro(float    pressure_pa,
                             float    altitude_m,
                             uint32_t timestamp_us)
 {
-    chSysLock();
-    data_.pressure_pa       = pressure_pa;
-    data_.baro_temp_c       = temperature_c;
-    data_.altitude_m        = altitude_m;
-    data_.baro_timestamp_us = timestamp_us;
-    data_.baro_valid        = true;
-    data_.baro_fresh        = true;
-    chSysUnlock();
+    BaroReading r;
+    r.pressure_pa  = pressure_pa;
+    r.temp_c       = temperature_c;
+    r.altitude_m   = altitude_m;
+    r.timestamp_us = timestamp_us;
+    baro_.write(r);
+    baro_ring_.push(r);
 }
 
 /* Magnetometr (sensor frame → board frame)
@@ -99,33 +147,53 @@ void SensorHub::update_baro(float    pressure_pa,
 void SensorHub::update_mag(const std::array<float, 3> &mag_raw_ut,
                            uint32_t                    timestamp_us)
 {
-    chSysLock();
+    MagReading r;
 #ifdef ACS4_LAYOUT_JEDRZEJ
-    data_.mag_ut[0] = -mag_raw_ut[1];
-    data_.mag_ut[1] = +mag_raw_ut[0];
-    data_.mag_ut[2] = -mag_raw_ut[2];
+    r.mag_ut[0] = -mag_raw_ut[1];
+    r.mag_ut[1] = +mag_raw_ut[0];
+    r.mag_ut[2] = -mag_raw_ut[2];
 #else
-    data_.mag_ut[0] = +mag_raw_ut[1];
-    data_.mag_ut[1] = -mag_raw_ut[0];
-    data_.mag_ut[2] = -mag_raw_ut[2];
+    r.mag_ut[0] = +mag_raw_ut[1];
+    r.mag_ut[1] = -mag_raw_ut[0];
+    r.mag_ut[2] = -mag_raw_ut[2];
 #endif
-    data_.mag_timestamp_us  = timestamp_us;
-    data_.mag_valid         = true;
-    data_.mag_fresh         = true;
-    chSysUnlock();
+    r.timestamp_us = timestamp_us;
+    mag_.write(r);
+    mag_ring_.push(r);
 }
 
-/* Atomiczny snapshot (consumer side) */
+/* Snapshot (consumer side) — kazda sekcja czytana osobno, bez blokady.
+ * Sekwencja 0 = jeszcze nic nie opublikowano. */
 
 SensorSnapshot SensorHub::snapshot()
 {
     SensorSnapshot copy{};
 
-    chSysLock();
-    copy             = data_;
-    data_.baro_fresh = false;
-    data_.mag_fresh  = false;
-    chSysUnlock();
+    ImuReading     imu;
+    const uint32_t imu_seq = imu_.read(imu);
+    copy.imu_timestamp_us  = imu.timestamp_us;
+    copy.accel_mps2        = imu.accel_mps2;
+    copy.gyro_rads         = imu.gyro_rads;
+    copy.imu_temp_c        = imu.temp_c;
+    copy.imu_valid         = imu_seq != 0;
+
+    BaroReading    baro;
+    const uint32_t baro_seq  = baro_.read(baro);
+    const uint32_t baro_prev = baro_seen_seq_.exchange(baro_seq, std::memory_order_relaxed);
+    copy.baro_timestamp_us   = baro.timestamp_us;
+    copy.pressure_pa         = baro.pressure_pa;
+    copy.baro_temp_c         = baro.temp_c;
+    copy.altitude_m          = baro.altitude_m;
+    copy.baro_valid          = baro_seq != 0;
+    copy.baro_fresh          = baro_seq != baro_prev;
+
+    MagReading     mag;
+    const uint32_t mag_seq  = mag_.read(mag);
+    const uint32_t mag_prev = mag_seen_seq_.exchange(mag_seq, std::memory_order_relaxed);
+    copy.mag_timestamp_us   = mag.timestamp_us;
+    copy.mag_ut             = mag.mag_ut;
+    copy.mag_valid          = mag_seq != 0;
+    copy.mag_fresh          = mag_seq != mag_prev;
 
     return copy;
 }
@@ -11,14 +11,30 @@
  *   Z+ = up
  *
  * Producer: the thread(s) that call update_imu / update_baro / update_mag.
- * Consumer: NavThread (or any reader) calls snapshot() to get an atomic copy.
+ * Consumers: NavThread reads the history rings below; any other reader
+ * (shell, FSM) calls snapshot() to get an atomic copy.
+ *
+ * Each sensor is published through its own SeqLatch section, so writers
+ * never block each other and neither side masks interrupts: a reader that
+ * overlaps a write simply retries its copy of that one section.
+ *
+ * Besides the latest value, every sample is also appended to a per-sensor
+ * SampleRing history. Consumers that must see every sample (nav, logger,
+ * FSM, shell) subscribe their own cursor and batch-read from the ring.
  */
 
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 
+#include "sensors/imu_decimator.h"
+#include "sensors/sensor_types.h"
+#include "utils/sample_ring.h"
+#include "utils/seqlock.h"
+
 namespace acs
 {
 
@@ -28,7 +44,7 @@ namespace acs
 
 struct SensorSnapshot
 {
-    /* IMU (IIM-42653, up to 1 kHz) — board frame */
+    /* IMU (IIM-42653, decimated 1 kHz stream) — board frame */
     uint32_t             imu_timestamp_us; /* host µs of the most recent IMU sample */
     std::array<float, 3> accel_mps2;       /* m/s² */
     std::array<float, 3> gyro_rads;        /* rad/s */
@@ -50,6 +66,24 @@ struct SensorSnapshot
     bool                 mag_fresh;
 };
 
+/* =====================================================================
+ * Sample history depth (power of two)
+ *   IMU raw  512 @ ODR (≤ 8 kHz) → ≥ 64 ms
+ *   IMU nav  256 @ 1 kHz          → 256 ms
+ *   baro      16 @ ~100 Hz        → 160 ms
+ *   mag       32 @ 100 Hz         → 320 ms
+ * ===================================================================== */
+
+inline constexpr size_t kImuHistory    = 512;
+inline constexpr size_t kImuNavHistory = 256;
+inline constexpr size_t kBaroHistory   = 16;
+inline constexpr size_t kMagHistory    = 32;
+
+using ImuRing    = SampleRing<ImuReading, kImuHistory>;
+using ImuNavRing = SampleRing<ImuReading, kImuNavHistory>;
+using BaroRing   = SampleRing<BaroReading, kBaroHistory>;
+using MagRing    = SampleRing<MagReading, kMagHistory>;
+
 /* =====================================================================
  * SensorHub
  * ===================================================================== */
@@ -72,13 +106,48 @@ class SensorHub
      *   - ACS4_LAYOUT_JEDRZEJ: board_x = +sensor_y, board_y = -sensor_x,
      *                          board_z = +sensor_z
      *
-     * Called from ImuThread at up to 1 kHz.
+     * The sample goes to imu_history() at full rate and through the
+     * decimator into imu_nav_history() and the latest-value section.
+     *
+     * Called from ImuThread (register mode, 1 kHz).
      */
     void update_imu(const std::array<float, 3> &accel_mps2,
                     const std::array<float, 3> &gyro_rads,
                     float                       temp_c,
                     uint32_t                    timestamp_us);
 
+    /**
+     * @brief Store a batch of IMU samples (e.g. one drained FIFO burst).
+     *
+     * Samples are in sensor-native frame, oldest first. Every sample is
+     * rotated and appended to imu_history() and fed to the decimator; the
+     * latest-value section is published once, with the newest decimated
+     * output.
+     *
+     * Called from ImuThread in FIFO mode.
+     */
+    void update_imu_batch(const ImuReading *sensor_frame, size_t count);
+
+    /**
+     * @brief Select the IMU decimation stage (ODR → 1 kHz nav stream).
+     *
+     * @param factor   IMU ODR / 1 kHz (1 = passthrough).
+     * @param wrap_us  Period of the sample timestamps (TIMESTAMP_WRAP_US on
+     *                 target; 0 = natural 2³² wrap).
+     * @return false if factor is out of range (previous setting kept).
+     *
+     * @note Decimator state belongs to the IMU writer — call before
+     *       start_sensor_threads(), not concurrently with update_imu*().
+     */
+    [[nodiscard]] bool configure_imu_decimation(uint8_t       factor,
+                                                DecimatorKind kind,
+                                                uint32_t      wrap_us = 0);
+
+    [[nodiscard]] const ImuDecimator &imu_decimator() const
+    {
+        return decimator_;
+    }
+
     /**
      * @brief Store a new barometer sample.
      *
@@ -105,18 +174,57 @@ class SensorHub
                     uint32_t                    timestamp_us);
 
     /**
-     * @brief Get an atomic copy of the current sensor state.
+     * @brief Get a consistent copy of the current sensor state.
+     *
+     * Each section (IMU / baro / mag) is internally consistent; sections
+     * are read one after another, so they may come from different update
+     * cycles — exactly as with separate per-sensor timestamps.
      *
-     * baro_fresh / mag_fresh are set true only once per new sample and
-     * are cleared after this call returns.
+     * baro_fresh / mag_fresh are true only when a new sample was published
+     * since the previous snapshot() call.
      *
      * @note Only one consumer should rely on the _fresh flags; a second
-     *       caller would always see them as false.
+     *       caller would always see them as false. Consumers that need
+     *       every sample should use the *_history() rings instead.
      */
     SensorSnapshot snapshot();
 
+    /**
+     * @brief Per-sensor sample history (board frame).
+     *
+     * imu_history() holds every sample at the IMU ODR (for coning /
+     * sculling); imu_nav_history() holds the decimated 1 kHz stream that
+     * the snapshot's IMU section also reflects.
+     *
+     * Usage (one cursor per consumer, kept by the consumer):
+     * @code
+     *   SampleCursor cur = sensor_hub().imu_history().subscribe();
+     *   ...
+     *   ImuReading batch[16];
+     *   size_t n = sensor_hub().imu_history().read(cur, batch, 16);
+     * @endcode
+     */
+    const ImuRing    &imu_history() const { return imu_ring_; }
+    const ImuNavRing &imu_nav_history() const { return imu_nav_ring_; }
+    const BaroRing   &baro_history() const { return baro_ring_; }
+    const MagRing    &mag_history() const { return mag_ring_; }
+
   private:
-    SensorSnapshot data_{};
+    SeqLatch<ImuReading>  imu_;
+    SeqLatch<BaroReading> baro_;
+    SeqLatch<MagReading>  mag_;
+
+    ImuRing    imu_ring_;
+    ImuNavRing imu_nav_ring_;
+    BaroRing   baro_ring_;
+    MagRing    mag_ring_;
+
+    ImuDecimator decimator_;
+
+    /* Last sequence seen by snapshot() — drives the _fresh flags.
+     * Atomic only so that extra (non-fresh-aware) readers are race-free. */
+    std::atomic<uint32_t> baro_seen_seq_{0};
+    std::atomic<uint32_t> mag_seen_seq_{0};
 };
 
 /**
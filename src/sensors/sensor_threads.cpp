@@ -1,14 +1,21 @@
 /*
  * ACS4 Flight Computer — Sensor Acquisition Threads
  *
- * ImuThread (1 kHz, prio 255):
- *   Reads IIM-42653 via DRDY wait (PAL_USE_WAIT) or 1 ms polling.
- *   Pushes accel+gyro+temp into SensorHub.
+ * ImuThread (1–8 kHz ODR, prio 255):
+ *   Register mode: reads IIM-42653 via DRDY wait (PAL_USE_WAIT) or 1 ms
+ *   polling, one sample per wakeup.
+ *   FIFO mode: wakes on the FIFO watermark (param imu.fifo_wm packets),
+ *   drains the whole FIFO in one bulk SPI transaction and pushes the batch
+ *   (sensor-reconstructed timestamps) into SensorHub in one call. The hub
+ *   decimates the oversampled stream to 1 kHz for navigation.
  *
  * SensorPollThread (100 Hz, prio 180):
  *   Ticks MS5611 state machine (50 Hz output at OSR 4096).
  *   Reads MMC5983MA in continuous mode (100 Hz).
  *   Pushes baro+mag into SensorHub.
+ *
+ * NavThread (navigation/nav_thread.cpp) is started from here too and
+ * woken by ImuThread after every IMU push.
  */
 
 #include "sensors/sensor_threads.h"
@@ -16,7 +23,9 @@
 #include "drivers/iim42653.h"
 #include "drivers/mmc5983ma.h"
 #include "drivers/ms5611.h"
+#include "navigation/nav_thread.h"
 #include "sensors/sensor_hub.h"
+#include "system/params.h"
 #include "system/watchdog.h"
 #include "utils/profiler.h"
 
@@ -32,14 +41,69 @@ namespace acs
 {
 
 /* =====================================================================
- * ImuThread — 1 kHz IMU acquisition
+ * ImuThread — IMU acquisition (register or FIFO batch mode)
  * ===================================================================== */
 
 static int g_prof_imu = -1;
 static int g_wdg_imu  = -1;
 
+/* Max packets drained per wakeup — the whole hardware FIFO (130 × 16 B). */
+static constexpr size_t kImuBatchMax = 130;
+
+/* Upper bound on the INT1 wait so the 50 ms IMU watchdog never trips */
+static constexpr uint32_t kImuMaxWaitMs = 20;
+
+/* Bufory batcha statycznie — nie na stosie watku (2 KB WA) */
+static ImuSample  g_imu_batch[kImuBatchMax];
+static ImuReading g_imu_readings[kImuBatchMax];
+
 static THD_WORKING_AREA(waImuThread, 2048);
 
+/* Odczyt progu FIFO z parametru (uchwyt z param_bind — bez skanu tabeli
+ * co wybudzenie); zwraca aktualny (po ewentualnej zmianie) */
+static uint16_t apply_fifo_watermark(Iim42653 *imu, const ParamRef &fifo_wm)
+{
+    if (fifo_wm.valid())
+    {
+        const auto packets = static_cast<uint16_t>(fifo_wm.get() + 0.5f);
+        if (packets != imu->fifo_watermark())
+        {
+            (void)imu->set_fifo_watermark(packets);
+        }
+    }
+    return imu->fifo_watermark();
+}
+
+static void imu_poll_register(Iim42653 *imu)
+{
+    ImuSample sample{};
+    if (imu->read(sample))
+    {
+        sensor_hub().update_imu(
+            sample.accel_mps2, sample.gyro_rads, sample.temp_degc, sample.timestamp_us);
+        nav_notify_imu();
+        profiler_items(g_prof_imu, 1);
+    }
+}
+
+static void imu_poll_fifo(Iim42653 *imu)
+{
+    const size_t n = imu->read_fifo(g_imu_batch, kImuBatchMax);
+    for (size_t i = 0; i < n; ++i)
+    {
+        g_imu_readings[i].timestamp_us = g_imu_batch[i].timestamp_us;
+        g_imu_readings[i].accel_mps2   = g_imu_batch[i].accel_mps2;
+        g_imu_readings[i].gyro_rads    = g_imu_batch[i].gyro_rads;
+        g_imu_readings[i].temp_c       = g_imu_batch[i].temp_degc;
+    }
+    if (n > 0)
+    {
+        sensor_hub().update_imu_batch(g_imu_readings, n);
+        nav_notify_imu();
+    }
+    profiler_items(g_prof_imu, static_cast<uint32_t>(n));
+}
+
 static THD_FUNCTION(ImuThread, arg)
 {
     (void)arg;
@@ -54,6 +118,11 @@ static THD_FUNCTION(ImuThread, arg)
         return;
     }
 
+    const ParamRef fifo_wm   = param_bind("imu.fifo_wm");
+    const bool     fifo_mode = imu->fifo_enabled();
+    const uint32_t odr_hz    = imu->odr_hz();
+    uint16_t       watermark = fifo_mode ? apply_fifo_watermark(imu, fifo_wm) : 1;
+
 #if PAL_USE_WAIT == TRUE
     palSetLineMode(LINE_IMU_INT1, PAL_MODE_INPUT);
     palEnableLineEvent(LINE_IMU_INT1, PAL_EVENT_MODE_RISING_EDGE); // NOLINT(cppcoreguidelines-avoid-do-while)
@@ -63,23 +132,37 @@ static THD_FUNCTION(ImuThread, arg)
 
     while (true)
     {
+        /* Timeout / okres pollingu skaluje sie z progiem i ODR */
+        const uint32_t batch_us = (static_cast<uint32_t>(watermark) * 1000000U) / odr_hz;
 #if PAL_USE_WAIT == TRUE
-        palWaitLineTimeout(LINE_IMU_INT1, TIME_MS2I(5));
+        uint32_t wait_ms = batch_us / 1000U + 4U;
+        if (wait_ms > kImuMaxWaitMs)
+        {
+            wait_ms = kImuMaxWaitMs;
+        }
+        palWaitLineTimeout(LINE_IMU_INT1, TIME_MS2I(wait_ms));
 #else
-        next += TIME_MS2I(1);
+        next += TIME_US2I(batch_us);
 #endif
 
         PROFILE_BEGIN(g_prof_imu);
 
-        ImuSample sample{};
-        if (imu->read(sample))
+        if (fifo_mode)
+        {
+            imu_poll_fifo(imu);
+        }
+        else
         {
-            sensor_hub().update_imu(
-                sample.accel_mps2, sample.gyro_rads, sample.temp_degc, sample.timestamp_us);
+            imu_poll_register(imu);
         }
 
         PROFILE_END(g_prof_imu);
 
+        if (fifo_mode)
+        {
+            watermark = apply_fifo_watermark(imu, fifo_wm);
+        }
+
         if (g_wdg_imu >= 0)
         {
             watchdog_feed(g_wdg_imu);
@@ -155,6 +238,9 @@ static THD_FUNCTION(SensorPollThread, arg)
 
 void start_sensor_threads()
 {
+    /* Konsument przed producentem — subskrybuje pierscienie od poczatku */
+    start_nav_thread();
+
     chThdCreateStatic(waImuThread, sizeof(waImuThread), HIGHPRIO, ImuThread, nullptr);
 
     chThdCreateStatic(
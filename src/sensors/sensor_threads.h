@@ -6,15 +6,20 @@
  *
  * Threads created (custom PCB only — Nucleo has no on-board sensors):
  *
- *   ImuThread        prio 255 (HIGHEST)    1 kHz   2 KB stack
+ *   ImuThread        prio 255 (HIGHEST)    1–8 kHz ODR   2 KB stack
  *     Reads IIM-42653 accel+gyro, pushes to SensorHub.
- *     Triggered by DRDY interrupt (PAL_USE_WAIT) or 1 ms polling fallback.
+ *     FIFO mode: woken by the watermark interrupt, drains the FIFO in one
+ *     bulk read. Register mode: DRDY interrupt or 1 ms polling fallback.
  *
  *   SensorPollThread prio 180 (ABOVE_NORM) 100 Hz  2 KB stack
  *     Drives MS5611 state machine (50 Hz output at OSR 4096).
  *     Reads MMC5983MA magnetometer (100 Hz continuous mode).
  *     Pushes baro + mag data to SensorHub.
  *
+ *   NavThread        prio 250 (HIGHPRIO-5) event-driven    4 KB stack
+ *     Woken by ImuThread; ESKF predict per 1 kHz nav step, baro / mag
+ *     updates, publishes NavSolution (see navigation/nav_thread.h).
+ *
  * Call start_sensor_threads() once from main() after all drivers are
  * initialized. On Nucleo builds this is a no-op.
  */
@@ -0,0 +1,42 @@
+/*
+ * ACS4 Flight Computer — Sensor Sample Types
+ *
+ * Plain board-frame sample records shared by SensorHub, its history rings
+ * and the platform-independent filters that operate on them.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace acs
+{
+
+/* =====================================================================
+ * Per-sensor sections (board frame, published independently)
+ * ===================================================================== */
+
+struct ImuReading
+{
+    uint32_t             timestamp_us;
+    std::array<float, 3> accel_mps2;
+    std::array<float, 3> gyro_rads;
+    float                temp_c;
+};
+
+struct BaroReading
+{
+    uint32_t timestamp_us;
+    float    pressure_pa;
+    float    temp_c;
+    float    altitude_m;
+};
+
+struct MagReading
+{
+    uint32_t             timestamp_us;
+    std::array<float, 3> mag_ut;
+};
+
+}  // namespace acs
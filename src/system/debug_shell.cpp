@@ -23,6 +23,7 @@ extern "C" {
 }
 
 #include "actuators/actuator_hub.h"
+#include "actuators/actuator_threads.h"
 #include "drivers/iim42653.h"
 #include "drivers/mmc5983ma.h"
 #include "drivers/ms5611.h"
@@ -358,9 +359,10 @@ static void cmd_servo_status(BaseSequentialStream *chp)
     const bool                  armed = bank->is_armed();
 
     chprintf(chp,
-             "Servo bank: %s (req=%s)\r\n",
+             "Servo bank: %s (req=%s), CCR update: %s\r\n",
              armed ? "ARMED" : "DISARMED",
-             snap.armed_request ? "arm" : "disarm");
+             snap.armed_request ? "arm" : "disarm",
+             bank->burst_dma() ? "DMA burst" : "CPU");
     chprintf(chp, "%-4s %-10s %-10s %-10s %-6s %s\r\n",
              "fin", "cmd_deg", "target_us", "current_us", "ch", "sweep");
     for (uint8_t i = 0; i < acs::kAileronCount; ++i)
@@ -399,6 +401,7 @@ static void cmd_servo_set(BaseSequentialStream *chp, int argc, char *argv[])
     }
 
     acs::actuator_hub().set_aileron_deg(fin, deg, acs::timestamp_us());
+    acs::actuator_notify();
     chprintf(chp, "fin %u: cmd %.2f deg\r\n", static_cast<unsigned>(fin + 1), static_cast<double>(deg));
 }
 
@@ -485,13 +488,44 @@ static void cmd_servo_sweep(BaseSequentialStream *chp, int argc, char *argv[])
              period_ms);
 }
 
+static void cmd_servo_latency(BaseSequentialStream *chp, int argc, char *argv[])
+{
+    auto *bank = acs::servo_bank_instance();
+    if (bank == nullptr)
+    {
+        chprintf(chp, "SERVOS not available\r\n");
+        return;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "reset") == 0)
+    {
+        bank->reset_latency_stats();
+        chprintf(chp, "Servo latency stats reset.\r\n");
+        return;
+    }
+
+    const acs::ServoLatencyStats st = bank->latency_stats();
+    if (st.count == 0)
+    {
+        chprintf(chp, "No commands latched yet (bank must be armed).\r\n");
+        return;
+    }
+    chprintf(chp,
+             "cmd -> PWM frame: last %lu us, avg %lu us, max %lu us (%lu samples)\r\n",
+             static_cast<unsigned long>(st.last_us),
+             static_cast<unsigned long>(st.total_us / st.count),
+             static_cast<unsigned long>(st.max_us),
+             static_cast<unsigned long>(st.count));
+}
+
 static void cmd_servo(BaseSequentialStream *chp, int argc, char *argv[])
 {
     if (argc == 0)
     {
         chprintf(chp,
                  "Usage: servo status | arm | disarm | set <fin> <deg> | "
-                 "us <fin> <us> | sweep <fin> <min> <max> <period_ms>\r\n");
+                 "us <fin> <us> | sweep <fin> <min> <max> <period_ms> | "
+                 "latency [reset]\r\n");
         return;
     }
 
@@ -521,6 +555,10 @@ static void cmd_servo(BaseSequentialStream *chp, int argc, char *argv[])
     {
         cmd_servo_sweep(chp, argc, argv);
     }
+    else if (strcmp(argv[0], "latency") == 0)
+    {
+        cmd_servo_latency(chp, argc, argv);
+    }
     else
     {
         chprintf(chp, "Unknown servo subcommand: %s\r\n", argv[0]);
@@ -564,7 +602,7 @@ static void cmd_log(BaseSequentialStream *chp, int argc, char *argv[])
 {
     if (argc == 0)
     {
-        chprintf(chp, "Usage: log start | stop | status\r\n");
+        chprintf(chp, "Usage: log start | stop | status | dump [last_ms] | profile [name]\r\n");
         return;
     }
 
@@ -601,9 +639,57 @@ static void cmd_log(BaseSequentialStream *chp, int argc, char *argv[])
         acs::logger_print_status(chp);
         acs::ram_log_print_status(chp);
     }
+    else if (strcmp(argv[0], "dump") == 0)
+    {
+        long last_ms = 0; /* 0 = caly RAM log */
+        if (argc > 1)
+        {
+            char *endptr = nullptr;
+            last_ms      = strtol(argv[1], &endptr, 10);
+            if (endptr == argv[1] || last_ms < 1 ||
+                last_ms > static_cast<long>(acs::LOGGER_DUMP_MAX_MS))
+            {
+                chprintf(chp, "Invalid window: %s (expected 1..%lu ms; none = whole RAM log)\r\n",
+                         argv[1], acs::LOGGER_DUMP_MAX_MS);
+                return;
+            }
+        }
+        acs::logger_request_dump(static_cast<uint32_t>(last_ms));
+        chprintf(chp, "RAM log dump requested (PRE_NNN.BIN)\r\n");
+    }
+    else if (strcmp(argv[0], "profile") == 0)
+    {
+        acs::LogProfileId id = acs::logger_profile();
+        if (argc > 1 && !acs::log_profile_find(argv[1], id))
+        {
+            chprintf(chp, "Unknown profile: %s (expected full, pad or descent)\r\n", argv[1]);
+            return;
+        }
+        acs::logger_set_profile(id);
+
+        /* Tabela aktywnego profilu: 1 z N rekordow na typ */
+        const acs::LogProfile &p = acs::log_profile(id);
+        chprintf(chp, "Profile: %s\r\n", p.name);
+        for (const acs::LogMsgDesc &m : acs::LOG_SCHEMA)
+        {
+            const auto id8 = static_cast<uint8_t>(m.id);
+            if (id8 >= acs::LOG_PROFILE_TYPES || p.every[id8] == 1)
+            {
+                continue;
+            }
+            if (p.every[id8] == 0)
+            {
+                chprintf(chp, "  %-10s off\r\n", m.name);
+            }
+            else
+            {
+                chprintf(chp, "  %-10s 1 in %u\r\n", m.name, p.every[id8]);
+            }
+        }
+    }
     else
     {
-        chprintf(chp, "Usage: log start | stop | status\r\n");
+        chprintf(chp, "Usage: log start | stop | status | dump [last_ms] | profile [name]\r\n");
     }
 }
 
@@ -640,11 +726,48 @@ static void cmd_sd_ls(BaseSequentialStream *chp)
     f_closedir(&dir);
 }
 
+/* Kwalifikacja karty: ta sama sciezka zapisu co logger */
+static void cmd_sd_bench(BaseSequentialStream *chp, int argc, char *argv[])
+{
+    long mib = 16;
+    if (argc > 1)
+    {
+        char *endptr = nullptr;
+        mib          = strtol(argv[1], &endptr, 10);
+        if (endptr == argv[1] || mib < 1 || mib > 1024)
+        {
+            chprintf(chp, "Invalid size: %s (expected 1..1024 MiB)\r\n", argv[1]);
+            return;
+        }
+    }
+
+    chprintf(chp, "Writing %ld MiB to BENCH.BIN...\r\n", mib);
+    acs::LoggerBench b{};
+    const bool ok = acs::logger_bench(static_cast<uint32_t>(mib), b);
+    if (b.bytes == 0)
+    {
+        chprintf(chp, "Bench FAILED (card not mounted, logging active or file error)\r\n");
+        return;
+    }
+
+    const auto kibps =
+        (b.busy_us > 0) ? static_cast<uint32_t>(uint64_t{b.bytes} * 1000000U / 1024U / b.busy_us)
+                        : 0U;
+    chprintf(chp, "Mode:           %s\r\n", b.contiguous ? "contiguous (raw sectors)" : "FatFs");
+    chprintf(chp, "Written:        %lu B in %lu ms, %lu KiB/s sustained\r\n", b.bytes,
+             b.elapsed_ms, kibps);
+    acs::logger_print_latency(chp, b.hist);
+    if (!ok)
+    {
+        chprintf(chp, "Write errors:   %lu\r\n", b.errors);
+    }
+}
+
 static void cmd_sd(BaseSequentialStream *chp, int argc, char *argv[])
 {
     if (argc == 0)
     {
-        chprintf(chp, "Usage: sd status | mount | unmount | ls\r\n");
+        chprintf(chp, "Usage: sd status | mount | unmount | ls | bench [MiB]\r\n");
         return;
     }
 
@@ -684,9 +807,13 @@ static void cmd_sd(BaseSequentialStream *chp, int argc, char *argv[])
     {
         cmd_sd_ls(chp);
     }
+    else if (strcmp(argv[0], "bench") == 0)
+    {
+        cmd_sd_bench(chp, argc, argv);
+    }
     else
     {
-        chprintf(chp, "Usage: sd status | mount | unmount | ls\r\n");
+        chprintf(chp, "Usage: sd status | mount | unmount | ls | bench [MiB]\r\n");
     }
 }
 
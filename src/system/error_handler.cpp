@@ -26,6 +26,8 @@ struct ErrorEntry
 
 static ErrorEntry s_errors[static_cast<int>(ErrorCode::COUNT)] = {};
 
+static CriticalErrorHook s_critical_hook = nullptr;
+
 /* Name lookup */
 
 // clang-format off
@@ -87,9 +89,23 @@ void error_report(ErrorCode code)
     }
 
     chSysLock();
-    s_errors[idx].count++;
+    const bool              first = (s_errors[idx].count++ == 0);
+    const CriticalErrorHook hook  = s_critical_hook;
     s_errors[idx].last_ms = static_cast<uint32_t>(chTimeI2MS(chVTGetSystemTimeX()));
     chSysUnlock();
+
+    /* Tylko pierwsze wystapienie — powtarzajacy sie blad nie zalewa hooka */
+    if (first && hook != nullptr && is_critical(code))
+    {
+        hook(code);
+    }
+}
+
+void error_set_critical_hook(CriticalErrorHook hook)
+{
+    chSysLock();
+    s_critical_hook = hook;
+    chSysUnlock();
 }
 
 uint32_t error_count(ErrorCode code)
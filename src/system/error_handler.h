@@ -67,6 +67,17 @@ void error_report(ErrorCode code);
  */
 [[nodiscard]] const char *error_name(ErrorCode code);
 
+/**
+ * @brief Called on the first occurrence of each critical error, in the
+ *        reporting thread after the counter update. Must not block.
+ */
+using CriticalErrorHook = void (*)(ErrorCode code);
+
+/**
+ * @brief Install the critical-error hook (one; nullptr removes it).
+ */
+void error_set_critical_hook(CriticalErrorHook hook);
+
 /**
  * @brief Clear all error counters.
  */
@@ -35,9 +35,38 @@ static ParamEntry s_params[] = {
     {"ctrl.ki_yaw",             0.0f,   0.0f,   0.0f,   10.0f},
     {"ctrl.kd_yaw",             0.1f,   0.1f,   0.0f,   10.0f},
 
+    /* Control: enable (0/1, fins follow the law only when armed + 1),
+     * integrator cap per axis [deg of fin] */
+    {"ctrl.enable",             0.0f,   0.0f,   0.0f,   1.0f},
+    {"ctrl.i_limit",            5.0f,   5.0f,   0.0f,   15.0f},
+
+    /* IMU acquisition: ODR = decim × 1 kHz (1/2/4/8, boot-time),
+     * fifo_wm = FIFO packets per INT1 wakeup */
+    {"imu.decim",               4.0f,   4.0f,   1.0f,   8.0f},
+    {"imu.fifo_wm",             16.0f,  16.0f,  1.0f,   120.0f},
+
     /* Navigation / EKF */
     {"nav.accel_noise",         0.5f,   0.5f,   0.001f, 10.0f},
     {"nav.gyro_noise",          0.01f,  0.01f,  0.0001f, 1.0f},
+    {"nav.baro_noise",          0.5f,   0.5f,   0.01f,  20.0f},
+    {"nav.mag_noise",           0.05f,  0.05f,  0.001f, 1.0f},
+
+    /* Logging: IMU source 0 = 1 kHz nav stream, 1 = full ODR */
+    {"log.imu_raw",             0.0f,   0.0f,   0.0f,   1.0f},
+
+    /* Logging: contiguous preallocation per file [MiB] (0 = plain f_write),
+     * FatFs metadata sync period [ms] (f_write mode only) */
+    {"log.prealloc_mb",         128.0f, 128.0f, 0.0f,   2048.0f},
+    {"log.sync_ms",             1000.0f, 1000.0f, 100.0f, 10000.0f},
+
+    /* Logging: RAM capture while IDLE, dumped to PRE_NNN.BIN on logger
+     * start / first critical error (0/1) */
+    {"log.pretrig",             1.0f,   1.0f,   0.0f,   1.0f},
+
+    /* Logging: continue in the next LOG_NNN.BIN after this size [MiB] /
+     * duration [s] (0 = off) */
+    {"log.rotate_mb",           64.0f,  64.0f,  0.0f,   2048.0f},
+    {"log.rotate_s",            0.0f,   0.0f,   0.0f,   3600.0f},
 
     /* FSM thresholds */
     {"fsm.liftoff_accel_g",     3.0f,   3.0f,   1.5f,   20.0f},
@@ -64,6 +93,11 @@ static ParamEntry *find_param(const char *name)
 
 /* Public API */
 
+ParamRef param_bind(const char *name)
+{
+    return ParamRef(find_param(name));
+}
+
 bool param_get(const char *name, float &out)
 {
     const ParamEntry *p = find_param(name);
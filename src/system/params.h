@@ -28,6 +28,49 @@ struct ParamEntry
     float       max;
 };
 
+/**
+ * @brief Bound handle to one parameter — hot-path read without lookup.
+ *
+ * Obtained once via param_bind(); get() is a single 32-bit load (atomic
+ * on Cortex-M7; param_set() writes under chSysLock), so control loops
+ * see shell changes on the next tick without a strcmp scan.
+ */
+class ParamRef
+{
+  public:
+    constexpr ParamRef() = default;
+    explicit constexpr ParamRef(const ParamEntry *entry)
+        : value_((entry != nullptr) ? &entry->value : nullptr)
+    {
+    }
+
+    [[nodiscard]] bool valid() const
+    {
+        return value_ != nullptr;
+    }
+
+    /** Current value; must be valid(). */
+    [[nodiscard]] float get() const
+    {
+        return *value_;
+    }
+
+    /** Current value, or @p fallback if the name was not found. */
+    [[nodiscard]] float get_or(float fallback) const
+    {
+        return (value_ != nullptr) ? *value_ : fallback;
+    }
+
+  private:
+    const volatile float *value_ = nullptr;
+};
+
+/**
+ * @brief Bind a parameter by name (one strcmp scan, call at thread start).
+ * @return Handle; !valid() if the name is unknown.
+ */
+[[nodiscard]] ParamRef param_bind(const char *name);
+
 /**
  * @brief Get a parameter value by name.
  * @return true if found.
@@ -0,0 +1,63 @@
+/*
+ * ACS4 Flight Computer — CRC-32
+ *
+ * IEEE 802.3 CRC-32 (reflected 0xEDB88320, init and final XOR 0xFFFFFFFF)
+ * — the zlib / Python zlib.crc32() variant, so host tools check it with
+ * the standard library. Byte-wise with a 1 KiB table built at compile
+ * time: ~8 KiB log frame in ~100 µs on the M7, far below one SD write.
+ *
+ * No RTOS or hardware dependencies — safe for unit tests on host.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace acs
+{
+
+namespace crc32_detail
+{
+
+constexpr std::array<uint32_t, 256> make_table()
+{
+    std::array<uint32_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k)
+        {
+            c = (c & 1U) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+        }
+        t[i] = c;
+    }
+    return t;
+}
+
+inline constexpr std::array<uint32_t, 256> TABLE = make_table();
+
+}  // namespace crc32_detail
+
+/**
+ * @brief Continue a CRC over more data: crc32(a + b) ==
+ *        crc32_update(crc32(a), b). Start from 0.
+ */
+inline uint32_t crc32_update(uint32_t crc, const void *data, size_t len)
+{
+    const auto *p = static_cast<const uint8_t *>(data);
+    crc           = ~crc;
+    for (size_t i = 0; i < len; ++i)
+    {
+        crc = crc32_detail::TABLE[(crc ^ p[i]) & 0xFFU] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+inline uint32_t crc32(const void *data, size_t len)
+{
+    return crc32_update(0, data, len);
+}
+
+}  // namespace acs
@@ -0,0 +1,124 @@
+/*
+ * ACS4 Flight Computer — Log2-Bucketed Latency Histogram
+ *
+ * Fixed-size histogram for latencies spanning several decades (an SD
+ * write takes 200 µs on a good day and 300 ms during card garbage
+ * collection). Bucket 0 counts zero, bucket k counts [2^(k-1), 2^k); the
+ * last bucket also takes everything above. add() is a CLZ and an
+ * increment — cheap enough for every flush.
+ *
+ * Not thread-safe: one writer; readers copy the object when the writer
+ * is idle (or accept a torn snapshot for display).
+ *
+ * No RTOS or hardware dependencies — safe for unit tests on host.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace acs
+{
+
+template <size_t Buckets>
+class Log2Histogram
+{
+    static_assert(Buckets >= 2 && Buckets <= 33, "Log2Histogram: 2..33 buckets");
+
+  public:
+    static constexpr size_t kBuckets = Buckets;
+
+    /** Bucket index for value v. */
+    static constexpr size_t bucket_of(uint32_t v)
+    {
+        const size_t k = (v == 0) ? 0 : static_cast<size_t>(32 - __builtin_clz(v));
+        return (k < Buckets) ? k : Buckets - 1;
+    }
+
+    /** Smallest value counted in bucket k. */
+    static constexpr uint32_t bucket_lo(size_t k)
+    {
+        return (k == 0) ? 0 : (uint32_t{1} << (k - 1));
+    }
+
+    /** Largest value counted in bucket k (UINT32_MAX for the last one). */
+    static constexpr uint32_t bucket_hi(size_t k)
+    {
+        return (k + 1 >= Buckets || k >= 32) ? UINT32_MAX : (uint32_t{1} << k) - 1;
+    }
+
+    void add(uint32_t v)
+    {
+        ++counts_[bucket_of(v)];
+        ++total_;
+        if (v > max_)
+        {
+            max_ = v;
+        }
+    }
+
+    void reset()
+    {
+        counts_ = {};
+        total_  = 0;
+        max_    = 0;
+    }
+
+    [[nodiscard]] uint32_t count(size_t k) const
+    {
+        return counts_[k];
+    }
+
+    [[nodiscard]] uint32_t total() const
+    {
+        return total_;
+    }
+
+    [[nodiscard]] uint32_t max() const
+    {
+        return max_;
+    }
+
+    /**
+     * @brief Upper bound of the bucket holding the p-quantile (0 < p ≤ 1).
+     *
+     * Conservative: the true quantile is at most this (and never above
+     * max()). 0 if empty.
+     */
+    [[nodiscard]] uint32_t quantile_upper(float p) const
+    {
+        if (total_ == 0)
+        {
+            return 0;
+        }
+
+        /* ceil(p · total), co najmniej 1 */
+        auto rank = static_cast<uint32_t>(p * static_cast<float>(total_));
+        if (static_cast<float>(rank) < p * static_cast<float>(total_))
+        {
+            ++rank;
+        }
+        rank = (rank == 0) ? 1 : ((rank > total_) ? total_ : rank);
+
+        uint32_t seen = 0;
+        for (size_t k = 0; k < Buckets; ++k)
+        {
+            seen += counts_[k];
+            if (seen >= rank)
+            {
+                const uint32_t hi = bucket_hi(k);
+                return (hi < max_) ? hi : max_;
+            }
+        }
+        return max_;
+    }
+
+  private:
+    std::array<uint32_t, Buckets> counts_{};
+    uint32_t                      total_ = 0;
+    uint32_t                      max_   = 0;
+};
+
+}  // namespace acs
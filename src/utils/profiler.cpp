@@ -10,12 +10,17 @@
 #include "utils/timestamp.h"
 
 extern "C" {
+#include "ch.h"
+
 #include <chprintf.h>
 }
 
 namespace acs
 {
 
+/* Poczatek okna pomiarowego dla Rate(Hz) — boot albo ostatni reset */
+static systime_t s_epoch = 0;
+
 int profiler_register(const char *name)
 {
     int &n = profiler_slot_count();
@@ -30,6 +35,12 @@ int profiler_register(const char *name)
     s.max_cycles   = 0;
     s.total_cycles = 0;
     s.count        = 0;
+    s.items        = 0;
+    s.lat_last_us  = 0;
+    s.lat_max_us   = 0;
+    s.lat_total_us = 0;
+    s.lat_count    = 0;
+    s.misses       = 0;
     return id;
 }
 
@@ -42,29 +53,47 @@ void profiler_print(BaseSequentialStream *chp)
         return;
     }
 
+    const uint32_t elapsed_ms = TIME_I2MS(chVTTimeElapsedSinceX(s_epoch));
+    const float    elapsed_s  = (elapsed_ms > 0) ? static_cast<float>(elapsed_ms) * 1e-3f : 1.0f;
+
     chprintf(chp,
-             "%-24s %10s %10s %10s %10s\r\n",
+             "%-24s %10s %10s %10s %10s %9s %7s %8s %8s %6s\r\n",
              "Slot",
              "Last(us)",
              "Avg(us)",
              "Max(us)",
-             "Count");
+             "Count",
+             "Rate(Hz)",
+             "Items",
+             "Lat(us)",
+             "LatMax",
+             "Miss");
     chprintf(chp,
              "-----------------------------------------------------------------"
-             "-----\r\n");
+             "------------------------------------------------\r\n");
 
     for (int i = 0; i < n && i < PROFILER_MAX_SLOTS; i++)
     {
         auto       &s = profiler_slot(i);
         const float avg_us =
             (s.count > 0) ? cycles_to_us(static_cast<uint32_t>(s.total_cycles / s.count)) : 0.0f;
+        const float rate_hz = static_cast<float>(s.count) / elapsed_s;
+        const float per_pass =
+            (s.count > 0) ? static_cast<float>(s.items) / static_cast<float>(s.count) : 0.0f;
+        const uint32_t lat_avg_us =
+            (s.lat_count > 0) ? static_cast<uint32_t>(s.lat_total_us / s.lat_count) : 0U;
         chprintf(chp,
-                 "%-24s %10.1f %10.1f %10.1f %10lu\r\n",
+                 "%-24s %10.1f %10.1f %10.1f %10lu %9.1f %7.1f %8lu %8lu %6lu\r\n",
                  s.name,
                  static_cast<double>(cycles_to_us(s.last_cycles)),
                  static_cast<double>(avg_us),
                  static_cast<double>(cycles_to_us(s.max_cycles)),
-                 s.count);
+                 s.count,
+                 static_cast<double>(rate_hz),
+                 static_cast<double>(per_pass),
+                 lat_avg_us,
+                 s.lat_max_us,
+                 s.misses);
     }
 }
 
@@ -78,7 +107,14 @@ void profiler_reset()
         s.max_cycles   = 0;
         s.total_cycles = 0;
         s.count        = 0;
+        s.items        = 0;
+        s.lat_last_us  = 0;
+        s.lat_max_us   = 0;
+        s.lat_total_us = 0;
+        s.lat_count    = 0;
+        s.misses       = 0;
     }
+    s_epoch = chVTGetSystemTimeX();
 }
 
 }  // namespace acs
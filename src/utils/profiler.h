@@ -2,7 +2,11 @@
  * ACS4 Flight Computer — Execution Time Profiler
  *
  * Lightweight per-slot profiler based on DWT cycle counter.
- * Each slot tracks: last / avg / max execution time in cycles.
+ * Each slot tracks: last / avg / max execution time in cycles, plus the
+ * number of items (samples, packets, ...) processed per pass, so batch
+ * loops report both wakeup rate and batch size. Pipeline stages can also
+ * record an end-to-end latency (e.g. sample timestamp → publication) per
+ * pass and count deadline misses against it.
  * Use PROFILE_BEGIN / PROFILE_END macros in hot loops.
  *
  * profiler_begin / profiler_end are inline for zero-overhead
@@ -33,7 +37,13 @@ struct ProfileSlot
     uint32_t    max_cycles;
     uint64_t    total_cycles;
     uint32_t    count;
-    uint32_t    start_cycle; /* internal: captured at PROFILE_BEGIN */
+    uint32_t    items;        /* work items processed (profiler_items) */
+    uint32_t    lat_last_us;  /* end-to-end latency (profiler_latency) */
+    uint32_t    lat_max_us;
+    uint64_t    lat_total_us;
+    uint32_t    lat_count;
+    uint32_t    misses;       /* passes over deadline or with dropped input */
+    uint32_t    start_cycle;  /* internal: captured at PROFILE_BEGIN */
 };
 
 /**
@@ -79,6 +89,43 @@ inline void profiler_end(int slot_id)
     }
 }
 
+/**
+ * @brief Account @p n processed items to a slot (e.g. samples per batch).
+ */
+inline void profiler_items(int slot_id, uint32_t n)
+{
+    profiler_slot(slot_id).items += n;
+}
+
+/**
+ * @brief Record one end-to-end latency sample; over @p deadline_us counts
+ *        as a deadline miss.
+ */
+inline void profiler_latency(int slot_id, uint32_t latency_us, uint32_t deadline_us)
+{
+    auto &s       = profiler_slot(slot_id);
+    s.lat_last_us = latency_us;
+    s.lat_total_us += latency_us;
+    s.lat_count++;
+    if (latency_us > s.lat_max_us)
+    {
+        s.lat_max_us = latency_us;
+    }
+    if (latency_us > deadline_us)
+    {
+        s.misses++;
+    }
+}
+
+/**
+ * @brief Count a deadline miss not tied to a latency sample (e.g. the
+ *        consumer fell behind and input samples were dropped).
+ */
+inline void profiler_miss(int slot_id)
+{
+    profiler_slot(slot_id).misses++;
+}
+
 /* ── Cold-path functions (defined in profiler.cpp) ────────────────────── */
 
 /**
@@ -89,6 +136,10 @@ int profiler_register(const char *name);
 
 /**
  * @brief Print all profiler slots to a stream (shell `perf` command).
+ *
+ * Rate(Hz) is passes per second since boot or the last profiler_reset();
+ * Items/pass is the mean batch size for slots that call profiler_items();
+ * Lat/LatMax (µs) and Miss are filled by profiler_latency()/profiler_miss().
  */
 void profiler_print(BaseSequentialStream *chp);
 
@@ -0,0 +1,176 @@
+/*
+ * ACS4 Flight Computer — Multi-Consumer Sample Ring
+ *
+ * Fixed-capacity history of timestamped samples with one producer and any
+ * number of independent consumers. Each consumer owns a SampleCursor and
+ * batch-reads every sample it has not seen yet, straight out of the ring —
+ * no intermediate snapshot copy and no shared "fresh" flag.
+ *
+ * The producer never waits. A consumer that falls more than Capacity
+ * samples behind loses the oldest ones; the loss is added to its cursor's
+ * overrun counter and it resumes from the oldest sample still present.
+ *
+ * Every slot carries a stamp (index + 1 of the sample it holds, 0 while
+ * being rewritten), so a consumer preempted mid-copy detects that the
+ * producer lapped it and counts that sample as an overrun instead of
+ * returning a torn value.
+ *
+ * Slot storage is aligned to the Cortex-M7 32-byte D-cache line.
+ *
+ * No RTOS or hardware dependencies — safe for unit tests on host.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "utils/seqlock.h"
+
+namespace acs
+{
+
+/**
+ * @brief Per-consumer read position in a SampleRing.
+ */
+struct SampleCursor
+{
+    uint32_t next     = 0; /* index of the next sample to read */
+    uint32_t overruns = 0; /* samples lost because the consumer fell behind */
+};
+
+template <typename T, size_t Capacity>
+class SampleRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SampleRing capacity must be a power of two");
+
+  public:
+    static constexpr size_t kCapacity = Capacity;
+
+    SampleRing()                              = default;
+    SampleRing(const SampleRing &)            = delete;
+    SampleRing &operator=(const SampleRing &) = delete;
+
+    /**
+     * @brief Append a sample (single producer only, never blocks).
+     */
+    void push(const T &sample)
+    {
+        const uint32_t idx  = head_.load(std::memory_order_relaxed);
+        Slot          &slot = slots_[idx & kMask];
+
+        slot.stamp.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.data.store(sample);
+        slot.stamp.store(idx + 1, std::memory_order_release);
+
+        head_.store(idx + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Cursor positioned at the current head (sees only new samples).
+     */
+    [[nodiscard]] SampleCursor subscribe() const
+    {
+        SampleCursor c;
+        c.next = head_.load(std::memory_order_acquire);
+        return c;
+    }
+
+    /**
+     * @brief Number of samples the cursor can read right now (≤ Capacity).
+     */
+    [[nodiscard]] size_t available(const SampleCursor &cursor) const
+    {
+        const uint32_t pending = head_.load(std::memory_order_acquire) - cursor.next;
+        return pending > Capacity ? Capacity : pending;
+    }
+
+    /**
+     * @brief Batch-read up to max samples, oldest first.
+     *
+     * Advances the cursor past every sample returned or lost.
+     *
+     * @return Number of samples written to out.
+     */
+    size_t read(SampleCursor &cursor, T *out, size_t max) const
+    {
+        size_t n = 0;
+
+        while (n < max)
+        {
+            const uint32_t head = head_.load(std::memory_order_acquire);
+            if (head == cursor.next)
+            {
+                break;
+            }
+
+            /* Consumer lapped — skip to the oldest sample still present */
+            if (head - cursor.next > Capacity)
+            {
+                const uint32_t oldest = head - static_cast<uint32_t>(Capacity);
+                cursor.overruns += oldest - cursor.next;
+                cursor.next = oldest;
+            }
+
+            const uint32_t idx   = cursor.next;
+            const Slot    &slot  = slots_[idx & kMask];
+            const uint32_t stamp = slot.stamp.load(std::memory_order_acquire);
+
+            if (stamp == idx + 1)
+            {
+                slot.data.load(out[n]);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.stamp.load(std::memory_order_relaxed) == stamp)
+                {
+                    ++n;
+                    ++cursor.next;
+                    continue;
+                }
+            }
+
+            /* Slot rewritten under us — the sample is gone */
+            ++cursor.overruns;
+            ++cursor.next;
+        }
+
+        return n;
+    }
+
+    /**
+     * @brief Copy the most recent sample.
+     * @return false if nothing was pushed yet (or it is being rewritten).
+     */
+    bool latest(T &out) const
+    {
+        SampleCursor c;
+        c.next = head_.load(std::memory_order_acquire);
+        if (c.next == 0)
+        {
+            return false;
+        }
+        --c.next;
+        return read(c, &out, 1) == 1;
+    }
+
+    /**
+     * @brief Total samples ever pushed (wraps at 2^32).
+     */
+    [[nodiscard]] uint32_t total() const { return head_.load(std::memory_order_acquire); }
+
+  private:
+    static constexpr uint32_t kMask = static_cast<uint32_t>(Capacity - 1);
+
+    struct Slot
+    {
+        std::atomic<uint32_t> stamp{0};
+        AtomicWords<T>        data;
+    };
+
+    alignas(32) Slot slots_[Capacity];
+    std::atomic<uint32_t> head_{0};
+};
+
+}  // namespace acs
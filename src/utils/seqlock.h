@@ -0,0 +1,149 @@
+/*
+ * ACS4 Flight Computer — Lock-Free Latched Sequence Lock
+ *
+ * Single-writer / multi-reader publication of a trivially copyable value
+ * without masking interrupts. The writer never blocks and never waits for
+ * readers; readers copy the value and retry only if a write overlapped
+ * their copy.
+ *
+ * Classic seqlocks make a reader spin while the sequence is odd. On a
+ * single-core RTOS that is a livelock if the reader runs at a higher
+ * priority than a preempted writer. This variant keeps two copies (the
+ * "latch" scheme): while the writer updates one copy, readers are steered
+ * to the other, so a reader can always complete against a stable copy and
+ * only retries when the writer preempts it mid-copy.
+ *
+ * Payload words are accessed through relaxed std::atomic<uint32_t> so the
+ * concurrent copy is well-defined C++. On Cortex-M7 those are plain
+ * LDR/STR; the fences compile to DMB.
+ *
+ * No RTOS or hardware dependencies — safe for unit tests on host.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace acs
+{
+
+/**
+ * @brief Word-wise atomic storage for a trivially copyable T.
+ *
+ * Building block for lock-free containers that must copy a struct while
+ * another context may be writing it. Each 32-bit word is an independent
+ * relaxed atomic; consistency across words is the caller's job (sequence
+ * counter, slot stamp, ...).
+ */
+template <typename T>
+class AtomicWords
+{
+    static_assert(std::is_trivially_copyable_v<T>, "AtomicWords<T> requires trivially copyable T");
+
+  public:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    void store(const T &value)
+    {
+        uint32_t tmp[kWords] = {};
+        std::memcpy(tmp, &value, sizeof(T));
+        for (size_t i = 0; i < kWords; ++i)
+        {
+            words_[i].store(tmp[i], std::memory_order_relaxed);
+        }
+    }
+
+    void load(T &out) const
+    {
+        uint32_t tmp[kWords];
+        for (size_t i = 0; i < kWords; ++i)
+        {
+            tmp[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::memcpy(&out, tmp, sizeof(T));
+    }
+
+  private:
+    std::array<std::atomic<uint32_t>, kWords> words_{};
+};
+
+/**
+ * @brief Double-buffered sequence lock ("seqlock latch").
+ *
+ * Exactly one context may call write() for a given instance; any number
+ * of contexts may call read() concurrently, including from a higher
+ * priority than the writer.
+ */
+template <typename T>
+class SeqLatch
+{
+  public:
+    SeqLatch()                            = default;
+    SeqLatch(const SeqLatch &)            = delete;
+    SeqLatch &operator=(const SeqLatch &) = delete;
+
+    /**
+     * @brief Publish a new value (single writer only).
+     *
+     * Sequence goes odd → readers use copy[1] while copy[0] is rewritten,
+     * then even → readers use copy[0] while copy[1] catches up.
+     */
+    void write(const T &value)
+    {
+        const uint32_t seq = seq_.load(std::memory_order_relaxed);
+
+        seq_.store(seq + 1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        copy_[0].store(value);
+
+        seq_.store(seq + 2, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        copy_[1].store(value);
+    }
+
+    /**
+     * @brief Copy out a consistent value.
+     * @return Sequence number the copy belongs to (advances by 2 per write,
+     *         0 if nothing was ever written). Wraps after 2^31 writes —
+     *         ~24 days of continuous 1 kHz publication.
+     */
+    uint32_t read(T &out) const
+    {
+        while (true)
+        {
+            const uint32_t seq = seq_.load(std::memory_order_acquire);
+            copy_[seq & 1U].load(out);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == seq)
+            {
+                return seq & ~1U;
+            }
+        }
+    }
+
+    [[nodiscard]] T read() const
+    {
+        T out{};
+        (void)read(out);
+        return out;
+    }
+
+    /**
+     * @brief Current sequence (cheap freshness check, no copy).
+     */
+    [[nodiscard]] uint32_t sequence() const
+    {
+        return seq_.load(std::memory_order_acquire) & ~1U;
+    }
+
+  private:
+    std::atomic<uint32_t> seq_{0};
+    AtomicWords<T>        copy_[2];
+};
+
+}  // namespace acs
@@ -47,6 +47,20 @@ inline uint32_t timestamp_us()
     return DWT->CYCCNT / CYCLES_PER_US;
 }
 
+/**
+ * @brief Period of timestamp_us() in microseconds (one CYCCNT wrap).
+ */
+inline constexpr uint32_t TIMESTAMP_WRAP_US =
+    static_cast<uint32_t>(0x100000000ULL / CYCLES_PER_US);
+
+/**
+ * @brief Microseconds from @p from to @p to, allowing one timestamp_us() wrap.
+ */
+inline uint32_t timestamp_elapsed_us(uint32_t from, uint32_t to)
+{
+    return (to >= from) ? to - from : to + (TIMESTAMP_WRAP_US - from);
+}
+
 /**
  * @brief Convert a cycle delta to microseconds.
  */
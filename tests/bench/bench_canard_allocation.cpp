@@ -0,0 +1,72 @@
+/**
+ * @file bench_canard_allocation.cpp
+ * @brief Host cycle-count benchmark for the canard allocator.
+ *
+ * Not a unit test (not registered with CTest). Run manually:
+ *   ./build_test/acs4_bench_allocation
+ *
+ * Reports cycles per call (TSC on x86-64, ns otherwise) for an
+ * unsaturated demand (one pass) and a heavily saturated one (all
+ * redistribution passes). Budget on the STM32H725: < 5 µs per call.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "control/canard_allocation.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+static inline uint64_t now_ticks()
+{
+    return __rdtsc();
+}
+static constexpr const char *kUnit = "cycles";
+#else
+static inline uint64_t now_ticks()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+static constexpr const char *kUnit = "ns";
+#endif
+
+using namespace acs::ctrl;
+
+namespace
+{
+
+constexpr int kIters = 1000000;
+
+/* Suma kontrolna — wynik obserwowalny, nic nie zostanie wyciete */
+volatile float g_sink = 0.0f;
+
+double bench(float scale)
+{
+    float          acc = 0.0f;
+    const uint64_t t0  = now_ticks();
+    for (int n = 0; n < kIters; ++n)
+    {
+        const auto        v = static_cast<float>(n & 15) * scale;
+        const AxisCommand m = {v, 0.7f * v, -0.4f * v};
+        acc += kRocketAllocator.allocate(m, 15.0f).fins[2];
+    }
+    const uint64_t t1 = now_ticks();
+    g_sink            = acc;
+    return static_cast<double>(t1 - t0) / kIters;
+}
+
+}  // namespace
+
+int main()
+{
+    const double free_run  = bench(0.5f);
+    const double saturated = bench(4.0f);
+
+    std::printf("%-14s %14s\n", "case", kUnit);
+    std::printf("%-14s %14.1f\n", "unsaturated", free_run);
+    std::printf("%-14s %14.1f\n", "saturated", saturated);
+    return 0;
+}
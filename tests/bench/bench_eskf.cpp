@@ -0,0 +1,109 @@
+/**
+ * @file bench_eskf.cpp
+ * @brief Host cycle-count benchmark for the ESKF predict / update steps.
+ *
+ * Not a unit test (not registered with CTest). Run manually:
+ *   ./build_test/acs4_bench_eskf
+ *
+ * Reports cycles per call (TSC on x86-64, ns otherwise). Target on the
+ * STM32H725 (Cortex-M7, 550 MHz, FPU-SP): predict < 50 µs ≈ 27 500 cycles,
+ * measured on target with the profiler's DWT slot. Host numbers are only
+ * useful for comparing revisions of the filter.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "navigation/eskf.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+static inline uint64_t now_ticks()
+{
+    return __rdtsc();
+}
+static constexpr const char *kUnit = "cycles";
+#else
+static inline uint64_t now_ticks()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+static constexpr const char *kUnit = "ns";
+#endif
+
+using namespace acs::nav;
+
+namespace
+{
+
+constexpr int kIters = 200000;
+
+DeltaState step(int n)
+{
+    const auto v = static_cast<float>(n & 255) * 1e-4f;
+    DeltaState d;
+    d.dtheta   = Vec3(v, -v, 0.5f * v);
+    d.dvel     = Vec3(v, v, -9.81f) * 1e-3f;
+    d.dt       = 1e-3f;
+    d.samples  = 1;
+    d.t_end_us = static_cast<uint32_t>(n) * 1000U;
+    return d;
+}
+
+template <typename Fn>
+double bench(Eskf &f, Fn &&fn)
+{
+    const uint64_t t0 = now_ticks();
+    for (int n = 0; n < kIters; ++n)
+    {
+        fn(f, n);
+    }
+    const uint64_t t1 = now_ticks();
+    return static_cast<double>(t1 - t0) / kIters;
+}
+
+}  // namespace
+
+int main()
+{
+    /* Bramka wylaczona — mierzymy pelna sciezke aktualizacji */
+    EskfConfig cfg = EskfConfig::rocket_default();
+    cfg.gate_sigma = 0.0f;
+
+    Eskf f;
+    f.set_mag_reference(Vec3(0.2f, 0.0f, 0.45f));
+
+    /* Co okres reinicjalizacja, zeby P nie roslo bez ograniczen */
+    const double predict = bench(f, [&cfg](Eskf &e, int n) {
+        if ((n & 4095) == 0)
+        {
+            e.init(cfg, quat_identity());
+        }
+        (void)e.predict(step(n));
+    });
+
+    f.init(cfg, quat_identity());
+    const double baro = bench(f, [](Eskf &e, int n) {
+        (void)e.update_baro(static_cast<float>(n & 7) * 0.1f);
+    });
+    f.init(cfg, quat_identity());
+    const double mag = bench(f, [](Eskf &e, int n) {
+        (void)e.update_mag(Vec3(0.2f, static_cast<float>(n & 7) * 1e-3f, 0.45f));
+    });
+
+    std::printf("%-14s %14s\n", "step", kUnit);
+    std::printf("%-14s %14.1f\n", "predict", predict);
+    std::printf("%-14s %14.1f\n", "update_baro", baro);
+    std::printf("%-14s %14.1f\n", "update_mag", mag);
+
+    /* Keep the state observable so nothing is optimised away */
+    if (!f.state().p.allFinite())
+    {
+        std::printf("nan\n");
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file bench_imu_decimator.cpp
+ * @brief Host cycle-count benchmark for the IMU decimator kernels.
+ *
+ * Not a unit test (not registered with CTest). Run manually:
+ *   ./build_test/acs4_bench_decimator
+ *
+ * Reports cycles per input sample (TSC on x86-64, ns otherwise) for each
+ * kernel and factor. Absolute numbers are host-specific; use them to
+ * compare kernels and catch regressions, not to predict Cortex-M7 time.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "sensors/imu_decimator.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+static inline uint64_t now_ticks()
+{
+    return __rdtsc();
+}
+static constexpr const char *kUnit = "cycles";
+#else
+static inline uint64_t now_ticks()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+static constexpr const char *kUnit = "ns";
+#endif
+
+namespace
+{
+
+constexpr int kSamples = 1 << 20;
+
+double bench(acs::DecimatorKind kind, uint8_t factor)
+{
+    acs::ImuDecimator dec;
+    (void)dec.configure(factor, kind);
+
+    acs::ImuReading in{};
+    acs::ImuReading out{};
+    float           sink = 0.0f;
+
+    const uint64_t t0 = now_ticks();
+    for (int n = 0; n < kSamples; ++n)
+    {
+        const auto v    = static_cast<float>(n & 1023) * 1e-3f;
+        in.timestamp_us = static_cast<uint32_t>(n) * 125U;
+        in.accel_mps2   = {v, -v, 9.81f};
+        in.gyro_rads    = {v, v, -v};
+        if (dec.push(in, out))
+        {
+            sink += out.gyro_rads[0];
+        }
+    }
+    const uint64_t t1 = now_ticks();
+
+    /* Keep the result observable so the loop is not optimised away */
+    if (std::isnan(sink))
+    {
+        std::printf("nan\n");
+    }
+    return static_cast<double>(t1 - t0) / kSamples;
+}
+
+}  // namespace
+
+int main()
+{
+    std::printf("%-8s %6s %6s %14s\n", "kernel", "factor", "taps", kUnit);
+    for (uint8_t factor : {2, 4, 8})
+    {
+        for (auto kind : {acs::DecimatorKind::BOXCAR, acs::DecimatorKind::FIR})
+        {
+            acs::ImuDecimator probe;
+            (void)probe.configure(factor, kind);
+            std::printf("%-8s %6u %6zu %14.2f\n",
+                        kind == acs::DecimatorKind::FIR ? "FIR" : "BOXCAR",
+                        factor,
+                        probe.taps(),
+                        bench(kind, factor));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,804 @@
+/**
+ * @file log_decode.cpp
+ * @brief Native flight log decoder — dispatch table, columns, output.
+ */
+
+#include "log_decode.h"
+
+#include <array>
+#include <cinttypes>
+#include <cmath>
+#include <utility>
+
+#include "logger/imu_delta_codec.h"
+
+namespace acs
+{
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Schema
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+namespace
+{
+
+size_t fixed_size_of(const LogSchemaMsg &m)
+{
+    size_t n = (m.layout == LogLayout::VARINTS) ? 1 : sizeof(LogHeader);
+    for (const LogSchemaField &f : m.fields)
+    {
+        n += log_field_size(f.type);
+    }
+    return n;
+}
+
+bool valid_type(uint8_t t)
+{
+    return t >= static_cast<uint8_t>(LogFieldType::U8) &&
+           t <= static_cast<uint8_t>(LogFieldType::I32);
+}
+
+}  // namespace
+
+std::vector<LogSchemaMsg> log_schema_builtin()
+{
+    std::vector<LogSchemaMsg> out;
+    for (const LogMsgDesc &m : LOG_SCHEMA)
+    {
+        LogSchemaMsg msg{static_cast<uint8_t>(m.id), m.name, m.layout, m.layout_arg, {}, 0};
+        for (size_t i = 0; i < m.n_fields; ++i)
+        {
+            const LogFieldDesc &f = m.fields[i];
+            msg.fields.push_back(LogSchemaField{f.name, f.type, f.scale, f.decimals});
+        }
+        msg.fixed_size = log_msg_fixed_size(m);
+        out.push_back(std::move(msg));
+    }
+    return out;
+}
+
+size_t log_schema_parse(const uint8_t *data, size_t size, std::vector<LogSchemaMsg> &out)
+{
+    if (size < 7 || std::memcmp(data, LOG_SCHEMA_MAGIC, 4) != 0)
+    {
+        return 0;
+    }
+    uint16_t len;
+    std::memcpy(&len, &data[4], sizeof(len));
+    const size_t end = 6 + size_t{len};
+    if (end > size)
+    {
+        return 0;
+    }
+
+    size_t pos = 6;
+    auto   get = [&](void *dst, size_t n) {
+        if (pos + n > end)
+        {
+            return false;
+        }
+        std::memcpy(dst, &data[pos], n);
+        pos += n;
+        return true;
+    };
+    auto get_str = [&](std::string &str) {
+        uint8_t n = 0;
+        if (!get(&n, 1) || pos + n > end)
+        {
+            return false;
+        }
+        str.assign(reinterpret_cast<const char *>(&data[pos]), n);
+        pos += n;
+        return true;
+    };
+
+    std::vector<LogSchemaMsg> msgs;
+    uint8_t                   n_msgs = 0;
+    if (!get(&n_msgs, 1))
+    {
+        return 0;
+    }
+    for (size_t i = 0; i < n_msgs; ++i)
+    {
+        uint8_t hdr[4]; /* id, layout, layout_arg, n_fields */
+        LogSchemaMsg msg{};
+        if (!get(hdr, sizeof(hdr)) || !get_str(msg.name) || hdr[0] == LOG_PAD_BYTE ||
+            hdr[1] > static_cast<uint8_t>(LogLayout::VARINTS))
+        {
+            return 0;
+        }
+        msg.id         = hdr[0];
+        msg.layout     = static_cast<LogLayout>(hdr[1]);
+        msg.layout_arg = hdr[2];
+        for (size_t k = 0; k < hdr[3]; ++k)
+        {
+            uint8_t        td[2]; /* type, decimals */
+            LogSchemaField f{};
+            if (!get(td, sizeof(td)) || !get(&f.scale, sizeof(f.scale)) || !get_str(f.name) ||
+                !valid_type(td[0]))
+            {
+                return 0;
+            }
+            f.type     = static_cast<LogFieldType>(td[0]);
+            f.decimals = td[1];
+            msg.fields.push_back(std::move(f));
+        }
+        msg.fixed_size = fixed_size_of(msg);
+
+        /* Regula dlugosci musi wskazywac u16 w czesci stalej */
+        if (msg.layout == LogLayout::LEN16 && size_t{msg.layout_arg} + 2 > msg.fixed_size)
+        {
+            return 0;
+        }
+        msgs.push_back(std::move(msg));
+    }
+    if (pos != end)
+    {
+        return 0;
+    }
+
+    out = std::move(msgs);
+    return end;
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Columns
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+int64_t LogColumn::raw(size_t row) const
+{
+    const uint8_t *p = &storage[row * log_field_size(type)];
+    switch (type)
+    {
+        case LogFieldType::U8:
+            return p[0];
+        case LogFieldType::U16:
+        {
+            uint16_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        case LogFieldType::U32:
+        {
+            uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        case LogFieldType::I16:
+        {
+            int16_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        case LogFieldType::I32:
+        {
+            int32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+    }
+    return 0;
+}
+
+const LogTable *DecodedLog::table(const std::string &name) const
+{
+    for (const LogTable &t : tables)
+    {
+        if (t.name == name)
+        {
+            return &t;
+        }
+    }
+    return nullptr;
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Decoder
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+namespace
+{
+
+constexpr auto kImu      = static_cast<uint8_t>(LogMsgId::IMU);
+constexpr auto kImuDelta = static_cast<uint8_t>(LogMsgId::IMU_DELTA);
+constexpr auto kImuBlock = static_cast<uint8_t>(LogMsgId::IMU_BLOCK);
+
+struct Decoder;
+
+/* Zwraca dlugosc rekordu, 0 = obciety / uszkodzony */
+using RecordFn = size_t (*)(Decoder &d, uint8_t id, const uint8_t *rec, size_t avail);
+
+struct Handler
+{
+    RecordFn fn          = nullptr;
+    int      msg         = -1; /* indeks w schemacie */
+    int      table       = -1; /* indeks tabeli, -1 = bez wierszy */
+    bool     timestamped = false;
+};
+
+struct Decoder
+{
+    DecodedLog               &log;
+    uint32_t                  index_interval_us;
+    bool                      framed = false; /* v5: indeks wskazuje ramke rekordu */
+    size_t                    frame  = 0;     /* offset biezacej ramki */
+    std::array<Handler, 256>  dispatch{};
+    ImuDeltaDecoder           imu_chain{};
+    ImuFixed                  block[LOG_IMU_BLOCK_MAX_SAMPLES]{};
+    uint64_t                  wrap_us    = 0; /* okres timestamp_us */
+    uint32_t                  last_stamp = 0;
+    uint64_t                  time_us    = 0; /* czas rozwiniety */
+    bool                      timed      = false;
+    uint64_t                  next_index = 0;
+    bool                      indexed    = false;
+};
+
+/* Rozwija znacznik czasu do zegara 64-bit — krok wstecz o wiecej niz pol
+ * okresu to przepelnienie licznika, mniejszy to przeplot producentow */
+uint64_t unwrap(Decoder &d, uint32_t stamp)
+{
+    if (!d.timed)
+    {
+        d.time_us = stamp;
+        d.timed   = true;
+    }
+    else
+    {
+        const uint64_t w    = d.wrap_us;
+        const uint64_t step = (stamp % w + w - d.last_stamp % w) % w;
+        if (step <= w / 2)
+        {
+            d.time_us += step;
+        }
+        else
+        {
+            d.time_us -= std::min(d.time_us, w - step);
+        }
+    }
+    d.last_stamp = stamp;
+    return d.time_us;
+}
+
+/* Probki IMU do kolumn — jedno sprawdzenie miejsca na blok, nie na wartosc */
+void push_imu(LogTable &t, const ImuFixed *s, size_t n)
+{
+    uint8_t *ts = t.cols[0].append(n * sizeof(uint32_t));
+    uint8_t *axes[6];
+    for (size_t i = 0; i < 6; ++i)
+    {
+        axes[i] = t.cols[1 + i].append(n * sizeof(int16_t));
+    }
+
+    for (size_t k = 0; k < n; ++k)
+    {
+        std::memcpy(&ts[k * sizeof(uint32_t)], &s[k].timestamp_us, sizeof(uint32_t));
+        for (size_t i = 0; i < 3; ++i)
+        {
+            std::memcpy(&axes[i][k * sizeof(int16_t)], &s[k].accel[i], sizeof(int16_t));
+            std::memcpy(&axes[3 + i][k * sizeof(int16_t)], &s[k].gyro[i], sizeof(int16_t));
+        }
+    }
+    t.rows += n;
+}
+
+LogTable &imu_table(Decoder &d)
+{
+    return d.log.tables[static_cast<size_t>(d.dispatch[kImu].table)];
+}
+
+size_t decode_imu(Decoder &d, uint8_t id, const uint8_t *rec, size_t avail)
+{
+    ImuFixed s{};
+    size_t   used = 0;
+    if (d.imu_chain.decode(rec, avail, s, used))
+    {
+        push_imu(imu_table(d), &s, 1);
+        d.log.imu_delta_count += (id == kImuDelta) ? 1 : 0;
+    }
+    else if (used > 0)
+    {
+        ++d.log.imu_unsynced;
+    }
+    return used;
+}
+
+size_t decode_imu_block(Decoder &d, uint8_t, const uint8_t *rec, size_t avail)
+{
+    size_t       count = 0;
+    const size_t used  = imu_block_decode(rec, avail, d.block, count);
+    push_imu(imu_table(d), d.block, count);
+    d.log.imu_block_count += (used > 0) ? 1 : 0;
+    return used;
+}
+
+/* Dlugosc rekordu wg reguly ze schematu */
+size_t record_length(const LogSchemaMsg &m, const uint8_t *rec, size_t avail)
+{
+    switch (m.layout)
+    {
+        case LogLayout::FIXED:
+            return (avail >= m.fixed_size) ? m.fixed_size : 0;
+        case LogLayout::LEN16:
+        {
+            if (avail < m.fixed_size)
+            {
+                return 0;
+            }
+            uint16_t payload;
+            std::memcpy(&payload, &rec[m.layout_arg], sizeof(payload));
+            const size_t len = m.fixed_size + payload;
+            return (avail >= len) ? len : 0;
+        }
+        case LogLayout::VARINTS:
+        {
+            size_t pos = 1;
+            for (size_t i = 0; i < m.layout_arg; ++i)
+            {
+                uint32_t     v;
+                const size_t n = varint_get(&rec[pos], avail - pos, v);
+                if (n == 0)
+                {
+                    return 0;
+                }
+                pos += n;
+            }
+            return pos;
+        }
+    }
+    return 0;
+}
+
+/* Dowolny typ ze schematu: naglowek + pola stale do kolumn, reszta pominieta */
+size_t decode_generic(Decoder &d, uint8_t id, const uint8_t *rec, size_t avail)
+{
+    const Handler      &h   = d.dispatch[id];
+    const LogSchemaMsg &m   = d.log.schema[static_cast<size_t>(h.msg)];
+    const size_t        len = record_length(m, rec, avail);
+    if (len == 0 || h.table < 0)
+    {
+        return len;
+    }
+
+    LogTable &t = d.log.tables[static_cast<size_t>(h.table)];
+    size_t    pos = 1;
+    std::memcpy(t.cols[0].append(4), &rec[pos], 4);
+    pos += 4;
+    for (size_t i = 0; i < m.fields.size(); ++i)
+    {
+        const size_t n = log_field_size(m.fields[i].type);
+        std::memcpy(t.cols[1 + i].append(n), &rec[pos], n);
+        pos += n;
+    }
+    ++t.rows;
+    return len;
+}
+
+/* Tabele i dispatch ze schematu; IMU* przez kodeki firmware, gdy uklad
+ * w pliku zgadza sie z wkompilowanym */
+void build(Decoder &d)
+{
+    const std::vector<LogSchemaMsg> builtin = log_schema_builtin();
+    auto matches_builtin = [&](const LogSchemaMsg &m) {
+        for (const LogSchemaMsg &b : builtin)
+        {
+            if (b.id == m.id)
+            {
+                return b.layout == m.layout && b.layout_arg == m.layout_arg &&
+                       b.fixed_size == m.fixed_size;
+            }
+        }
+        return false;
+    };
+
+    const std::vector<LogSchemaMsg> &schema = d.log.schema;
+    bool                             imu_ok = false;
+    for (const LogSchemaMsg &m : schema)
+    {
+        imu_ok = imu_ok || (m.id == kImu && matches_builtin(m));
+    }
+
+    for (size_t i = 0; i < schema.size(); ++i)
+    {
+        const LogSchemaMsg &m = schema[i];
+        Handler            &h = d.dispatch[m.id];
+        h.msg                 = static_cast<int>(i);
+        h.timestamped         = (m.layout != LogLayout::VARINTS);
+        h.fn                  = decode_generic;
+
+        const bool imu_codec = imu_ok && matches_builtin(m) &&
+                               (m.id == kImu || m.id == kImuDelta || m.id == kImuBlock);
+        if (imu_codec)
+        {
+            h.fn = (m.id == kImuBlock) ? decode_imu_block : decode_imu;
+        }
+        if (m.layout == LogLayout::VARINTS || (imu_codec && m.id != kImu))
+        {
+            continue; /* bez wlasnej tabeli */
+        }
+
+        LogTable t;
+        t.name   = m.name;
+        t.msg_id = m.id;
+        t.cols.push_back(LogColumn{"timestamp_us", LogFieldType::U32, 1.0, 0});
+        for (const LogSchemaField &f : m.fields)
+        {
+            t.cols.push_back(LogColumn{f.name, f.type, f.scale, f.decimals});
+        }
+        h.table = static_cast<int>(d.log.tables.size());
+        d.log.tables.push_back(std::move(t));
+    }
+}
+
+/* Bieg bajtow wypelnienia od pos — po 8 naraz (megabajty w prealokacji) */
+size_t padding_run(const uint8_t *data, size_t pos, size_t size)
+{
+    const size_t start = pos;
+    while (pos + 8 <= size)
+    {
+        uint64_t w;
+        std::memcpy(&w, &data[pos], sizeof(w));
+        if (w != 0)
+        {
+            break;
+        }
+        pos += 8;
+    }
+    while (pos < size && data[pos] == LOG_PAD_BYTE)
+    {
+        ++pos;
+    }
+    return pos - start;
+}
+
+/* Rekordy z [pos, end); zwraca pozycje za ostatnim calym rekordem */
+size_t decode_records(Decoder &d, const uint8_t *data, size_t pos, size_t end)
+{
+    DecodedLog &log = d.log;
+    while (pos < end)
+    {
+        const uint8_t id = data[pos];
+        if (id == LOG_PAD_BYTE)
+        {
+            const size_t n = padding_run(data, pos, end);
+            log.padding_bytes += n;
+            pos += n;
+            continue;
+        }
+
+        const Handler &h = d.dispatch[id];
+        if (h.fn == nullptr)
+        {
+            ++log.unknown_count;
+            ++pos;
+            continue;
+        }
+
+        const size_t used = h.fn(d, id, &data[pos], end - pos);
+        if (used == 0)
+        {
+            ++log.parse_errors;
+            break;
+        }
+
+        /* Indeks: tylko rekordy z LogHeader */
+        if (h.timestamped)
+        {
+            LogHeader hdr;
+            std::memcpy(&hdr, &data[pos], sizeof(hdr));
+            const uint64_t t = unwrap(d, hdr.timestamp_us);
+            if (!d.indexed || t >= d.next_index)
+            {
+                log.index.push_back(LogIndexEntry{hdr.timestamp_us, t, d.framed ? d.frame : pos});
+                d.next_index = t + d.index_interval_us;
+                d.indexed    = true;
+            }
+        }
+
+        ++log.records;
+        pos += used;
+    }
+    return pos;
+}
+
+/* Dlugosc calej ramki od pos, 0 = to nie jest poprawna ramka */
+size_t frame_at(const uint8_t *data, size_t pos, size_t size, uint32_t seed, LogFrameHeader &h)
+{
+    if (size - pos < sizeof(LogFrameHeader) ||
+        std::memcmp(&data[pos], LOG_FRAME_SYNC, sizeof(LOG_FRAME_SYNC)) != 0)
+    {
+        return 0;
+    }
+    std::memcpy(&h, &data[pos], sizeof(h));
+    const size_t len = sizeof(LogFrameHeader) + h.len;
+    if (size - pos < len || log_frame_crc(&data[pos], h.len, seed) != h.crc)
+    {
+        return 0;
+    }
+    return len;
+}
+
+/* Pierwsze slowo synchronizacji od pos (size, gdy brak) */
+size_t find_sync(const uint8_t *data, size_t pos, size_t size)
+{
+    while (pos < size)
+    {
+        const auto *p = static_cast<const uint8_t *>(
+            std::memchr(&data[pos], LOG_FRAME_SYNC[0], size - pos));
+        if (p == nullptr)
+        {
+            return size;
+        }
+        pos = static_cast<size_t>(p - data);
+        if (size - pos >= sizeof(LOG_FRAME_SYNC) &&
+            std::memcmp(p, LOG_FRAME_SYNC, sizeof(LOG_FRAME_SYNC)) == 0)
+        {
+            return pos;
+        }
+        ++pos;
+    }
+    return size;
+}
+
+}  // namespace
+
+DecodedLog log_decode(const uint8_t *data, size_t size, const LogDecodeOptions &opt)
+{
+    DecodedLog log;
+    if (size < sizeof(LogFileHeader))
+    {
+        return log;
+    }
+    std::memcpy(&log.header, data, sizeof(LogFileHeader));
+    if (std::memcmp(log.header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0)
+    {
+        return log;
+    }
+    log.header_ok = true;
+
+    size_t pos = sizeof(LogFileHeader);
+    if (log.header.version >= 4)
+    {
+        const size_t n     = log_schema_parse(&data[pos], size - pos, log.schema);
+        log.schema_in_file = (n > 0);
+        pos += n;
+    }
+    if (!log.schema_in_file)
+    {
+        log.schema = log_schema_builtin();
+    }
+
+    Decoder d{log, opt.index_interval_us};
+    d.framed  = (log.header.version >= 5);
+    d.wrap_us = log_timestamp_wrap_us(log.header);
+    build(d);
+
+    if (log.header.version < 5)
+    {
+        /* Przed v5 bez ramek: pierwszy uszkodzony rekord konczy dekodowanie */
+        log.bytes_consumed = decode_records(d, data, pos, size);
+        return log;
+    }
+
+    const uint32_t seed     = log_frame_seed(log.header);
+    uint32_t       next_seq = 0; /* ramki od 0 w kazdym pliku */
+    bool           in_bad   = false;
+    while (pos < size)
+    {
+        if (data[pos] == LOG_PAD_BYTE)
+        {
+            const size_t n = padding_run(data, pos, size);
+            log.padding_bytes += n;
+            pos += n;
+            continue;
+        }
+
+        LogFrameHeader h{};
+        const size_t   len = frame_at(data, pos, size, seed, h);
+        if (len == 0)
+        {
+            /* Resynchronizacja: do nastepnego slowa synchronizacji; lancuch
+             * delt IMU czeka na klatke kluczowa */
+            const size_t next = find_sync(data, pos + 1, size);
+            log.corrupt_bytes += next - pos;
+            log.corrupt_regions += in_bad ? 0 : 1;
+            in_bad = true;
+            d.imu_chain.reset();
+            pos = next;
+            continue;
+        }
+        in_bad = false;
+
+        if (h.seq != next_seq)
+        {
+            const auto gap = static_cast<int32_t>(h.seq - next_seq);
+            log.frames_lost += (gap > 0) ? static_cast<uint64_t>(gap) : 0;
+            d.imu_chain.reset();
+        }
+        next_seq = h.seq + 1;
+        ++log.frames;
+
+        const size_t payload = pos + sizeof(LogFrameHeader);
+        d.frame              = pos;
+        if (decode_records(d, data, payload, payload + h.len) != payload + h.len)
+        {
+            d.imu_chain.reset(); /* reszta ramki przepada */
+        }
+        pos += len;
+    }
+
+    log.bytes_consumed = pos;
+    return log;
+}
+
+uint64_t log_timestamp_wrap_us(const LogFileHeader &header)
+{
+    const uint32_t cycles_per_us = header.sysclk_hz / 1000000U;
+    return (cycles_per_us > 0) ? 0x100000000ULL / cycles_per_us : 0x100000000ULL;
+}
+
+uint64_t log_index_seek(const std::vector<LogIndexEntry> &index, uint64_t time_us)
+{
+    uint64_t off = index.empty() ? 0 : index.front().offset;
+    size_t   lo  = 0;
+    size_t   n   = index.size();
+    while (n > 0)
+    {
+        const size_t half = n / 2;
+        if (index[lo + half].time_us <= time_us)
+        {
+            off = index[lo + half].offset;
+            lo += half + 1;
+            n -= half + 1;
+        }
+        else
+        {
+            n = half;
+        }
+    }
+    return off;
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Output
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+namespace
+{
+
+/* 10^-k dla skal dziesietnych (szybka sciezka bez printf), -1 inaczej */
+int decimal_exponent(double scale)
+{
+    double p = 1.0;
+    for (int k = 0; k <= 6; ++k)
+    {
+        if (std::fabs(scale * p - 1.0) < 1e-9)
+        {
+            return k;
+        }
+        p *= 10.0;
+    }
+    return -1;
+}
+
+/* raw · 10^-k z 'decimals' miejscami (decimals >= k) */
+size_t format_decimal(char *out, int64_t raw, int k, int decimals)
+{
+    char  tmp[32];
+    char *p   = tmp + sizeof(tmp);
+    auto  mag = static_cast<uint64_t>(raw < 0 ? -raw : raw);
+
+    for (int i = k; i < decimals; ++i)
+    {
+        *--p = '0';
+    }
+    for (int i = 0; i < k; ++i)
+    {
+        *--p = static_cast<char>('0' + mag % 10);
+        mag /= 10;
+    }
+    if (decimals > 0)
+    {
+        *--p = '.';
+    }
+    do
+    {
+        *--p = static_cast<char>('0' + mag % 10);
+        mag /= 10;
+    } while (mag > 0);
+    if (raw < 0)
+    {
+        *--p = '-';
+    }
+
+    const auto n = static_cast<size_t>(tmp + sizeof(tmp) - p);
+    std::memcpy(out, p, n);
+    return n;
+}
+
+}  // namespace
+
+bool log_write_csv(const LogTable &table, std::FILE *out)
+{
+    const size_t ncols = table.cols.size();
+    std::vector<int> exp10(ncols);
+    for (size_t c = 0; c < ncols; ++c)
+    {
+        std::fprintf(out, "%s%s", (c == 0) ? "" : ",", table.cols[c].name.c_str());
+        exp10[c] = decimal_exponent(table.cols[c].scale);
+        if (exp10[c] > table.cols[c].decimals)
+        {
+            exp10[c] = -1;
+        }
+    }
+    std::fputc('\n', out);
+
+    std::vector<char> line(ncols * 32 + 2);
+    for (size_t row = 0; row < table.rows; ++row)
+    {
+        size_t n = 0;
+        for (size_t c = 0; c < ncols; ++c)
+        {
+            const LogColumn &col = table.cols[c];
+            if (c > 0)
+            {
+                line[n++] = ',';
+            }
+            const int64_t raw = col.raw(row);
+            if (exp10[c] >= 0)
+            {
+                n += format_decimal(&line[n], raw, exp10[c], col.decimals);
+            }
+            else
+            {
+                n += static_cast<size_t>(std::snprintf(&line[n], 32, "%.*f", col.decimals,
+                                                       static_cast<double>(raw) * col.scale));
+            }
+        }
+        line[n++] = '\n';
+        if (std::fwrite(line.data(), 1, n, out) != n)
+        {
+            return false;
+        }
+    }
+    return std::ferror(out) == 0;
+}
+
+bool log_write_columnar(const LogTable &table, std::FILE *out)
+{
+    const uint16_t version = 1;
+    const auto     ncols   = static_cast<uint16_t>(table.cols.size());
+    const uint64_t rows    = table.rows;
+
+    bool ok = std::fwrite("ACSC", 1, 4, out) == 4 &&
+              std::fwrite(&version, sizeof(version), 1, out) == 1 &&
+              std::fwrite(&ncols, sizeof(ncols), 1, out) == 1 &&
+              std::fwrite(&rows, sizeof(rows), 1, out) == 1;
+
+    for (const LogColumn &c : table.cols)
+    {
+        const auto type     = static_cast<uint8_t>(c.type);
+        const auto name_len = static_cast<uint8_t>(c.name.size());
+        ok                  = ok && std::fwrite(&type, 1, 1, out) == 1 &&
+             std::fwrite(&name_len, 1, 1, out) == 1 &&
+             std::fwrite(c.name.data(), 1, name_len, out) == name_len &&
+             std::fwrite(&c.scale, sizeof(c.scale), 1, out) == 1;
+    }
+    for (const LogColumn &c : table.cols)
+    {
+        ok = ok && std::fwrite(c.data(), 1, c.size_bytes(), out) == c.size_bytes();
+    }
+    return ok;
+}
+
+bool log_write_index(const std::vector<LogIndexEntry> &index, std::FILE *out)
+{
+    std::fprintf(out, "timestamp_us,time_us,offset\n");
+    for (const LogIndexEntry &e : index)
+    {
+        std::fprintf(out, "%" PRIu32 ",%" PRIu64 ",%" PRIu64 "\n", e.timestamp_us, e.time_us,
+                     e.offset);
+    }
+    return std::ferror(out) == 0;
+}
+
+}  // namespace acs
@@ -0,0 +1,226 @@
+/**
+ * @file log_decode.h
+ * @brief Native decoder for ACS4 flight logs (LOG_NNN.BIN / PRE_NNN.BIN).
+ *
+ * Host-side counterpart of tools/log_decoder.py for large logs: decodes
+ * an in-memory image (acs4_logdec mmaps the file) in one pass, with a
+ * 256-entry dispatch table on msg_id, into one columnar table per message
+ * type plus a sparse timestamp → file offset index.
+ *
+ * Schema-driven: tables, columns, scales and record lengths come from the
+ * schema block a v4+ file carries after LogFileHeader (older files: the
+ * compiled-in LOG_SCHEMA of src/logger/log_format.h). Any fixed-layout or
+ * LEN16 record decodes generically — a message type added after this tool
+ * was built still lands in its own table; VARINTS types are skipped by
+ * length. IMU, IMU_DELTA and IMU_BLOCK are expanded into the "imu" table
+ * with the firmware's own codecs (logger/imu_delta_codec.h).
+ *
+ * Columns hold raw wire values (LSB); scale and CSV precision travel with
+ * the column description. Output:
+ *   - CSV        — same files, headers and precision as log_decoder.py
+ *   - columnar   — <table>.col, see log_write_columnar()
+ *   - index      — every index_interval_us, the first record at or after
+ *                  that time: {timestamp_us, time_us, file offset}
+ *
+ * timestamp_us is the DWT cycle counter divided down to µs, so it wraps
+ * every 2^32 / (sysclk_hz / 1e6) µs (~7.8 s at 550 MHz), not at 2^32.
+ * The decoder unwraps the record headers in file order into time_us, a
+ * 64-bit µs clock starting at the first record's timestamp; the index and
+ * log_index_seek() run on that clock. A step back of more than half a
+ * period reads as a wrap, so a gap longer than that (a lost region, a
+ * stalled logger) cannot be told apart from a shorter one.
+ *
+ * Decoding rules match log_decoder.py: padding runs (0x00) are skipped,
+ * unknown IDs are counted and skipped one byte at a time. v5 files carry
+ * records in CRC frames: a frame that fails its check is dropped and the
+ * decoder resynchronises on the next sync word (corrupt_*), a malformed
+ * record inside a valid frame drops the rest of that frame; either way
+ * the IMU delta chain waits for the next keyframe. Before v5 a truncated
+ * or malformed record stops the decode (parse_errors = 1).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "logger/log_format.h"
+
+namespace acs
+{
+
+/* ── Schema (runtime copy of LOG_SCHEMA or of the file's schema block) ── */
+
+struct LogSchemaField
+{
+    std::string  name;
+    LogFieldType type;
+    double       scale;
+    uint8_t      decimals;
+};
+
+struct LogSchemaMsg
+{
+    uint8_t                     id;
+    std::string                 name;
+    LogLayout                   layout;
+    uint8_t                     layout_arg;
+    std::vector<LogSchemaField> fields;
+    size_t                      fixed_size; /* see log_msg_fixed_size() */
+};
+
+/** LOG_SCHEMA as compiled into this tool. */
+std::vector<LogSchemaMsg> log_schema_builtin();
+
+/**
+ * @brief Parse a schema block (see log_schema_write()).
+ * @return Bytes consumed, 0 if there is no valid block at data.
+ */
+size_t log_schema_parse(const uint8_t *data, size_t size, std::vector<LogSchemaMsg> &out);
+
+/* ── Columns ──────────────────────────────────────────────────────────── */
+
+/**
+ * @brief One column: raw values of one type, back to back.
+ */
+struct LogColumn
+{
+    std::string  name;
+    LogFieldType type;
+    double       scale;    /* physical value = raw · scale */
+    uint8_t      decimals; /* CSV precision */
+
+    /* Hot path: storage grows by doubling and `used` marks the filled
+     * part, so a value costs a bounds check and a store */
+    template <typename T>
+    void push(T v)
+    {
+        std::memcpy(append(sizeof(T)), &v, sizeof(T));
+    }
+
+    /** Room for n_bytes more; the caller fills all of it. */
+    uint8_t *append(size_t n_bytes)
+    {
+        if (used + n_bytes > storage.size())
+        {
+            storage.resize(std::max<size_t>({65536, storage.size() * 2, used + n_bytes}));
+        }
+        uint8_t *p = &storage[used];
+        used += n_bytes;
+        return p;
+    }
+
+    [[nodiscard]] const uint8_t *data() const
+    {
+        return storage.data();
+    }
+
+    [[nodiscard]] size_t size_bytes() const
+    {
+        return used;
+    }
+
+    /** Raw value of row (sign-extended). */
+    [[nodiscard]] int64_t raw(size_t row) const;
+
+    std::vector<uint8_t> storage{};
+    size_t               used = 0;
+};
+
+/**
+ * @brief One message type (file stem = name): timestamp_us + its fields.
+ */
+struct LogTable
+{
+    std::string            name;
+    uint8_t                msg_id = 0;
+    std::vector<LogColumn> cols;
+    size_t                 rows = 0;
+};
+
+struct LogIndexEntry
+{
+    uint32_t timestamp_us; /* as logged */
+    uint64_t time_us;      /* unwrapped, see above */
+    uint64_t offset;       /* file offset of the record (v5: of its frame) */
+};
+
+struct LogDecodeOptions
+{
+    uint32_t index_interval_us = 100000; /* 0 = every timestamped record */
+};
+
+struct DecodedLog
+{
+    bool          header_ok = false;
+    LogFileHeader header{};
+
+    std::vector<LogSchemaMsg> schema;
+    bool                      schema_in_file = false; /* else LOG_SCHEMA */
+
+    std::vector<LogTable>      tables; /* schema order */
+    std::vector<LogIndexEntry> index;
+
+    uint64_t records         = 0; /* whole records decoded (a block counts once) */
+    uint64_t imu_delta_count = 0;
+    uint64_t imu_block_count = 0;
+    uint64_t imu_unsynced    = 0; /* deltas before the first keyframe */
+    uint64_t unknown_count   = 0;
+    uint64_t padding_bytes   = 0;
+    uint64_t parse_errors    = 0;
+    uint64_t frames          = 0; /* v5: frames that passed the CRC */
+    uint64_t frames_lost     = 0; /* v5: gaps in the frame sequence */
+    uint64_t corrupt_regions = 0; /* v5: damaged runs skipped by resync */
+    uint64_t corrupt_bytes   = 0;
+    uint64_t bytes_consumed  = 0; /* header included */
+
+    /** Table by name, nullptr if the schema has none. */
+    [[nodiscard]] const LogTable *table(const std::string &name) const;
+};
+
+/**
+ * @brief Decode a whole log image.
+ *
+ * Fails (header_ok = false, nothing decoded) on a short file or bad
+ * magic; a version other than LOG_FORMAT_VERSION is decoded anyway.
+ */
+DecodedLog log_decode(const uint8_t *data, size_t size, const LogDecodeOptions &opt = {});
+
+/**
+ * @brief Wrap period of timestamp_us in a log: 2^32 / (sysclk_hz / 1e6)
+ *        rounded down like TIMESTAMP_WRAP_US, 2^32 if sysclk_hz < 1 MHz.
+ */
+uint64_t log_timestamp_wrap_us(const LogFileHeader &header);
+
+/**
+ * @brief File offset to start reading at for records from time_us onwards
+ *        (unwrapped, LogIndexEntry::time_us): the last index entry at or
+ *        before it, else the first one (0 if the index is empty).
+ */
+uint64_t log_index_seek(const std::vector<LogIndexEntry> &index, uint64_t time_us);
+
+/**
+ * @brief Write a table as CSV (header row, scaled values).
+ */
+bool log_write_csv(const LogTable &table, std::FILE *out);
+
+/**
+ * @brief Write a table in the columnar format (little-endian):
+ *
+ *   "ACSC"  u16 version = 1  u16 columns  u64 rows
+ *   per column:  u8 type (LogFieldType)  u8 name_len  name  f64 scale
+ *   per column:  rows × raw values, in column order
+ */
+bool log_write_columnar(const LogTable &table, std::FILE *out);
+
+/**
+ * @brief Write the timestamp index as CSV (timestamp_us,time_us,offset).
+ */
+bool log_write_index(const std::vector<LogIndexEntry> &index, std::FILE *out);
+
+}  // namespace acs
@@ -0,0 +1,270 @@
+/**
+ * @file logdec_main.cpp
+ * @brief acs4_logdec — native decoder for ACS4 flight logs (host tool).
+ *
+ * Not a unit test (not registered with CTest). Run manually:
+ *   ./build_test/acs4_logdec LOG_001.BIN                 # summary
+ *   ./build_test/acs4_logdec LOG_001.BIN -o out/         # CSV + index (out/ created)
+ *   ./build_test/acs4_logdec LOG_001.BIN -o out/ --col   # + columnar
+ *   ./build_test/acs4_logdec LOG_001.BIN --index-ms 10
+ *
+ * The file is mmapped and decoded in one pass (log_decode.h); decode and
+ * output throughput are reported on stderr. Formats are those of
+ * tools/log_decoder.py (CSV) and log_write_columnar() (<table>.col).
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "log_decode.h"
+
+namespace
+{
+
+double seconds_since(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void print_summary(const acs::DecodedLog &log)
+{
+    const acs::LogFileHeader &h = log.header;
+    std::printf("=== ACS4 Flight Log ===\n");
+    std::printf("Format version: %u%s\n", h.version,
+                (h.version == acs::LOG_FORMAT_VERSION) ? "" : " (decoder expects another)");
+    std::printf("System clock:   %.1f MHz\n", h.sysclk_hz / 1e6);
+    std::printf("Boot time:      %u ms\n", h.boot_time_ms);
+
+    std::printf("Schema:         %s (%zu message types)\n\n",
+                log.schema_in_file ? "from file" : "built-in", log.schema.size());
+
+    std::printf("Records decoded: %llu\n", static_cast<unsigned long long>(log.records));
+    for (const acs::LogTable &t : log.tables)
+    {
+        std::printf("  %-10s %zu rows\n", t.name.c_str(), t.rows);
+    }
+    std::printf("  IMU deltas: %llu, blocks: %llu\n",
+                static_cast<unsigned long long>(log.imu_delta_count),
+                static_cast<unsigned long long>(log.imu_block_count));
+    if (log.imu_unsynced > 0)
+    {
+        std::printf("  IMU deltas before first keyframe: %llu\n",
+                    static_cast<unsigned long long>(log.imu_unsynced));
+    }
+    std::printf("  Unknown: %llu\n", static_cast<unsigned long long>(log.unknown_count));
+    if (log.padding_bytes > 0)
+    {
+        std::printf("  Padding: %llu B (log not closed cleanly?)\n",
+                    static_cast<unsigned long long>(log.padding_bytes));
+    }
+    std::printf("  Errors:  %llu\n", static_cast<unsigned long long>(log.parse_errors));
+    if (log.header.version >= 5)
+    {
+        std::printf("  Frames:  %llu ok, %llu lost, %llu corrupt regions (%llu B)\n",
+                    static_cast<unsigned long long>(log.frames),
+                    static_cast<unsigned long long>(log.frames_lost),
+                    static_cast<unsigned long long>(log.corrupt_regions),
+                    static_cast<unsigned long long>(log.corrupt_bytes));
+    }
+    std::printf("  Index:   %zu entries", log.index.size());
+    if (!log.index.empty())
+    {
+        /* time_us rozwiniety — dlugosc lotu mimo przepelnien licznika */
+        const uint64_t span = log.index.back().time_us - log.index.front().time_us;
+        std::printf(", span %.1f s", static_cast<double>(span) / 1e6);
+    }
+    std::printf("\n");
+}
+
+bool write_file(const std::string &path, bool (*fn)(const acs::LogTable &, std::FILE *),
+                const acs::LogTable &table)
+{
+    std::FILE *f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr)
+    {
+        std::fprintf(stderr, "Error: cannot create %s\n", path.c_str());
+        return false;
+    }
+    const bool ok = fn(table, f);
+    return (std::fclose(f) == 0) && ok;
+}
+
+/* Jak mkdir(parents=True, exist_ok=True) w log_decoder.py */
+bool make_dirs(const std::string &dir)
+{
+    for (size_t i = 1; i <= dir.size(); ++i)
+    {
+        if (i < dir.size() && dir[i] != '/')
+        {
+            continue;
+        }
+        const std::string part = dir.substr(0, i);
+        if (mkdir(part.c_str(), 0777) != 0 && errno != EEXIST)
+        {
+            return false;
+        }
+    }
+    struct stat st{};
+    return stat(dir.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+int usage()
+{
+    std::fprintf(stderr,
+                 "Usage: acs4_logdec LOG.BIN [-o DIR] [--col] [--no-csv] [--index-ms N]\n");
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    const char *path = nullptr;
+    std::string out_dir;
+    bool        col    = false;
+    bool        csv    = true;
+    long        idx_ms = 100;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            out_dir = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--col") == 0)
+        {
+            col = true;
+        }
+        else if (std::strcmp(argv[i], "--no-csv") == 0)
+        {
+            csv = false;
+        }
+        else if (std::strcmp(argv[i], "--index-ms") == 0 && i + 1 < argc)
+        {
+            idx_ms = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (argv[i][0] != '-' && path == nullptr)
+        {
+            path = argv[i];
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    if (path == nullptr || idx_ms < 0)
+    {
+        return usage();
+    }
+
+    const int fd = open(path, O_RDONLY);
+    struct stat st{};
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        std::fprintf(stderr, "Error: cannot open %s\n", path);
+        return 1;
+    }
+    const auto size = static_cast<size_t>(st.st_size);
+    void      *map  = (size > 0) ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+    close(fd);
+    if (size > 0 && map == MAP_FAILED)
+    {
+        std::fprintf(stderr, "Error: mmap failed for %s\n", path);
+        return 1;
+    }
+    if (map != nullptr)
+    {
+        (void)madvise(map, size, MADV_SEQUENTIAL);
+    }
+
+    acs::LogDecodeOptions opt;
+    opt.index_interval_us = static_cast<uint32_t>(idx_ms) * 1000U;
+
+    const auto            t0  = std::chrono::steady_clock::now();
+    const acs::DecodedLog log = acs::log_decode(static_cast<const uint8_t *>(map), size, opt);
+    const double          dt  = seconds_since(t0);
+    if (map != nullptr)
+    {
+        munmap(map, size);
+    }
+
+    if (!log.header_ok)
+    {
+        std::fprintf(stderr, "Error: %s is not an ACS4 log (short file or bad magic)\n", path);
+        return 1;
+    }
+    std::fprintf(stderr, "Decoded %.1f MB in %.3f s (%.0f MB/s)\n", size / 1e6, dt,
+                 (dt > 0) ? size / 1e6 / dt : 0.0);
+
+    if (out_dir.empty())
+    {
+        print_summary(log);
+        return 0;
+    }
+
+    if (!make_dirs(out_dir))
+    {
+        std::fprintf(stderr, "Error: cannot create directory %s\n", out_dir.c_str());
+        return 1;
+    }
+
+    /* Pierwszy blad zapisu konczy wyjscie — "Wrote" tylko po udanym zapisie */
+    const auto t1 = std::chrono::steady_clock::now();
+    bool       ok = true;
+    for (const acs::LogTable &t : log.tables)
+    {
+        if (t.rows == 0)
+        {
+            continue;
+        }
+        const std::string stem = out_dir + "/" + t.name;
+        ok = (!csv || write_file(stem + ".csv", acs::log_write_csv, t)) &&
+             (!col || write_file(stem + ".col", acs::log_write_columnar, t));
+        if (!ok)
+        {
+            break;
+        }
+        std::fprintf(stderr, "  Wrote %s (%zu rows)\n", stem.c_str(), t.rows);
+    }
+
+    if (ok)
+    {
+        const std::string index = out_dir + "/index.csv";
+        std::FILE        *f     = std::fopen(index.c_str(), "wb");
+        if (f == nullptr)
+        {
+            std::fprintf(stderr, "Error: cannot create %s\n", index.c_str());
+            ok = false;
+        }
+        else
+        {
+            ok = acs::log_write_index(log.index, f);
+            ok = (std::fclose(f) == 0) && ok;
+        }
+        if (ok)
+        {
+            std::fprintf(stderr, "  Wrote %s (%zu entries)\n", index.c_str(), log.index.size());
+            std::fprintf(stderr, "Output written in %.3f s\n", seconds_since(t1));
+        }
+    }
+
+    if (!ok)
+    {
+        std::fprintf(stderr, "Error: writing to %s failed\n", out_dir.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file test_alignment.cpp
+ * @brief Unit tests for TRIAD launch-pad alignment.
+ */
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "navigation/alignment.h"
+
+using namespace acs::nav;
+
+namespace
+{
+
+const Vec3 kMagNed(0.2f, 0.0f, 0.45f); /* ~65° inklinacja, deklinacja 0 */
+
+Vec3 rest_accel(const Quat &q)
+{
+    return quat_to_dcm(q).transpose() * Vec3(0.0f, 0.0f, -9.80665f);
+}
+
+}  // namespace
+
+TEST(Alignment, RecoversArbitraryAttitude)
+{
+    for (const Vec3 &eul : {Vec3(0.0f, 0.0f, 0.0f),
+                            Vec3(0.1f, -0.2f, 1.0f),
+                            Vec3(-0.5f, 0.7f, -2.5f),
+                            Vec3(1.2f, 0.1f, 3.0f)})
+    {
+        const Quat truth = quat_from_euler(eul.x(), eul.y(), eul.z());
+        const Vec3 m     = quat_to_dcm(truth).transpose() * kMagNed;
+
+        Quat q;
+        ASSERT_TRUE(triad_align(rest_accel(truth), m * 48.0f, q));
+        EXPECT_LT(quat_error_angle(q, truth), 1e-4f);
+    }
+}
+
+TEST(Alignment, MagErrorOnlyAffectsYaw)
+{
+    const Quat truth = quat_from_euler(0.3f, -0.2f, 0.5f);
+
+    /* Zaklocenie pola w kierunku E — zmienia tylko kurs */
+    const Vec3 m_bad = quat_to_dcm(truth).transpose() * (kMagNed + Vec3(0.0f, 0.1f, 0.0f));
+
+    Quat q;
+    ASSERT_TRUE(triad_align(rest_accel(truth), m_bad, q));
+
+    float r0 = 0.0f, p0 = 0.0f, y0 = 0.0f, r1 = 0.0f, p1 = 0.0f, y1 = 0.0f;
+    quat_to_euler(truth, r0, p0, y0);
+    quat_to_euler(q, r1, p1, y1);
+    EXPECT_NEAR(r1, r0, 1e-4f);
+    EXPECT_NEAR(p1, p0, 1e-4f);
+    EXPECT_GT(std::fabs(y1 - y0), 0.1f);
+}
+
+TEST(Alignment, MissingMagFallsBackToForwardAxis)
+{
+    const Quat truth = quat_from_euler(0.2f, 0.1f, 0.0f);
+
+    Quat q;
+    ASSERT_TRUE(triad_align(rest_accel(truth), Vec3::Zero(), q));
+
+    /* Pochylenie poprawne; "polnoc" = rzut osi +Y */
+    const Vec3 up_body = quat_to_dcm(q).transpose() * Vec3(0.0f, 0.0f, -1.0f);
+    EXPECT_LT((up_body - rest_accel(truth).normalized()).norm(), 1e-5f);
+}
+
+TEST(Alignment, RejectsZeroAccel)
+{
+    Quat q;
+    EXPECT_FALSE(triad_align(Vec3::Zero(), kMagNed, q));
+}
@@ -0,0 +1,176 @@
+/**
+ * @file test_attitude_control.cpp
+ * @brief Unit tests for the PID attitude law and canard mixing.
+ *
+ * Coverage:
+ *   - constexpr mixing matrix (per-axis fin patterns)
+ *   - P / D sign conventions, fin clamp
+ *   - integrator cap and conditional-integration anti-windup
+ *   - closed loop: roll hold on a simple rigid-body roll plant
+ */
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "control/attitude_control.h"
+
+using namespace acs::ctrl;
+using acs::nav::Quat;
+using acs::nav::Vec3;
+using acs::nav::quat_from_euler;
+using acs::nav::quat_identity;
+
+namespace
+{
+
+constexpr float kDeg = 0.01745329252f;
+
+AttitudeGains pd_gains(float kp, float kd)
+{
+    AttitudeGains g{};
+    for (auto &a : g.axis)
+    {
+        a = {kp, 0.0f, kd};
+    }
+    return g;
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Mixing
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(CanardMix, AxisPatterns)
+{
+    constexpr FinCommand roll = mix_canards({2.0f, 0.0f, 0.0f});
+    static_assert(roll[0] == 2.0f && roll[1] == 2.0f && roll[2] == 2.0f && roll[3] == 2.0f);
+
+    constexpr FinCommand pitch = mix_canards({0.0f, 3.0f, 0.0f});
+    EXPECT_FLOAT_EQ(pitch[0], -3.0f);
+    EXPECT_FLOAT_EQ(pitch[1], 0.0f);
+    EXPECT_FLOAT_EQ(pitch[2], 3.0f);
+    EXPECT_FLOAT_EQ(pitch[3], 0.0f);
+
+    constexpr FinCommand yaw = mix_canards({0.0f, 0.0f, 1.0f});
+    EXPECT_FLOAT_EQ(yaw[0], 0.0f);
+    EXPECT_FLOAT_EQ(yaw[1], -1.0f);
+    EXPECT_FLOAT_EQ(yaw[2], 0.0f);
+    EXPECT_FLOAT_EQ(yaw[3], 1.0f);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  PID law
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(AttitudeController, ZeroErrorZeroOutput)
+{
+    AttitudeController c({15.0f, 5.0f});
+    const FinCommand   f = c.update(pd_gains(1.0f, 0.1f), quat_identity(), quat_identity(),
+                                    Vec3::Zero(), 0.01f);
+    for (float v : f)
+    {
+        EXPECT_FLOAT_EQ(v, 0.0f);
+    }
+    EXPECT_FALSE(c.saturated());
+}
+
+TEST(AttitudeController, ProportionalDrivesTowardSetpoint)
+{
+    AttitudeController c({15.0f, 5.0f});
+
+    /* Obrot -5° w przechyleniu wzgledem zadanego → dodatnia komenda roll */
+    const Quat q = quat_from_euler(-5.0f * kDeg, 0.0f, 0.0f);
+    (void)c.update(pd_gains(1.0f, 0.0f), q, quat_identity(), Vec3::Zero(), 0.01f);
+    EXPECT_NEAR(c.axis_command()[0], 5.0f, 1e-2f);
+    EXPECT_NEAR(c.axis_command()[1], 0.0f, 1e-4f);
+    EXPECT_NEAR(c.axis_command()[2], 0.0f, 1e-4f);
+
+    /* Pochylenie +4° → ujemna komenda pitch */
+    const Quat qp = quat_from_euler(0.0f, 4.0f * kDeg, 0.0f);
+    (void)c.update(pd_gains(2.0f, 0.0f), qp, quat_identity(), Vec3::Zero(), 0.01f);
+    EXPECT_NEAR(c.axis_command()[1], -8.0f, 2e-2f);
+}
+
+TEST(AttitudeController, DerivativeOpposesRate)
+{
+    AttitudeController c({15.0f, 5.0f});
+    (void)c.update(pd_gains(0.0f, 0.1f), quat_identity(), quat_identity(),
+                   Vec3(0.0f, 0.0f, 20.0f * kDeg), 0.01f);
+    EXPECT_NEAR(c.axis_command()[2], -2.0f, 1e-4f);
+}
+
+TEST(AttitudeController, ClampsEachFin)
+{
+    AttitudeController c({10.0f, 5.0f});
+    const Quat         q = quat_from_euler(-30.0f * kDeg, 0.0f, 0.0f);
+    const FinCommand   f = c.update(pd_gains(1.0f, 0.0f), q, quat_identity(), Vec3::Zero(), 0.01f);
+    for (float v : f)
+    {
+        EXPECT_FLOAT_EQ(v, 10.0f);
+    }
+    EXPECT_TRUE(c.saturated());
+}
+
+TEST(AttitudeController, IntegratorCappedAndFrozenWhenSaturated)
+{
+    AttitudeGains g{};
+    g.axis[0] = {0.0f, 10.0f, 0.0f};
+
+    /* Bez nasycenia: calka rosnie do limitu i tam staje */
+    AttitudeController c({15.0f, 3.0f});
+    const Quat         q = quat_from_euler(-2.0f * kDeg, 0.0f, 0.0f);
+    for (int i = 0; i < 100; ++i)
+    {
+        (void)c.update(g, q, quat_identity(), Vec3::Zero(), 0.01f);
+    }
+    EXPECT_FLOAT_EQ(c.integrator()[0], 3.0f);
+    EXPECT_FALSE(c.saturated());
+
+    /* Nasycenie przez P: calka nie rosnie w strone nasycenia */
+    AttitudeController s({5.0f, 100.0f});
+    g.axis[0].kp     = 1.0f;
+    const Quat q_big = quat_from_euler(-20.0f * kDeg, 0.0f, 0.0f);
+    (void)s.update(g, q_big, quat_identity(), Vec3::Zero(), 0.01f);
+    const float frozen = s.integrator()[0];
+    ASSERT_TRUE(s.saturated());
+    for (int i = 0; i < 50; ++i)
+    {
+        (void)s.update(g, q_big, quat_identity(), Vec3::Zero(), 0.01f);
+    }
+    EXPECT_FLOAT_EQ(s.integrator()[0], frozen);
+
+    /* Blad zmienia znak → calka znow pracuje */
+    const Quat q_back = quat_from_euler(20.0f * kDeg, 0.0f, 0.0f);
+    (void)s.update(g, q_back, quat_identity(), Vec3::Zero(), 0.01f);
+    EXPECT_LT(s.integrator()[0], frozen);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Closed loop
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(AttitudeController, HoldsRollOnRigidBodyPlant)
+{
+    /* ṗ = k·δ_roll − c·p  (moment od sumy 4 pletw, tlumienie aerodynamiczne) */
+    constexpr float kAuth = 40.0f; /* rad/s² na rad wychylenia jednej pletwy */
+    constexpr float kDamp = 2.0f;
+    constexpr float kDt   = 0.01f;
+
+    AttitudeController c({15.0f, 5.0f});
+    AttitudeGains      g = pd_gains(1.0f, 0.2f);
+    g.axis[0].ki         = 0.5f;
+
+    float roll = 20.0f * kDeg;
+    float p    = 0.0f;
+    for (int i = 0; i < 500; ++i)
+    {
+        const FinCommand f = c.update(g, quat_from_euler(roll, 0.0f, 0.0f), quat_identity(),
+                                      Vec3(p, 0.0f, 0.0f), kDt);
+        const float      delta = f[0] * kDeg;
+        p += (kAuth * delta - kDamp * p + 0.5f /* zaklocenie */) * kDt;
+        roll += p * kDt;
+    }
+    EXPECT_NEAR(roll, 0.0f, 0.2f * kDeg);
+    EXPECT_NEAR(p, 0.0f, 0.01f);
+}
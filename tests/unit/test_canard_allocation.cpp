@@ -0,0 +1,198 @@
+/**
+ * @file test_canard_allocation.cpp
+ * @brief Unit tests for the canard control-allocation layer.
+ *
+ * Coverage:
+ *   - compile-time pseudo-inverses: full mask = plain mix, right inverse
+ *     for every full-rank fin subset, least-squares for deficient ones
+ *   - unsaturated allocation is exact and untouched
+ *   - saturated allocation: cap respected, shortfall redistributed,
+ *     better than clamp-after-mix
+ *   - failed fins (availability mask)
+ */
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "control/canard_allocation.h"
+
+using namespace acs::ctrl;
+
+namespace
+{
+
+int popcount(unsigned m)
+{
+    int n = 0;
+    for (; m != 0; m &= m - 1)
+    {
+        ++n;
+    }
+    return n;
+}
+
+float moment_error(const AxisCommand &want, const AxisCommand &got)
+{
+    float e = 0.0f;
+    for (size_t r = 0; r < 3; ++r)
+    {
+        e += (want[r] - got[r]) * (want[r] - got[r]);
+    }
+    return std::sqrt(e);
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Pseudo-inverse tables
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(CanardAllocation, FullMaskEqualsPlainMix)
+{
+    constexpr float kExpected[4][3] = {
+        {1.0f, -1.0f, 0.0f},
+        {1.0f, 0.0f, -1.0f},
+        {1.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 1.0f},
+    };
+    for (size_t i = 0; i < 4; ++i)
+    {
+        for (size_t a = 0; a < 3; ++a)
+        {
+            EXPECT_NEAR(kRocketAllocator.pinv(kAllFins, i, a), kExpected[i][a], 1e-6f);
+        }
+    }
+}
+
+TEST(CanardAllocation, RightInverseForEveryThreeFinSubset)
+{
+    const AxisCommand m = {2.0f, -1.5f, 0.75f};
+    for (unsigned mask = 1; mask < kFinMasks; ++mask)
+    {
+        if (popcount(mask) < 3)
+        {
+            continue;
+        }
+        FinCommand f{};
+        for (size_t i = 0; i < 4; ++i)
+        {
+            f[i] = kRocketAllocator.pinv(static_cast<uint8_t>(mask), i, 0) * m[0] +
+                   kRocketAllocator.pinv(static_cast<uint8_t>(mask), i, 1) * m[1] +
+                   kRocketAllocator.pinv(static_cast<uint8_t>(mask), i, 2) * m[2];
+            if (((mask >> i) & 1U) == 0)
+            {
+                EXPECT_FLOAT_EQ(f[i], 0.0f) << "mask " << mask;
+            }
+        }
+        EXPECT_LT(moment_error(m, kRocketAllocator.moment(f)), 1e-5f) << "mask " << mask;
+    }
+}
+
+TEST(CanardAllocation, DeficientSubsetIsLeastSquares)
+{
+    /* Tylko pletwy 1 i 3 (os Y): roll + pitch osiagalne, yaw nie */
+    constexpr uint8_t kMask = 0b0101;
+    const AxisCommand m     = {1.0f, 2.0f, 3.0f};
+    const auto        r     = kRocketAllocator.allocate(m, 90.0f, kMask);
+
+    EXPECT_NEAR(r.achieved[0], 1.0f, 1e-5f);
+    EXPECT_NEAR(r.achieved[1], 2.0f, 1e-5f);
+    EXPECT_NEAR(r.achieved[2], 0.0f, 1e-6f);
+    EXPECT_FLOAT_EQ(r.fins[1], 0.0f);
+    EXPECT_FLOAT_EQ(r.fins[3], 0.0f);
+
+    /* Jedna pletwa: rzut zadania na jej kolumne B */
+    const auto s = kRocketAllocator.allocate({1.0f, 0.0f, 0.0f}, 90.0f, 0b0001);
+    EXPECT_NEAR(s.fins[0], 0.25f / 0.3125f, 1e-5f);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Allocation
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(CanardAllocation, UnsaturatedIsExact)
+{
+    const AxisCommand m = {3.0f, -2.0f, 1.0f};
+    const auto        r = kRocketAllocator.allocate(m, 10.0f);
+
+    const FinCommand mix = mix_canards(m);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_FLOAT_EQ(r.fins[i], mix[i]);
+    }
+    EXPECT_EQ(r.saturated_mask, 0);
+    EXPECT_LT(moment_error(m, r.achieved), 1e-5f);
+}
+
+TEST(CanardAllocation, SaturatedRedistributesShortfall)
+{
+    /* Plain mix: fin 3 → 14° > 10°; reszta musi przejac brakujacy moment */
+    const AxisCommand m   = {8.0f, 6.0f, 0.0f};
+    constexpr float   kCap = 10.0f;
+    const auto        r   = kRocketAllocator.allocate(m, kCap);
+
+    for (float f : r.fins)
+    {
+        EXPECT_LE(std::fabs(f), kCap + 1e-6f);
+    }
+    EXPECT_TRUE(r.saturated_mask & 0b0100);
+    EXPECT_FLOAT_EQ(r.fins[2], kCap);
+
+    /* Porownanie z obcieciem po zwyklym miksie */
+    FinCommand clipped = mix_canards(m);
+    for (auto &f : clipped)
+    {
+        f = std::fmax(-kCap, std::fmin(kCap, f));
+    }
+    const float naive = moment_error(m, kRocketAllocator.moment(clipped));
+    const float redis = moment_error(m, r.achieved);
+    EXPECT_LT(redis, naive);
+    EXPECT_GT(r.achieved[0], kRocketAllocator.moment(clipped)[0]);
+    EXPECT_GT(r.achieved[1], kRocketAllocator.moment(clipped)[1]);
+}
+
+TEST(CanardAllocation, SaturatedFeasibleDemandStaysExact)
+{
+    /* Plain mix nasyca pletwe 3, ale zadanie jest osiagalne innym rozkladem:
+     * roll 6 + pitch 5 → mix: f1 = 1, f3 = 11; po przeniesieniu f3 = 10 */
+    const AxisCommand m = {6.0f, 5.0f, 0.0f};
+    const auto        r = kRocketAllocator.allocate(m, 10.0f);
+
+    EXPECT_NE(r.saturated_mask, 0);
+    EXPECT_LT(moment_error(m, r.achieved), 1e-4f);
+    for (float f : r.fins)
+    {
+        EXPECT_LE(std::fabs(f), 10.0f + 1e-6f);
+    }
+}
+
+TEST(CanardAllocation, AllSaturatedPureRoll)
+{
+    const auto r = kRocketAllocator.allocate({40.0f, 0.0f, 0.0f}, 15.0f);
+    for (float f : r.fins)
+    {
+        EXPECT_FLOAT_EQ(f, 15.0f);
+    }
+    EXPECT_EQ(r.saturated_mask, kAllFins);
+    EXPECT_NEAR(r.achieved[0], 15.0f, 1e-5f);
+}
+
+TEST(CanardAllocation, FailedFinIsReallocated)
+{
+    /* Pletwa 4 zablokowana: yaw tylko z pletwy 2, roll/pitch przez 1 i 3 */
+    constexpr uint8_t kMask = 0b0111;
+    const AxisCommand m     = {2.0f, 1.0f, 1.0f};
+    const auto        r     = kRocketAllocator.allocate(m, 15.0f, kMask);
+
+    EXPECT_FLOAT_EQ(r.fins[3], 0.0f);
+    EXPECT_LT(moment_error(m, r.achieved), 1e-5f);
+}
+
+TEST(CanardAllocation, EmptyMaskGivesZero)
+{
+    const auto r = kRocketAllocator.allocate({1.0f, 1.0f, 1.0f}, 15.0f, 0);
+    for (float f : r.fins)
+    {
+        EXPECT_FLOAT_EQ(f, 0.0f);
+    }
+}
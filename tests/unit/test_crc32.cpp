@@ -0,0 +1,37 @@
+/**
+ * @file test_crc32.cpp
+ * @brief Unit tests for the CRC-32 used by the log frames.
+ *
+ * Covers:
+ *   - standard check values (zlib / IEEE 802.3)
+ *   - incremental update equals one pass
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+
+#include "utils/crc32.h"
+
+using namespace acs;
+
+TEST(Crc32, CheckValues)
+{
+    EXPECT_EQ(crc32("", 0), 0x00000000U);
+    EXPECT_EQ(crc32("123456789", 9), 0xCBF43926U);
+    EXPECT_EQ(crc32("The quick brown fox jumps over the lazy dog", 43), 0x414FA339U);
+}
+
+TEST(Crc32, IncrementalMatchesOnePass)
+{
+    uint8_t data[1000];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 7U + (i >> 3));
+    }
+    const uint32_t whole = crc32(data, sizeof(data));
+    for (size_t cut : {size_t{0}, size_t{1}, size_t{511}, sizeof(data)})
+    {
+        EXPECT_EQ(crc32_update(crc32(data, cut), &data[cut], sizeof(data) - cut), whole) << cut;
+    }
+}
@@ -0,0 +1,269 @@
+/**
+ * @file test_eskf.cpp
+ * @brief Unit tests for the 15-state error-state Kalman filter.
+ *
+ * Coverage:
+ *   - strapdown propagation (rest, constant thrust)
+ *   - block-sparse F·P·Fᵀ vs. a dense reference product
+ *   - baro update, innovation gate
+ *   - mag heading update: yaw convergence, tilt untouched, gyro-bias
+ *     observability
+ *   - divergence detection
+ *   - no heap allocation (Eigen runtime malloc check)
+ */
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "navigation/eskf.h"
+
+using namespace acs::nav;
+
+namespace
+{
+
+constexpr float kDt = 0.01f;
+
+/** Specific force at rest for attitude q (body frame). */
+Vec3 rest_specific_force(const Quat &q)
+{
+    return quat_to_dcm(q).transpose() * Vec3(0.0f, 0.0f, -kGravity);
+}
+
+DeltaState make_delta(const Vec3 &gyro, const Vec3 &accel, float dt)
+{
+    DeltaState d;
+    d.dtheta   = gyro * dt;
+    d.dvel     = accel * dt;
+    d.dt       = dt;
+    d.samples  = 1;
+    d.t_end_us = 0;
+    return d;
+}
+
+EskfConfig test_config()
+{
+    EskfConfig cfg   = EskfConfig::rocket_default();
+    cfg.init_att_rad = 0.5f;
+    cfg.init_pos_m   = 10.0f;
+    return cfg;
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Propagation
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(Eskf, StationaryLevelStaysPut)
+{
+    Eskf       f;
+    const Quat q0 = quat_identity();
+    f.init(EskfConfig::rocket_default(), q0);
+
+    const float p_before = f.covariance()(kIdxPos, kIdxPos);
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(f.predict(make_delta(Vec3::Zero(), rest_specific_force(q0), kDt)),
+                  EskfStatus::OK);
+    }
+
+    EXPECT_LT(f.state().v.norm(), 1e-4f);
+    EXPECT_LT(f.state().p.norm(), 1e-4f);
+    EXPECT_LT(quat_error_angle(f.state().q, q0), 1e-6f);
+    EXPECT_GT(f.covariance()(kIdxPos, kIdxPos), p_before);
+    EXPECT_TRUE(f.covariance().isApprox(f.covariance().transpose()));
+}
+
+TEST(Eskf, ConstantThrustIntegratesExactly)
+{
+    Eskf f;
+    f.init(EskfConfig::rocket_default(), quat_identity());
+
+    /* 2 g ciagu w osi -Z NED (w gore): netto 1 g w gore */
+    const Vec3 force(0.0f, 0.0f, -2.0f * kGravity);
+    for (int i = 0; i < 100; ++i)
+    {
+        (void)f.predict(make_delta(Vec3::Zero(), force, kDt));
+    }
+
+    EXPECT_NEAR(f.state().v.z(), -kGravity, 1e-3f);
+    EXPECT_NEAR(f.state().p.z(), -0.5f * kGravity, 1e-3f);
+}
+
+TEST(Eskf, BlockPropagationMatchesDenseProduct)
+{
+    Eskf       f;
+    const Quat q0 = quat_from_euler(0.2f, -0.1f, 0.7f);
+    f.init(test_config(), q0);
+    f.set_mag_reference(Vec3(0.2f, 0.01f, 0.45f));
+
+    /* Kilka krokow + aktualizacji, zeby P mialo pelne sprzezenia krzyzowe */
+    for (int i = 0; i < 20; ++i)
+    {
+        (void)f.predict(make_delta(Vec3(0.1f, -0.2f, 0.3f), Vec3(1.0f, 2.0f, -9.0f), kDt));
+        (void)f.update_baro(0.1f * static_cast<float>(i));
+        (void)f.update_mag(quat_to_dcm(f.state().q).transpose() * Vec3(0.2f, 0.02f, 0.45f));
+    }
+
+    const DeltaState d  = make_delta(Vec3(0.5f, -0.3f, 0.8f), Vec3(3.0f, -1.0f, -12.0f), kDt);
+    const NavState   x0 = f.state();
+    const Mat15      P0 = f.covariance();
+
+    /* Gesta referencja: F zbudowane wprost z definicji */
+    const Vec3 dtheta = d.dtheta - x0.bg * d.dt;
+    const Vec3 dvel   = d.dvel - x0.ba * d.dt;
+    const Mat3 R      = quat_to_dcm(x0.q);
+    const Mat3 E      = quat_to_dcm(quat_from_rotation_vector(dtheta));
+
+    Mat15 F                             = Mat15::Identity();
+    F.block<3, 3>(kIdxTheta, kIdxTheta) = E.transpose();
+    F.block<3, 3>(kIdxTheta, kIdxBg)    = -Mat3::Identity() * d.dt;
+    F.block<3, 3>(kIdxVel, kIdxTheta)   = -R * skew(dvel);
+    F.block<3, 3>(kIdxVel, kIdxBa)      = -R * d.dt;
+    F.block<3, 3>(kIdxPos, kIdxVel)     = Mat3::Identity() * d.dt;
+
+    const EskfConfig cfg = test_config();
+    Mat15            Q   = Mat15::Zero();
+    Q.block<3, 3>(kIdxTheta, kIdxTheta).diagonal().setConstant(cfg.gyro_noise * cfg.gyro_noise *
+                                                                d.dt);
+    Q.block<3, 3>(kIdxVel, kIdxVel).diagonal().setConstant(cfg.accel_noise * cfg.accel_noise *
+                                                            d.dt);
+    Q.block<3, 3>(kIdxBg, kIdxBg).diagonal().setConstant(cfg.gyro_bias_rw * cfg.gyro_bias_rw *
+                                                          d.dt);
+    Q.block<3, 3>(kIdxBa, kIdxBa).diagonal().setConstant(cfg.accel_bias_rw * cfg.accel_bias_rw *
+                                                          d.dt);
+
+    const Mat15 expected = F * P0 * F.transpose() + Q;
+
+    ASSERT_EQ(f.predict(d), EskfStatus::OK);
+    const float scale = expected.cwiseAbs().maxCoeff();
+    EXPECT_LT((f.covariance() - expected).cwiseAbs().maxCoeff(), 1e-5f * scale);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Measurement updates
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(Eskf, BaroUpdatePullsAltitude)
+{
+    Eskf f;
+    f.init(test_config(), quat_identity());
+    f.set_baro_reference(120.0f);
+
+    const float var_before = f.covariance()(kIdxPos + 2, kIdxPos + 2);
+    ASSERT_EQ(f.update_baro(125.0f), EskfStatus::OK);
+
+    /* σ_p = 10 m, σ_baro = 0.5 m → niemal caly pomiar przechodzi do stanu */
+    EXPECT_NEAR(f.state().p.z(), -5.0f, 0.05f);
+    EXPECT_LT(f.covariance()(kIdxPos + 2, kIdxPos + 2), 0.01f * var_before);
+    EXPECT_NEAR(f.last_innovation(), 5.0f, 1e-5f);
+}
+
+TEST(Eskf, BaroOutlierRejectedByGate)
+{
+    Eskf f;
+    f.init(EskfConfig::rocket_default(), quat_identity());
+    f.set_baro_reference(0.0f);
+
+    /* σ_p = 0.1 m, σ_baro = 0.5 m → 50 m to ~100σ */
+    EXPECT_EQ(f.update_baro(50.0f), EskfStatus::REJECTED);
+    EXPECT_FLOAT_EQ(f.state().p.z(), 0.0f);
+}
+
+TEST(Eskf, MagUpdateCorrectsYaw)
+{
+    const Quat truth = quat_identity();
+    const Vec3 m_ned(0.2f, 0.0f, 0.45f);
+
+    Eskf f;
+    f.init(test_config(), quat_from_euler(0.0f, 0.0f, 0.3f));
+    f.set_mag_reference(m_ned);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        (void)f.predict(make_delta(Vec3::Zero(), rest_specific_force(truth), kDt));
+        ASSERT_NE(f.update_mag(quat_to_dcm(truth).transpose() * m_ned * 48.0f),
+                  EskfStatus::DIVERGED);
+    }
+
+    float roll = 0.0f, pitch = 0.0f, yaw = 0.0f;
+    quat_to_euler(f.state().q, roll, pitch, yaw);
+    EXPECT_NEAR(yaw, 0.0f, 0.01f);
+}
+
+TEST(Eskf, MagUpdateLeavesTiltAlone)
+{
+    Eskf f;
+    f.init(test_config(), quat_from_euler(0.1f, -0.05f, 0.3f));
+    f.set_mag_reference(Vec3(0.2f, 0.0f, 0.45f));
+
+    /* Pomiar zgodny z roll/pitch = 0 — tylko kurs moze sie zmienic */
+    ASSERT_EQ(f.update_mag(Vec3(0.2f, 0.0f, 0.45f)), EskfStatus::OK);
+
+    float roll = 0.0f, pitch = 0.0f, yaw = 0.0f;
+    quat_to_euler(f.state().q, roll, pitch, yaw);
+    EXPECT_NEAR(roll, 0.1f, 1e-3f);
+    EXPECT_NEAR(pitch, -0.05f, 1e-3f);
+    EXPECT_LT(std::fabs(yaw), 0.3f);
+}
+
+TEST(Eskf, GyroBiasObservableThroughMag)
+{
+    const Quat truth = quat_identity();
+    const Vec3 m_ned(0.2f, 0.0f, 0.45f);
+    const Vec3 bias(0.0f, 0.0f, 0.01f);
+
+    Eskf f;
+    f.init(EskfConfig::rocket_default(), truth);
+    f.set_mag_reference(m_ned);
+
+    for (int i = 0; i < 6000; ++i)
+    {
+        (void)f.predict(make_delta(bias, rest_specific_force(truth), kDt));
+        (void)f.update_mag(m_ned);
+    }
+
+    EXPECT_NEAR(f.state().bg.z(), bias.z(), 1e-3f);
+    EXPECT_LT(quat_error_angle(f.state().q, truth), 0.01f);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Health / resources
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(Eskf, NonFiniteInputReportsDiverged)
+{
+    Eskf f;
+    f.init(EskfConfig::rocket_default(), quat_identity());
+
+    const float nan = std::nanf("");
+    EXPECT_EQ(f.predict(make_delta(Vec3(nan, 0.0f, 0.0f), Vec3::Zero(), kDt)),
+              EskfStatus::DIVERGED);
+}
+
+TEST(Eskf, RejectsDegenerateMagnetometer)
+{
+    Eskf f;
+    EXPECT_EQ(f.update_mag(Vec3::Zero()), EskfStatus::REJECTED);
+    EXPECT_EQ(f.update_mag(Vec3(0.0f, 0.0f, 1.0f)), EskfStatus::REJECTED); /* pole pionowe */
+    EXPECT_EQ(f.update_baro(std::nanf("")), EskfStatus::REJECTED);
+}
+
+TEST(Eskf, NoHeapAllocation)
+{
+    Eskf f; /* obiekt na stosie — sam Eskf nie alokuje */
+
+    Eigen::internal::set_is_malloc_allowed(false);
+    f.init(test_config(), quat_from_euler(0.1f, 0.2f, 0.3f));
+    f.set_mag_reference(Vec3(0.2f, 0.0f, 0.45f));
+    for (int i = 0; i < 10; ++i)
+    {
+        (void)f.predict(make_delta(Vec3(0.1f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, -9.8f), kDt));
+        (void)f.update_baro(0.0f);
+        (void)f.update_mag(Vec3(0.2f, 0.0f, 0.45f));
+    }
+    Eigen::internal::set_is_malloc_allowed(true);
+
+    SUCCEED();
+}
@@ -7,6 +7,7 @@
  *   - Raw-to-SI unit conversion accuracy
  *   - Temperature conversion
  *   - Configuration register value assembly
+ *   - FIFO timestamp reconstruction, across the host clock wrap
  *
  * The actual SPI communication is hardware-dependent and tested through
  * integration tests on the target board.
@@ -16,6 +17,9 @@
 #include <cstdint>
 #include <gtest/gtest.h>
 #include <limits>
+#include <vector>
+
+#include "drivers/iim42653_math.h"
 
 /* ── Constants matching the driver ────────────────────────────────────── */
 
@@ -655,20 +659,23 @@ TEST(ImuFifoTemp, InvalidMarker)
  * ═══════════════════════════════════════════════════════════════════════════ */
 
 /**
- * Reconstruct absolute timestamps from sensor 16-bit timestamps,
- * mirroring the driver's algorithm. Operates in-place on an array
- * of (valid_count) raw sensor timestamps + a host reference time.
+ * Reconstruct absolute timestamps from sensor 16-bit timestamps with the
+ * driver's per-step math (iim42653_math.h), walking the batch the way
+ * read_fifo() does. Operates in-place on an array of (valid_count) raw
+ * sensor timestamps + a host reference time.
  *
  * Raw deltas are scaled by 32/30 per datasheet §12.7 (no CLKIN,
  * TMST_RES=0): the sensor's internal counter runs at 30/32 speed.
+ * wrap_us is the host clock period (0 = 2^32).
  */
-static void reconstruct_timestamps(uint32_t *ts_us, size_t count, uint32_t host_time)
+static void reconstruct_timestamps(uint32_t *ts_us, size_t count, uint32_t host_time,
+                                   uint32_t wrap_us = 0)
 {
     if (count == 0)
         return;
 
     /* Save raw 16-bit sensor timestamps before overwriting. */
-    auto *raw = new uint16_t[count];
+    std::vector<uint16_t> raw(count);
     for (size_t i = 0; i < count; ++i)
     {
         raw[i] = static_cast<uint16_t>(ts_us[i] & 0xFFFF);
@@ -680,12 +687,9 @@ static void reconstruct_timestamps(uint32_t *ts_us, size_t count, uint32_t host_
     /* Walk backward, computing scaled deltas from sensor timestamps. */
     for (size_t i = count - 1; i > 0; --i)
     {
-        const uint16_t raw_delta = static_cast<uint16_t>(raw[i] - raw[i - 1]);
-        const uint32_t delta     = (static_cast<uint32_t>(raw_delta) * 32U + 15U) / 30U;
-        ts_us[i - 1]             = ts_us[i] - delta;
+        const uint32_t delta = acs::iim42653::fifo_delta_us(raw[i - 1], raw[i]);
+        ts_us[i - 1]         = acs::iim42653::backdate_us(ts_us[i], delta, wrap_us);
     }
-
-    delete[] raw;
 }
 
 TEST(ImuFifoTimestamp, ThreeSamplesNoWrap)
@@ -760,6 +764,33 @@ TEST(ImuFifoTimestamp, TenSamplesUniform)
     }
 }
 
+TEST(ImuFifoTimestamp, BatchStraddlesHostClockWrap)
+{
+    /*
+     * timestamp_us() = CYCCNT / 550 wraps every 7809031 µs at 550 MHz.
+     * 16 samples at 8 kHz (raw 117 → (117 * 32 + 15) / 30 = 125 µs),
+     * newest stamped 600 µs after the wrap: the 11 older samples belong
+     * just below the period, not near 2^32.
+     */
+    constexpr uint32_t kWrapUs   = static_cast<uint32_t>(0x100000000ULL / 550U);
+    const uint32_t     host_time = 600;
+    uint32_t           ts[16];
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        ts[i] = 60000 + i * 117; /* przepelnienie licznika czujnika po drodze */
+    }
+
+    reconstruct_timestamps(ts, 16, host_time, kWrapUs);
+
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        EXPECT_LT(ts[i], kWrapUs) << "sample " << i;
+        EXPECT_EQ(ts[i], (host_time + kWrapUs - (15 - i) * 125) % kWrapUs) << "sample " << i;
+    }
+    EXPECT_EQ(ts[10], kWrapUs - 25); /* ostatnia przed przepelnieniem */
+    EXPECT_EQ(ts[11], 100U);
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  * Tests: FIFO Configuration Register Assembly
  * ═══════════════════════════════════════════════════════════════════════════ */
@@ -0,0 +1,283 @@
+/**
+ * @file test_imu_decimator.cpp
+ * @brief Unit tests for the IMU decimating anti-alias filter.
+ *
+ * Covers:
+ *   - Windowed-sinc design (unity DC gain, symmetry)
+ *   - Factor validation and passthrough
+ *   - BOXCAR (CIC-1): output rate, exact mean, window-centre timestamps
+ *   - FIR: DC exactness, passband gain, alias rejection, linear phase
+ *     (ramp input reproduced at the delay-compensated timestamp)
+ *   - output timestamps across the DWT µs clock wrap (~7.8 s)
+ *   - SensorHub wiring: full-rate and 1 kHz histories
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "sensors/imu_decimator.h"
+#include "sensors/sensor_hub.h"
+
+using acs::DecimatorKind;
+using acs::ImuDecimator;
+using acs::ImuReading;
+
+namespace
+{
+
+constexpr double kPi = 3.14159265358979323846;
+
+ImuReading make(uint32_t ts, float value)
+{
+    ImuReading r{};
+    r.timestamp_us = ts;
+    r.accel_mps2   = {value, 2.0f * value, -value};
+    r.gyro_rads    = {value, 0.5f * value, 0.0f};
+    r.temp_c       = 30.0f;
+    return r;
+}
+
+/* Peak |gyro_x| of the decimated output for a sine at freq_hz (after warm-up). */
+float decimated_peak(DecimatorKind kind, uint8_t factor, double freq_hz)
+{
+    ImuDecimator dec;
+    EXPECT_TRUE(dec.configure(factor, kind));
+
+    const double odr  = 1000.0 * factor;
+    float        peak = 0.0f;
+    for (int n = 0; n < 4000 * factor; ++n)
+    {
+        const auto ts = static_cast<uint32_t>(std::lround(n * 1e6 / odr));
+        const auto v  = static_cast<float>(std::sin(2.0 * kPi * freq_hz * n / odr));
+        ImuReading out;
+        if (dec.push(make(ts, v), out) && n > 200 * factor)
+        {
+            peak = std::max(peak, std::fabs(out.gyro_rads[0]));
+        }
+    }
+    return peak;
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Filter design
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(DecimatorDesign, UnityDcGainAndSymmetric)
+{
+    float taps[48];
+    acs::design_lowpass(taps, 48, 0.05f);
+
+    double sum = 0.0;
+    for (float t : taps)
+    {
+        sum += t;
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-5);
+    for (int i = 0; i < 24; ++i)
+    {
+        EXPECT_FLOAT_EQ(taps[i], taps[47 - i]);
+    }
+}
+
+TEST(DecimatorDesign, SingleTapIsIdentity)
+{
+    float tap = 0.0f;
+    acs::design_lowpass(&tap, 1, 0.1f);
+    EXPECT_FLOAT_EQ(tap, 1.0f);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Configuration
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(ImuDecimator, RejectsOutOfRangeFactor)
+{
+    ImuDecimator dec;
+    EXPECT_FALSE(dec.configure(0, DecimatorKind::FIR));
+    EXPECT_FALSE(dec.configure(acs::kDecimMaxFactor + 1, DecimatorKind::FIR));
+    EXPECT_EQ(dec.factor(), 1);
+}
+
+TEST(ImuDecimator, FactorOneIsPassthrough)
+{
+    ImuDecimator dec;
+    ASSERT_TRUE(dec.configure(1, DecimatorKind::FIR));
+    for (uint32_t n = 0; n < 10; ++n)
+    {
+        ImuReading out;
+        ASSERT_TRUE(dec.push(make(n * 1000, static_cast<float>(n)), out));
+        EXPECT_EQ(out.timestamp_us, n * 1000);
+        EXPECT_FLOAT_EQ(out.accel_mps2[1], 2.0f * static_cast<float>(n));
+    }
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * BOXCAR (first-order CIC)
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(ImuDecimatorBoxcar, OneOutputPerFactorWithExactMean)
+{
+    ImuDecimator dec;
+    ASSERT_TRUE(dec.configure(4, DecimatorKind::BOXCAR));
+
+    int outputs = 0;
+    for (uint32_t n = 0; n < 40; ++n)
+    {
+        ImuReading out;
+        if (dec.push(make(n * 250, static_cast<float>(n)), out))
+        {
+            ++outputs;
+            /* Mean of n-3..n, timestamp at window centre */
+            const float mean = static_cast<float>(n) - 1.5f;
+            EXPECT_FLOAT_EQ(out.gyro_rads[0], mean);
+            EXPECT_FLOAT_EQ(out.accel_mps2[2], -mean);
+            EXPECT_EQ(out.timestamp_us, (n - 3) * 250 + 375);
+        }
+    }
+    EXPECT_EQ(outputs, 10);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * FIR
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(ImuDecimatorFir, ConstantInputIsExactFromFirstOutput)
+{
+    ImuDecimator dec;
+    ASSERT_TRUE(dec.configure(8, DecimatorKind::FIR));
+    EXPECT_EQ(dec.taps(), acs::kTapsPerPhase * 8);
+
+    for (uint32_t n = 0; n < 64; ++n)
+    {
+        ImuReading out;
+        if (dec.push(make(n * 125, 3.0f), out))
+        {
+            EXPECT_NEAR(out.gyro_rads[0], 3.0f, 1e-5f);
+            EXPECT_NEAR(out.accel_mps2[1], 6.0f, 1e-5f);
+            EXPECT_FLOAT_EQ(out.temp_c, 30.0f);
+        }
+    }
+}
+
+TEST(ImuDecimatorFir, PassbandNearUnity)
+{
+    EXPECT_NEAR(decimated_peak(DecimatorKind::FIR, 8, 40.0), 1.0f, 0.03f);
+    EXPECT_NEAR(decimated_peak(DecimatorKind::FIR, 4, 40.0), 1.0f, 0.03f);
+}
+
+TEST(ImuDecimatorFir, RejectsAliasingVibration)
+{
+    /* 3 kHz at 8 kHz ODR would alias to 0 Hz (3000 mod 1000) after naive
+     * 8:1 subsampling. The FIR must suppress it by > 30 dB; the boxcar only
+     * partially. */
+    const float fir = decimated_peak(DecimatorKind::FIR, 8, 3010.0);
+    const float box = decimated_peak(DecimatorKind::BOXCAR, 8, 3010.0);
+    EXPECT_LT(fir, 0.03f);
+    EXPECT_LT(fir, box);
+
+    /* Just above the output Nyquist at 4 kHz ODR */
+    EXPECT_LT(decimated_peak(DecimatorKind::FIR, 4, 1490.0), 0.03f);
+}
+
+TEST(ImuDecimatorFir, TimestampCompensatesGroupDelay)
+{
+    /* Linear-phase FIR reproduces a ramp exactly at (t - delay); the output
+     * timestamp must point at that instant. */
+    ImuDecimator dec;
+    ASSERT_TRUE(dec.configure(4, DecimatorKind::FIR));
+
+    const float slope = 1e-3f; /* value per µs */
+    for (uint32_t n = 0; n < 400; ++n)
+    {
+        const uint32_t ts = 10000 + n * 250;
+        ImuReading     out;
+        if (dec.push(make(ts, slope * static_cast<float>(ts)), out) && n > dec.taps())
+        {
+            EXPECT_NEAR(out.gyro_rads[0], slope * static_cast<float>(out.timestamp_us), 2e-3f);
+        }
+    }
+}
+
+TEST(ImuDecimator, TimestampsFollowClockWrap)
+{
+    /* TIMESTAMP_WRAP_US at 550 MHz: DWT µs clock wraps every ~7.8 s */
+    constexpr uint32_t kWrapUs = static_cast<uint32_t>(0x100000000ULL / 550U);
+
+    /* Start ~20 ms przed wrapem, tak by wrap wypadl w srodku okna boxcar /
+     * miedzy dwiema probkami srodka FIR */
+    const struct
+    {
+        DecimatorKind kind;
+        uint32_t      lead_us;
+    } cases[] = {{DecimatorKind::BOXCAR, 20500}, {DecimatorKind::FIR, 20000}};
+
+    for (const auto &c : cases)
+    {
+        const DecimatorKind kind = c.kind;
+        const uint32_t      kT0  = kWrapUs - c.lead_us;
+        ImuDecimator        dec;
+        ASSERT_TRUE(dec.configure(8, kind, kWrapUs));
+
+        uint32_t prev    = 0;
+        int      outputs = 0;
+        for (uint32_t n = 0; n < 8 * 60; ++n) /* 60 ms, 8 kHz */
+        {
+            const uint32_t ts = (kT0 + n * 125) % kWrapUs;
+            ImuReading     out;
+            if (!dec.push(make(ts, 1.0f), out))
+            {
+                continue;
+            }
+            EXPECT_LT(out.timestamp_us, kWrapUs) << "n=" << n;
+            if (outputs > 6) /* FIR: historia zalana pierwsza probka */
+            {
+                const uint32_t dt = (out.timestamp_us >= prev)
+                                        ? out.timestamp_us - prev
+                                        : out.timestamp_us + (kWrapUs - prev);
+                EXPECT_EQ(dt, 1000u) << "n=" << n;
+            }
+            prev = out.timestamp_us;
+            ++outputs;
+        }
+        EXPECT_EQ(outputs, 60);
+    }
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * SensorHub wiring
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(SensorHubDecimation, FullRateAndNavStreams)
+{
+    acs::SensorHub hub;
+    ASSERT_TRUE(hub.configure_imu_decimation(8, DecimatorKind::FIR));
+
+    acs::SampleCursor raw = hub.imu_history().subscribe();
+    acs::SampleCursor nav = hub.imu_nav_history().subscribe();
+
+    std::vector<ImuReading> burst(32);
+    for (uint32_t i = 0; i < 32; ++i)
+    {
+        burst[i] = make(i * 125, 1.0f);
+    }
+    hub.update_imu_batch(burst.data(), burst.size());
+
+    EXPECT_EQ(hub.imu_history().available(raw), 32u);
+    EXPECT_EQ(hub.imu_nav_history().available(nav), 4u);
+
+    const auto s = hub.snapshot();
+    EXPECT_TRUE(s.imu_valid);
+    EXPECT_NEAR(s.gyro_rads[0], 1.0f, 1e-5f);
+}
+
+TEST(SensorHubDecimation, RejectedFactorKeepsPrevious)
+{
+    acs::SensorHub hub;
+    ASSERT_TRUE(hub.configure_imu_decimation(4, DecimatorKind::BOXCAR));
+    EXPECT_FALSE(hub.configure_imu_decimation(9, DecimatorKind::FIR));
+    EXPECT_EQ(hub.imu_decimator().factor(), 4);
+}
@@ -0,0 +1,554 @@
+/**
+ * @file test_imu_delta_codec.cpp
+ * @brief Unit tests for the delta-encoded IMU log records.
+ *
+ * Coverage:
+ *   - zig-zag / varint primitives (boundaries, truncation)
+ *   - quantization to LogImu units (rounding, saturation)
+ *   - keyframe cadence, forced keyframes, record sizes
+ *   - compression ratio on a realistic 1 kHz stream
+ *   - fuzz round-trip: random walks with full-range jumps, irregular dt
+ *     and timestamp wrap decode bit-exactly
+ *   - resync at the next keyframe after a lost record / mid-stream start
+ *   - IMU_BLOCK: grid / capacity closing, size, round trip, malformed
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include "logger/imu_delta_codec.h"
+
+using namespace acs;
+
+namespace
+{
+
+bool same(const ImuFixed &a, const ImuFixed &b)
+{
+    return a.timestamp_us == b.timestamp_us && memcmp(a.accel, b.accel, sizeof(a.accel)) == 0 &&
+           memcmp(a.gyro, b.gyro, sizeof(a.gyro)) == 0;
+}
+
+/* Koduje strumien do jednego bufora (jak plik logu) */
+std::vector<uint8_t> encode_all(ImuDeltaEncoder &enc, const std::vector<ImuFixed> &in)
+{
+    std::vector<uint8_t> out;
+    uint8_t              rec[LOG_MAX_RECORD_SIZE];
+    for (const auto &s : in)
+    {
+        const size_t n = enc.encode(s, rec);
+        EXPECT_LE(n, LOG_MAX_RECORD_SIZE);
+        out.insert(out.end(), rec, rec + n);
+    }
+    return out;
+}
+
+std::vector<ImuFixed> decode_all(const std::vector<uint8_t> &buf, size_t *undecoded = nullptr)
+{
+    ImuDeltaDecoder       dec;
+    std::vector<ImuFixed> out;
+    size_t                pos = 0;
+    size_t                skipped = 0;
+    while (pos < buf.size())
+    {
+        ImuFixed s{};
+        size_t   used = 0;
+        if (dec.decode(&buf[pos], buf.size() - pos, s, used))
+        {
+            out.push_back(s);
+        }
+        else
+        {
+            ++skipped;
+        }
+        if (used == 0)
+        {
+            break;
+        }
+        pos += used;
+    }
+    if (undecoded != nullptr)
+    {
+        *undecoded = skipped;
+    }
+    return out;
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Primitives
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(ImuDeltaCodec, ZigzagMapsSmallMagnitudesToSmallCodes)
+{
+    static_assert(zigzag_encode(0) == 0);
+    static_assert(zigzag_encode(-1) == 1);
+    static_assert(zigzag_encode(1) == 2);
+    static_assert(zigzag_encode(-64) == 127);
+    static_assert(zigzag_decode(zigzag_encode(INT32_MIN)) == INT32_MIN);
+    static_assert(zigzag_decode(zigzag_encode(INT32_MAX)) == INT32_MAX);
+    EXPECT_EQ(zigzag_encode(INT32_MIN), 0xFFFFFFFFU);
+}
+
+TEST(ImuDeltaCodec, VarintLengthsAndTruncation)
+{
+    const uint32_t kValues[] = {0, 127, 128, 16383, 16384, 0x0FFFFFFFU, 0xFFFFFFFFU};
+    const size_t   kLens[]   = {1, 1, 2, 2, 3, 4, 5};
+
+    for (size_t i = 0; i < sizeof(kValues) / sizeof(kValues[0]); ++i)
+    {
+        uint8_t buf[5];
+        ASSERT_EQ(varint_put(kValues[i], buf), kLens[i]);
+
+        uint32_t v = 0;
+        EXPECT_EQ(varint_get(buf, kLens[i], v), kLens[i]);
+        EXPECT_EQ(v, kValues[i]);
+        EXPECT_EQ(varint_get(buf, kLens[i] - 1, v), 0U) << "truncated must fail";
+    }
+
+    /* Szesc bajtow kontynuacji — nie varint32 */
+    const uint8_t bad[6] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x01};
+    uint32_t      v      = 0;
+    EXPECT_EQ(varint_get(bad, sizeof(bad), v), 0U);
+}
+
+TEST(ImuDeltaCodec, QuantizesToLogImuUnitsWithSaturation)
+{
+    ImuReading r{};
+    r.timestamp_us = 42;
+    r.accel_mps2   = {9.80665f, -0.0004f, 100.0f};
+    r.gyro_rads    = {0.126f, -3.0f, -1000.0f};
+
+    const ImuFixed f = imu_fixed_from(r);
+    EXPECT_EQ(f.timestamp_us, 42U);
+    EXPECT_EQ(f.accel[0], 9807);
+    EXPECT_EQ(f.accel[1], 0);
+    EXPECT_EQ(f.accel[2], 32767);
+    EXPECT_EQ(f.gyro[0], 13);
+    EXPECT_EQ(f.gyro[1], -300);
+    EXPECT_EQ(f.gyro[2], -32768);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Encoder
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(ImuDeltaCodec, KeyframeCadenceAndRecordSizes)
+{
+    ImuDeltaEncoder enc(4);
+    uint8_t         rec[LOG_MAX_RECORD_SIZE];
+    ImuFixed        s{1000, {0, 0, 9807}, {1, -1, 0}};
+
+    std::vector<size_t> sizes;
+    for (int i = 0; i < 9; ++i)
+    {
+        sizes.push_back(enc.encode(s, rec));
+        s.timestamp_us += 1000;
+    }
+
+    /* Klatka co 4 probki; pierwsza delta niesie dt = 1000 (2 bajty) */
+    const std::vector<size_t> kExpected = {17, 9, 8, 8, 17, 9, 8, 8, 17};
+    EXPECT_EQ(sizes, kExpected);
+
+    enc.force_keyframe();
+    EXPECT_EQ(enc.encode(s, rec), sizeof(LogImu));
+    EXPECT_EQ(rec[0], static_cast<uint8_t>(LogMsgId::IMU));
+}
+
+TEST(ImuDeltaCodec, WorstCaseDeltaFitsMaxSize)
+{
+    ImuDeltaEncoder enc;
+    uint8_t         rec[LOG_MAX_RECORD_SIZE];
+
+    const ImuFixed lo{0, {-32768, -32768, -32768}, {-32768, -32768, -32768}};
+    const ImuFixed hi{0x80000000U, {32767, 32767, 32767}, {32767, 32767, 32767}};
+    (void)enc.encode(lo, rec);
+    const size_t n = enc.encode(hi, rec);
+    EXPECT_EQ(n, LOG_IMU_DELTA_MAX_SIZE);
+    EXPECT_EQ(rec[0], static_cast<uint8_t>(LogMsgId::IMU_DELTA));
+}
+
+TEST(ImuDeltaCodec, RealisticStreamHalvesBytesPerSample)
+{
+    /* 1 kHz, jitter ±2 µs, szum akcelerometru ~20 mg, gyro ~0.02 rad/s */
+    std::mt19937                    rng(7);
+    std::normal_distribution<float> acc_noise(0.0f, 0.02f);
+    std::normal_distribution<float> gyr_noise(0.0f, 0.02f);
+    std::uniform_int_distribution<int> jitter(-2, 2);
+
+    constexpr int         kSamples = 10000;
+    std::vector<ImuFixed> in;
+    for (int i = 0; i < kSamples; ++i)
+    {
+        ImuReading r{};
+        r.timestamp_us = static_cast<uint32_t>(1000 * i + jitter(rng));
+        r.accel_mps2   = {acc_noise(rng), acc_noise(rng), 9.80665f + acc_noise(rng)};
+        r.gyro_rads    = {gyr_noise(rng), gyr_noise(rng), 0.5f + gyr_noise(rng)};
+        in.push_back(imu_fixed_from(r));
+    }
+
+    ImuDeltaEncoder enc;
+    const auto      buf = encode_all(enc, in);
+
+    const double per_sample = static_cast<double>(buf.size()) / kSamples;
+    EXPECT_LT(per_sample, 0.55 * sizeof(LogImu)) << per_sample << " B/sample";
+
+    const auto out = decode_all(buf);
+    ASSERT_EQ(out.size(), in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        ASSERT_TRUE(same(in[i], out[i])) << "sample " << i;
+    }
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Fuzz round-trip
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(ImuDeltaCodec, FuzzRoundTripIsBitExact)
+{
+    std::mt19937 rng(12345);
+
+    for (int trial = 0; trial < 200; ++trial)
+    {
+        std::uniform_int_distribution<int> len_dist(1, 600);
+        std::uniform_int_distribution<int> step_kind(0, 9);
+        std::uniform_int_distribution<int> small(-50, 50);
+        std::uniform_int_distribution<int> full(-32768, 32767);
+        std::uniform_int_distribution<uint32_t> any32;
+        std::uniform_int_distribution<uint32_t> dt_dist(100, 5000);
+        std::uniform_int_distribution<int>      interval(1, 200);
+
+        /* Start tuz przed przepelnieniem licznika co kilka prob */
+        ImuFixed s{(trial % 3 == 0) ? 0xFFFF0000U : any32(rng), {}, {}};
+        for (size_t i = 0; i < 3; ++i)
+        {
+            s.accel[i] = static_cast<int16_t>(full(rng));
+            s.gyro[i]  = static_cast<int16_t>(full(rng));
+        }
+
+        std::vector<ImuFixed> in;
+        const int             n = len_dist(rng);
+        for (int k = 0; k < n; ++k)
+        {
+            in.push_back(s);
+
+            const int kind = step_kind(rng);
+            s.timestamp_us += (kind == 0) ? any32(rng) : dt_dist(rng);
+            for (size_t i = 0; i < 3; ++i)
+            {
+                const int da = (kind == 1) ? full(rng) : s.accel[i] + small(rng);
+                const int dg = (kind == 2) ? full(rng) : s.gyro[i] + small(rng);
+                s.accel[i]   = static_cast<int16_t>(std::clamp(da, -32768, 32767));
+                s.gyro[i]    = static_cast<int16_t>(std::clamp(dg, -32768, 32767));
+            }
+        }
+
+        ImuDeltaEncoder enc(static_cast<uint16_t>(interval(rng)));
+        const auto      buf = encode_all(enc, in);
+        const auto      out = decode_all(buf);
+
+        ASSERT_EQ(out.size(), in.size()) << "trial " << trial;
+        for (size_t i = 0; i < in.size(); ++i)
+        {
+            ASSERT_TRUE(same(in[i], out[i])) << "trial " << trial << " sample " << i;
+        }
+    }
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Resync
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(ImuDeltaCodec, DropForcesKeyframeAndDecoderResyncs)
+{
+    ImuDeltaEncoder      enc(1000);
+    std::vector<uint8_t> file;
+    uint8_t              rec[LOG_MAX_RECORD_SIZE];
+
+    std::vector<ImuFixed> kept;
+    ImuFixed              s{5000, {10, 20, 30}, {-1, -2, -3}};
+    for (int i = 0; i < 50; ++i)
+    {
+        const size_t n = enc.encode(s, rec);
+        if (i == 20)
+        {
+            /* logger_log() odrzucil rekord → producent wymusza klatke */
+            enc.force_keyframe();
+        }
+        else
+        {
+            file.insert(file.end(), rec, rec + n);
+            kept.push_back(s);
+        }
+        s.timestamp_us += 1000;
+        s.accel[0] = static_cast<int16_t>(s.accel[0] + 3);
+    }
+
+    const auto out = decode_all(file);
+    ASSERT_EQ(out.size(), kept.size());
+    for (size_t i = 0; i < kept.size(); ++i)
+    {
+        EXPECT_TRUE(same(kept[i], out[i])) << "sample " << i;
+    }
+}
+
+TEST(ImuDeltaCodec, MidStreamStartSkipsDeltasUntilKeyframe)
+{
+    ImuDeltaEncoder       enc(10);
+    std::vector<ImuFixed> in;
+    for (uint32_t i = 0; i < 30; ++i)
+    {
+        in.push_back({i * 1000U, {static_cast<int16_t>(i), 0, 0}, {0, 0, 0}});
+    }
+    const auto buf = encode_all(enc, in);
+
+    /* Odetnij klatke 0 i trzy pierwsze delty (jak nadpisany bufor RAM logu) */
+    const size_t cut = sizeof(LogImu) + 9 + 8 + 8;
+    size_t       undecoded = 0;
+    const auto   out =
+        decode_all(std::vector<uint8_t>(buf.begin() + static_cast<long>(cut), buf.end()),
+                   &undecoded);
+
+    EXPECT_EQ(undecoded, 6U); /* delty 4..9 */
+    ASSERT_EQ(out.size(), 20U);
+    EXPECT_TRUE(same(out.front(), in[10]));
+    EXPECT_TRUE(same(out.back(), in[29]));
+}
+
+TEST(ImuDeltaCodec, DecoderRejectsTruncatedAndForeignRecords)
+{
+    ImuDeltaDecoder dec;
+    ImuFixed        s{};
+    size_t          used = 1;
+
+    const uint8_t nav[1] = {static_cast<uint8_t>(LogMsgId::NAV)};
+    EXPECT_FALSE(dec.decode(nav, 1, s, used));
+    EXPECT_EQ(used, 0U);
+
+    const uint8_t key[4] = {static_cast<uint8_t>(LogMsgId::IMU), 0, 0, 0};
+    EXPECT_FALSE(dec.decode(key, sizeof(key), s, used));
+    EXPECT_EQ(used, 0U);
+
+    /* Delta urwana w polowie trzeciego pola */
+    const uint8_t delta[4] = {static_cast<uint8_t>(LogMsgId::IMU_DELTA), 0x00, 0x02, 0x80};
+    EXPECT_FALSE(dec.decode(delta, sizeof(delta), s, used));
+    EXPECT_EQ(used, 0U);
+    EXPECT_FALSE(dec.synced());
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  IMU block
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+namespace
+{
+
+/* Pakuje strumien w bloki tak jak SensorLogThread */
+std::vector<uint8_t> encode_blocks(const std::vector<ImuFixed> &in, size_t *blocks = nullptr)
+{
+    ImuBlockEncoder      enc;
+    std::vector<uint8_t> out;
+    size_t               nblk  = 0;
+    auto                 flush = [&]() {
+        if (enc.count() > 0)
+        {
+            out.insert(out.end(), enc.data(), enc.data() + enc.size());
+            enc.clear();
+            ++nblk;
+        }
+    };
+    for (const auto &s : in)
+    {
+        if (!enc.fits(s))
+        {
+            flush();
+        }
+        enc.append(s);
+        if (enc.full())
+        {
+            flush();
+        }
+    }
+    flush();
+    if (blocks != nullptr)
+    {
+        *blocks = nblk;
+    }
+    return out;
+}
+
+std::vector<ImuFixed> decode_blocks(const std::vector<uint8_t> &buf)
+{
+    std::vector<ImuFixed> out;
+    ImuFixed              tmp[LOG_IMU_BLOCK_MAX_SAMPLES];
+    size_t                pos = 0;
+    while (pos < buf.size())
+    {
+        size_t       n   = 0;
+        const size_t len = imu_block_decode(&buf[pos], buf.size() - pos, tmp, n);
+        EXPECT_GT(len, 0U) << "at " << pos;
+        if (len == 0)
+        {
+            break;
+        }
+        out.insert(out.end(), tmp, tmp + n);
+        pos += len;
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST(ImuBlockCodec, SteadyStreamPacksFullBlocks)
+{
+    std::vector<ImuFixed> in;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        in.push_back({7000U + 1000U * i, {0, 1, 9807}, {2, 0, -1}});
+    }
+
+    size_t     blocks = 0;
+    const auto buf    = encode_blocks(in, &blocks);
+    EXPECT_EQ(blocks, 4U); /* 32 + 32 + 32 + 4 */
+
+    /* Pelny blok przy stalych wartosciach: 22 + 31 × 6 bajtow */
+    EXPECT_EQ(buf.size(), 3 * (sizeof(LogImuBlock) + 31 * 6) + sizeof(LogImuBlock) + 3 * 6);
+
+    LogImuBlock hdr;
+    memcpy(&hdr, buf.data(), sizeof(hdr));
+    EXPECT_EQ(hdr.hdr.msg_id, static_cast<uint8_t>(LogMsgId::IMU_BLOCK));
+    EXPECT_EQ(hdr.period_us, 1000);
+    EXPECT_EQ(hdr.count, 32);
+
+    const auto out = decode_blocks(buf);
+    ASSERT_EQ(out.size(), in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        EXPECT_TRUE(same(in[i], out[i])) << "sample " << i;
+    }
+}
+
+TEST(ImuBlockCodec, ClosesBlockWhenSampleLeavesPeriodGrid)
+{
+    ImuBlockEncoder enc;
+    enc.append({0, {}, {}});
+    enc.append({1000, {}, {}});
+    EXPECT_TRUE(enc.fits({2000 + kImuBlockJitterUs, {}, {}}));
+    EXPECT_TRUE(enc.fits({2000 - kImuBlockJitterUs, {}, {}}));
+    EXPECT_FALSE(enc.fits({2000 + kImuBlockJitterUs + 1, {}, {}}));
+    EXPECT_FALSE(enc.fits({3000, {}, {}})) << "dropped sample";
+
+    /* Druga probka nie moze miec dt = 0 ani przekraczac uint16 */
+    ImuBlockEncoder one;
+    one.append({500, {}, {}});
+    EXPECT_FALSE(one.fits({500, {}, {}}));
+    EXPECT_FALSE(one.fits({500 + 65536, {}, {}}));
+    EXPECT_TRUE(one.fits({500 + 65535, {}, {}}));
+}
+
+TEST(ImuBlockCodec, WorstCaseBlockFitsMaxRecord)
+{
+    ImuBlockEncoder enc;
+    for (size_t k = 0; k < LOG_IMU_BLOCK_MAX_SAMPLES; ++k)
+    {
+        const int16_t v = (k % 2 == 0) ? int16_t{-32768} : int16_t{32767};
+        const ImuFixed s{0xFFFFFF00U + 250U * static_cast<uint32_t>(k), {v, v, v}, {v, v, v}};
+        ASSERT_TRUE(enc.fits(s));
+        enc.append(s);
+    }
+    EXPECT_TRUE(enc.full());
+    EXPECT_EQ(enc.size(), LOG_IMU_BLOCK_MAX_SIZE);
+    EXPECT_LE(enc.size(), LOG_MAX_RECORD_SIZE);
+
+    ImuFixed     out[LOG_IMU_BLOCK_MAX_SAMPLES];
+    size_t       n   = 0;
+    const size_t len = imu_block_decode(enc.data(), enc.size(), out, n);
+    EXPECT_EQ(len, enc.size());
+    ASSERT_EQ(n, LOG_IMU_BLOCK_MAX_SAMPLES);
+    EXPECT_EQ(out[31].timestamp_us, 0xFFFFFF00U + 250U * 31U); /* przez zero */
+    EXPECT_EQ(out[31].gyro[2], 32767);
+}
+
+TEST(ImuBlockCodec, FuzzRoundTripWithJitterAndGaps)
+{
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int>      small(-40, 40);
+    std::uniform_int_distribution<int>      full(-32768, 32767);
+    std::uniform_int_distribution<int>      kind(0, 19);
+    std::uniform_int_distribution<int>      jitter(-static_cast<int>(kImuBlockJitterUs),
+                                                   static_cast<int>(kImuBlockJitterUs));
+    std::uniform_int_distribution<uint32_t> any32;
+
+    for (int trial = 0; trial < 100; ++trial)
+    {
+        std::vector<ImuFixed> in;
+        ImuFixed              s{any32(rng), {}, {}};
+        const uint32_t        period = 125U << (trial % 4); /* 8 / 4 / 2 / 1 kHz */
+        uint32_t              grid   = s.timestamp_us;
+
+        for (int k = 0; k < 500; ++k)
+        {
+            in.push_back(s);
+            const int kd = kind(rng);
+            grid += (kd == 0) ? period * 3 : period; /* czasem luka */
+            s.timestamp_us = grid + static_cast<uint32_t>(jitter(rng));
+            for (size_t i = 0; i < 3; ++i)
+            {
+                const int a = (kd == 1) ? full(rng) : s.accel[i] + small(rng);
+                const int g = (kd == 2) ? full(rng) : s.gyro[i] + small(rng);
+                s.accel[i]  = static_cast<int16_t>(std::clamp(a, -32768, 32767));
+                s.gyro[i]   = static_cast<int16_t>(std::clamp(g, -32768, 32767));
+            }
+        }
+
+        const auto out = decode_blocks(encode_blocks(in));
+        ASSERT_EQ(out.size(), in.size()) << "trial " << trial;
+        for (size_t i = 0; i < in.size(); ++i)
+        {
+            /* Wartosci dokladnie, czas na siatce bloku w granicy jittera */
+            ASSERT_EQ(memcmp(out[i].accel, in[i].accel, sizeof(in[i].accel)), 0);
+            ASSERT_EQ(memcmp(out[i].gyro, in[i].gyro, sizeof(in[i].gyro)), 0);
+            const auto dev = static_cast<int32_t>(out[i].timestamp_us - in[i].timestamp_us);
+            ASSERT_LE(std::abs(dev), static_cast<int32_t>(kImuBlockJitterUs))
+                << "trial " << trial << " sample " << i;
+        }
+    }
+}
+
+TEST(ImuBlockCodec, RejectsMalformedBlocks)
+{
+    ImuBlockEncoder enc;
+    for (uint32_t k = 0; k < 5; ++k)
+    {
+        enc.append({1000U * k, {static_cast<int16_t>(k * 100), 0, 0}, {0, 0, 0}});
+    }
+    std::vector<uint8_t> rec(enc.data(), enc.data() + enc.size());
+
+    ImuFixed out[LOG_IMU_BLOCK_MAX_SAMPLES];
+    size_t   n = 0;
+    ASSERT_EQ(imu_block_decode(rec.data(), rec.size(), out, n), rec.size());
+
+    /* Urwany rekord */
+    EXPECT_EQ(imu_block_decode(rec.data(), rec.size() - 1, out, n), 0U);
+    EXPECT_EQ(n, 0U);
+
+    /* count wiekszy niz dane w payload */
+    auto more = rec;
+    more[7]   = 6;
+    EXPECT_EQ(imu_block_decode(more.data(), more.size(), out, n), 0U);
+
+    /* count ponad limit */
+    auto big = rec;
+    big[7]   = static_cast<uint8_t>(LOG_IMU_BLOCK_MAX_SAMPLES + 1);
+    EXPECT_EQ(imu_block_decode(big.data(), big.size(), out, n), 0U);
+
+    /* Obcy msg_id */
+    auto other = rec;
+    other[0]   = static_cast<uint8_t>(LogMsgId::IMU);
+    EXPECT_EQ(imu_block_decode(other.data(), other.size(), out, n), 0U);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file test_log2_histogram.cpp
+ * @brief Unit tests for the log2-bucketed latency histogram.
+ *
+ * Covers:
+ *   - bucket boundaries (0, powers of two, saturation into the last bucket)
+ *   - counting, max and reset
+ *   - quantile upper bounds, including clamping to the observed maximum
+ */
+
+#include <cstdint>
+#include <gtest/gtest.h>
+
+#include "utils/log2_histogram.h"
+
+using namespace acs;
+
+using Hist = Log2Histogram<20>;
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Buckets
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(Log2Histogram, BucketBoundaries)
+{
+    EXPECT_EQ(Hist::bucket_of(0), 0U);
+    EXPECT_EQ(Hist::bucket_of(1), 1U);
+    EXPECT_EQ(Hist::bucket_of(2), 2U);
+    EXPECT_EQ(Hist::bucket_of(3), 2U);
+    EXPECT_EQ(Hist::bucket_of(4), 3U);
+    EXPECT_EQ(Hist::bucket_of(1023), 10U);
+    EXPECT_EQ(Hist::bucket_of(1024), 11U);
+
+    for (size_t k = 1; k + 1 < Hist::kBuckets; ++k)
+    {
+        EXPECT_EQ(Hist::bucket_of(Hist::bucket_lo(k)), k);
+        EXPECT_EQ(Hist::bucket_of(Hist::bucket_hi(k)), k);
+    }
+}
+
+TEST(Log2Histogram, LastBucketSaturates)
+{
+    EXPECT_EQ(Hist::bucket_of(1U << 19), 19U);
+    EXPECT_EQ(Hist::bucket_of(1U << 25), 19U);
+    EXPECT_EQ(Hist::bucket_of(UINT32_MAX), 19U);
+    EXPECT_EQ(Hist::bucket_hi(19), UINT32_MAX);
+
+    EXPECT_EQ(Log2Histogram<33>::bucket_of(UINT32_MAX), 32U);
+    EXPECT_EQ(Log2Histogram<33>::bucket_hi(32), UINT32_MAX);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Counting
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(Log2Histogram, CountsTotalAndMax)
+{
+    Hist h;
+    h.add(300);
+    h.add(400);
+    h.add(120000);
+    EXPECT_EQ(h.total(), 3U);
+    EXPECT_EQ(h.max(), 120000U);
+    EXPECT_EQ(h.count(Hist::bucket_of(300)), 2U);
+    EXPECT_EQ(h.count(Hist::bucket_of(120000)), 1U);
+
+    h.reset();
+    EXPECT_EQ(h.total(), 0U);
+    EXPECT_EQ(h.max(), 0U);
+    EXPECT_EQ(h.count(Hist::bucket_of(300)), 0U);
+}
+
+TEST(Log2Histogram, QuantileUpperBound)
+{
+    Hist h;
+    EXPECT_EQ(h.quantile_upper(0.5f), 0U);
+
+    /* 99 × ~300 us, 1 × 120 ms */
+    for (int i = 0; i < 99; ++i)
+    {
+        h.add(300);
+    }
+    h.add(120000);
+
+    EXPECT_EQ(h.quantile_upper(0.5f), 511U); /* kubelek 256..511 */
+    EXPECT_EQ(h.quantile_upper(0.99f), 511U);
+    EXPECT_EQ(h.quantile_upper(1.0f), 120000U); /* 131071 obciete do max */
+}
+
+TEST(Log2Histogram, QuantileIsBucketUpperEdge)
+{
+    Hist h;
+    h.add(260);
+    h.add(5000);
+    EXPECT_EQ(h.quantile_upper(0.5f), 511U);
+    EXPECT_GE(h.quantile_upper(0.5f), 260U);
+    EXPECT_EQ(h.quantile_upper(0.9f), 5000U);
+}
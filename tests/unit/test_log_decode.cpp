@@ -0,0 +1,900 @@
+/**
+ * @file test_log_decode.cpp
+ * @brief Unit tests for the native flight log decoder (tests/tools).
+ *
+ * Covers:
+ *   - every message type through the dispatch table into its columns,
+ *     IMU from keyframes, deltas and blocks (firmware encoders)
+ *   - padding runs, unknown IDs, deltas before the first keyframe,
+ *     truncated tail, bad magic
+ *   - sparse timestamp index and seek
+ *   - CSV text (matches tools/log_decoder.py precision) and the columnar
+ *     file layout
+ *   - schema block: round trip against LOG_SCHEMA, pre-v4 fallback, message
+ *     types unknown to this build decoded (FIXED, LEN16) or skipped
+ *     (VARINTS) from the file's schema alone, corrupt blocks rejected
+ *   - CRC frames: padding between frames, a bad record inside a valid
+ *     frame, stale frames of another file; fuzzing with flipped bytes,
+ *     torn sectors and truncation — every untouched frame is recovered
+ *     and nothing from a damaged one leaks into the tables
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "log_decode.h"
+#include "logger/imu_delta_codec.h"
+
+using namespace acs;
+
+namespace
+{
+
+/* Obraz pliku logu budowany rekord po rekordzie; od v5 rekordy ida do
+ * otwartej ramki, seal() (i decode()) uzupelnia jej naglowek */
+struct LogImage
+{
+    static constexpr size_t kNoFrame = SIZE_MAX;
+
+    std::vector<uint8_t> bytes;
+    size_t               frame = kNoFrame; /* offset otwartej ramki */
+    uint32_t             seq   = 0;
+
+    /* Naglowek + blok schematu + pierwsza ramka jak w firmware */
+    LogImage() : LogImage(LOG_FORMAT_VERSION)
+    {
+        uint8_t schema[log_schema_size()];
+        append(schema, log_schema_write(schema, sizeof(schema)));
+        open_frame();
+    }
+
+    /* Sam naglowek; schemat (jesli jest) dopisuje test */
+    explicit LogImage(uint16_t version)
+    {
+        LogFileHeader h{};
+        std::memcpy(h.magic, LOG_MAGIC, sizeof(h.magic));
+        h.version      = version;
+        h.sysclk_hz    = 550000000;
+        h.boot_time_ms = 1234;
+        add(h);
+    }
+
+    template <typename Rec>
+    void add(const Rec &r)
+    {
+        append(&r, sizeof(r));
+    }
+
+    void append(const void *p, size_t n)
+    {
+        const auto *b = static_cast<const uint8_t *>(p);
+        bytes.insert(bytes.end(), b, b + n);
+    }
+
+    /* Zamyka biezaca ramke i zaczyna nastepna */
+    void open_frame()
+    {
+        seal();
+        frame = bytes.size();
+        bytes.resize(bytes.size() + sizeof(LogFrameHeader));
+    }
+
+    void seal()
+    {
+        if (frame == kNoFrame)
+        {
+            return;
+        }
+        LogFileHeader h;
+        std::memcpy(&h, bytes.data(), sizeof(h));
+        const size_t len = bytes.size() - frame - sizeof(LogFrameHeader);
+        log_frame_seal(&bytes[frame], seq++, len, log_frame_seed(h));
+        frame = kNoFrame;
+    }
+};
+
+LogHeader hdr(LogMsgId id, uint32_t t)
+{
+    return LogHeader{static_cast<uint8_t>(id), t};
+}
+
+/* Blok schematu zapisywany recznie (typy nieznane tej kompilacji) */
+struct SchemaBlock
+{
+    std::vector<uint8_t> bytes;
+
+    SchemaBlock()
+    {
+        bytes.assign(7, 0); /* magic, u16 len, u8 n_msgs */
+        std::memcpy(bytes.data(), LOG_SCHEMA_MAGIC, sizeof(LOG_SCHEMA_MAGIC));
+    }
+
+    void msg(uint8_t id, const char *name, LogLayout layout, uint8_t arg, uint8_t n_fields)
+    {
+        bytes.insert(bytes.end(), {id, static_cast<uint8_t>(layout), arg, n_fields});
+        str(name);
+        ++bytes[6];
+    }
+
+    void field(const char *name, LogFieldType type, double scale, uint8_t decimals)
+    {
+        bytes.insert(bytes.end(), {static_cast<uint8_t>(type), decimals});
+        const auto *s = reinterpret_cast<const uint8_t *>(&scale);
+        bytes.insert(bytes.end(), s, s + sizeof(scale));
+        str(name);
+    }
+
+    void str(const char *s)
+    {
+        const size_t n = std::strlen(s);
+        bytes.push_back(static_cast<uint8_t>(n));
+        bytes.insert(bytes.end(), s, s + n);
+    }
+
+    const std::vector<uint8_t> &finish()
+    {
+        const auto len = static_cast<uint16_t>(bytes.size() - 6);
+        std::memcpy(&bytes[4], &len, sizeof(len));
+        return bytes;
+    }
+};
+
+ImuFixed sample(uint32_t t, int16_t v)
+{
+    return ImuFixed{t, {v, static_cast<int16_t>(-v), 9810}, {1, 2, static_cast<int16_t>(v / 2)}};
+}
+
+DecodedLog decode(LogImage img, uint32_t index_us = 100000)
+{
+    img.seal();
+    LogDecodeOptions opt;
+    opt.index_interval_us = index_us;
+    return log_decode(img.bytes.data(), img.bytes.size(), opt);
+}
+
+std::string to_string(bool (*fn)(const LogTable &, std::FILE *), const LogTable &t)
+{
+    std::FILE *f = std::tmpfile();
+    EXPECT_NE(f, nullptr);
+    EXPECT_TRUE(fn(t, f));
+    std::string out(static_cast<size_t>(std::ftell(f)), '\0');
+    std::rewind(f);
+    EXPECT_EQ(std::fread(out.data(), 1, out.size(), f), out.size());
+    std::fclose(f);
+    return out;
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Decoding
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(LogDecode, FixedRecordsLandInTheirColumns)
+{
+    LogImage img;
+    img.add(LogNav{hdr(LogMsgId::NAV, 100), {32767, 0, -16384, 1}, {1500, -2, 300000}, {5, -6, 7}});
+    img.add(LogCtrl{hdr(LogMsgId::CTRL, 200), {150, -150, 0, 1}, 3});
+    img.add(LogBaro{hdr(LogMsgId::BARO, 300), 101325, -1250});
+    img.add(LogMag{hdr(LogMsgId::MAG, 400), {2000, -3000, 10}});
+    img.add(LogEvent{hdr(LogMsgId::EVENT, 500), 7, 0xBEEF});
+
+    const DecodedLog log = decode(img);
+    ASSERT_TRUE(log.header_ok);
+    EXPECT_EQ(log.header.boot_time_ms, 1234U);
+    EXPECT_EQ(log.records, 5U);
+    EXPECT_EQ(log.parse_errors, 0U);
+    EXPECT_EQ(log.bytes_consumed, img.bytes.size());
+
+    EXPECT_TRUE(log.schema_in_file);
+
+    const LogTable *nav = log.table("nav");
+    ASSERT_NE(nav, nullptr);
+    ASSERT_EQ(nav->rows, 1U);
+    EXPECT_EQ(nav->cols[0].raw(0), 100);
+    EXPECT_EQ(nav->cols[3].raw(0), -16384);
+    EXPECT_EQ(nav->cols[7].raw(0), 300000);
+    EXPECT_EQ(nav->cols[9].raw(0), -6);
+
+    const LogTable *ctrl = log.table("ctrl");
+    ASSERT_NE(ctrl, nullptr);
+    ASSERT_EQ(ctrl->rows, 1U);
+    EXPECT_EQ(ctrl->cols[2].raw(0), -150);
+    EXPECT_EQ(ctrl->cols[5].raw(0), 3);
+
+    const LogTable *baro = log.table("baro");
+    ASSERT_NE(baro, nullptr);
+    ASSERT_EQ(baro->rows, 1U);
+    EXPECT_EQ(baro->cols[1].raw(0), 101325);
+    EXPECT_EQ(baro->cols[2].raw(0), -1250);
+
+    const LogTable *mag = log.table("mag");
+    ASSERT_NE(mag, nullptr);
+    ASSERT_EQ(mag->rows, 1U);
+    EXPECT_EQ(mag->cols[2].raw(0), -3000);
+
+    const LogTable *events = log.table("events");
+    ASSERT_NE(events, nullptr);
+    ASSERT_EQ(events->rows, 1U);
+    EXPECT_EQ(events->cols[1].raw(0), 7);
+    EXPECT_EQ(events->cols[2].raw(0), 0xBEEF);
+}
+
+TEST(LogDecode, ImuFromKeyframesDeltasAndBlocks)
+{
+    LogImage        img;
+    ImuDeltaEncoder enc(4);
+    uint8_t         rec[LOG_MAX_RECORD_SIZE];
+    for (uint32_t k = 0; k < 10; ++k)
+    {
+        img.append(rec, enc.encode(sample(1000 + k * 1000, static_cast<int16_t>(k * 3)), rec));
+    }
+
+    ImuBlockEncoder blk;
+    for (uint32_t k = 0; k < 32; ++k)
+    {
+        blk.append(sample(20000 + k * 1000, static_cast<int16_t>(-k * 5)));
+    }
+    img.append(blk.data(), blk.size());
+
+    const DecodedLog log = decode(img);
+    EXPECT_EQ(log.parse_errors, 0U);
+    EXPECT_EQ(log.imu_block_count, 1U);
+    EXPECT_EQ(log.imu_delta_count, 7U); /* 3 klatki kluczowe co 4 */
+    EXPECT_EQ(log.table("imu_block"), nullptr); /* rozwiniety do "imu" */
+
+    const LogTable *imu = log.table("imu");
+    ASSERT_NE(imu, nullptr);
+    ASSERT_EQ(imu->rows, 42U);
+    for (size_t r = 0; r < 10; ++r)
+    {
+        EXPECT_EQ(imu->cols[0].raw(r), 1000 + static_cast<int64_t>(r) * 1000);
+        EXPECT_EQ(imu->cols[1].raw(r), static_cast<int64_t>(r) * 3);
+    }
+    EXPECT_EQ(imu->cols[0].raw(41), 20000 + 31 * 1000);
+    EXPECT_EQ(imu->cols[1].raw(41), -31 * 5);
+    EXPECT_EQ(imu->cols[2].raw(41), 31 * 5);
+    EXPECT_EQ(imu->cols[3].raw(41), 9810);
+}
+
+TEST(LogDecode, SkipsPaddingAndUnknownIds)
+{
+    LogImage img;
+    img.add(LogBaro{hdr(LogMsgId::BARO, 1), 1, 1});
+    img.bytes.insert(img.bytes.end(), 1000, LOG_PAD_BYTE);
+    img.bytes.push_back(0xEE);
+    img.add(LogBaro{hdr(LogMsgId::BARO, 2), 2, 2});
+    img.bytes.insert(img.bytes.end(), 13, LOG_PAD_BYTE); /* ogon prealokacji */
+
+    const DecodedLog log = decode(img);
+    EXPECT_EQ(log.table("baro")->rows, 2U);
+    EXPECT_EQ(log.padding_bytes, 1013U);
+    EXPECT_EQ(log.unknown_count, 1U);
+    EXPECT_EQ(log.parse_errors, 0U);
+}
+
+TEST(LogDecode, CountsDeltasBeforeFirstKeyframe)
+{
+    LogImage        img;
+    ImuDeltaEncoder enc(100);
+    uint8_t         rec[LOG_MAX_RECORD_SIZE];
+    (void)enc.encode(sample(0, 0), rec); /* klatka kluczowa pominieta */
+    for (uint32_t k = 1; k <= 3; ++k)
+    {
+        img.append(rec, enc.encode(sample(k * 1000, 1), rec));
+    }
+
+    const DecodedLog log = decode(img);
+    EXPECT_EQ(log.imu_unsynced, 3U);
+    EXPECT_EQ(log.table("imu")->rows, 0U);
+    EXPECT_EQ(log.parse_errors, 0U);
+}
+
+TEST(LogDecode, TruncatedRecordStopsWithParseError)
+{
+    LogImage     img(3); /* bez ramek */
+    const size_t start = img.bytes.size();
+    img.add(LogMag{hdr(LogMsgId::MAG, 1), {1, 2, 3}});
+    const LogNav nav{hdr(LogMsgId::NAV, 2), {}, {}, {}};
+    img.append(&nav, sizeof(nav) - 1);
+
+    const DecodedLog log = decode(img);
+    EXPECT_EQ(log.table("mag")->rows, 1U);
+    EXPECT_EQ(log.table("nav")->rows, 0U);
+    EXPECT_EQ(log.parse_errors, 1U);
+    EXPECT_EQ(log.bytes_consumed, start + sizeof(LogMag));
+}
+
+TEST(LogDecode, RejectsBadMagicAndShortFile)
+{
+    LogImage img;
+    img.bytes[0] = 'X';
+    EXPECT_FALSE(decode(img).header_ok);
+
+    const uint8_t short_file[4] = {'A', 'C', 'S', '4'};
+    EXPECT_FALSE(log_decode(short_file, sizeof(short_file)).header_ok);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Index
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(LogDecode, SparseIndexAndSeek)
+{
+    LogImage            img;
+    std::vector<size_t> offsets; /* ramka kazdego rekordu — tam zaczyna sie odczyt */
+    for (uint32_t k = 0; k < 100; ++k) /* co 10 ms, ramka co 50 ms */
+    {
+        if (k > 0 && k % 5 == 0)
+        {
+            img.open_frame();
+        }
+        offsets.push_back(img.frame);
+        img.add(LogBaro{hdr(LogMsgId::BARO, 5000 + k * 10000), k, 0});
+    }
+
+    const DecodedLog log = decode(img, 100000); /* co 100 ms */
+    ASSERT_EQ(log.index.size(), 10U);
+    for (size_t i = 0; i < log.index.size(); ++i)
+    {
+        EXPECT_EQ(log.index[i].timestamp_us, 5000 + i * 100000);
+        EXPECT_EQ(log.index[i].time_us, 5000 + i * 100000); /* bez przepelnienia */
+        EXPECT_EQ(log.index[i].offset, offsets[i * 10]);
+    }
+
+    EXPECT_EQ(log_index_seek(log.index, 0), offsets[0]);
+    EXPECT_EQ(log_index_seek(log.index, 5000), offsets[0]);
+    EXPECT_EQ(log_index_seek(log.index, 350000), offsets[30]);
+    EXPECT_EQ(log_index_seek(log.index, 999999999), offsets[90]);
+
+    EXPECT_EQ(decode(img, 0).index.size(), 100U);
+    EXPECT_EQ(log_index_seek({}, 1000), 0U);
+}
+
+TEST(LogDecode, IndexFollowsTimestampWrap)
+{
+    /* 550 MHz: CYCCNT / 550 przepelnia sie co 7809031 us, nie co 2^32 */
+    LogFileHeader h{};
+    h.sysclk_hz         = 550000000; /* jak LogImage */
+    const uint64_t wrap = log_timestamp_wrap_us(h);
+    ASSERT_EQ(wrap, 7809031U);
+    h.sysclk_hz = 0;
+    EXPECT_EQ(log_timestamp_wrap_us(h), 0x100000000ULL);
+
+    /* 4 s BARO co 10 ms od 2 s przed przepelnieniem, ramka co 50 ms; po
+     * kazdym BARO MAG o 3 ms wczesniejszy — krok wstecz, nie przepelnienie */
+    LogImage            img;
+    const uint64_t      t0 = wrap - 2000000;
+    std::vector<size_t> offsets;
+    for (uint32_t k = 0; k < 400; ++k)
+    {
+        if (k > 0 && k % 5 == 0)
+        {
+            img.open_frame();
+        }
+        offsets.push_back(img.frame);
+        const uint64_t t = t0 + k * 10000;
+        img.add(LogBaro{hdr(LogMsgId::BARO, static_cast<uint32_t>(t % wrap)), k, 0});
+        img.add(LogMag{hdr(LogMsgId::MAG, static_cast<uint32_t>((t - 3000) % wrap)), {}});
+    }
+
+    const DecodedLog log = decode(img, 100000);
+    ASSERT_EQ(log.index.size(), 40U);
+    for (size_t i = 0; i < log.index.size(); ++i)
+    {
+        const uint64_t t = t0 + i * 100000;
+        EXPECT_EQ(log.index[i].time_us, t) << i;
+        EXPECT_EQ(log.index[i].timestamp_us, t % wrap) << i;
+        EXPECT_EQ(log.index[i].offset, offsets[i * 10]) << i;
+    }
+
+    EXPECT_EQ(log_index_seek(log.index, t0 + 1999999), offsets[190]);
+    EXPECT_EQ(log_index_seek(log.index, t0 + 2000000), offsets[200]); /* raw 0 */
+    EXPECT_EQ(log_index_seek(log.index, t0 + 3550000), offsets[350]);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Output
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(LogDecode, CsvMatchesPythonDecoderPrecision)
+{
+    LogImage img;
+    img.add(LogImu{hdr(LogMsgId::IMU, 42), {-1, 9810, 0}, {-314, 5, 0}});
+    img.add(LogBaro{hdr(LogMsgId::BARO, 43), 101325, -1250});
+    img.add(LogNav{hdr(LogMsgId::NAV, 44), {32767, 0, -32767, 16384}, {1, -2, 3}, {-5, 0, 100}});
+
+    const DecodedLog log = decode(img);
+    EXPECT_EQ(to_string(log_write_csv, *log.table("imu")),
+              "timestamp_us,accel_x,accel_y,accel_z,gyro_x,gyro_y,gyro_z\n"
+              "42,-0.0010,9.8100,0.0000,-3.14000,0.05000,0.00000\n");
+    EXPECT_EQ(to_string(log_write_csv, *log.table("baro")),
+              "timestamp_us,pressure_pa,altitude_m\n"
+              "43,101325,-1.250\n");
+    EXPECT_EQ(to_string(log_write_csv, *log.table("nav")),
+              "timestamp_us,qw,qx,qy,qz,pos_n,pos_e,pos_d,vel_n,vel_e,vel_d\n"
+              "44,1.000000,0.000000,-1.000000,0.500015,0.0010,-0.0020,0.0030,"
+              "-0.0500,0.0000,1.0000\n");
+}
+
+TEST(LogDecode, ColumnarLayout)
+{
+    LogImage img;
+    img.add(LogMag{hdr(LogMsgId::MAG, 7), {1, -2, 3}});
+    img.add(LogMag{hdr(LogMsgId::MAG, 8), {4, -5, 6}});
+
+    const DecodedLog  log = decode(img);
+    const std::string out = to_string(log_write_columnar, *log.table("mag"));
+
+    size_t pos = 0;
+    auto   get = [&](void *dst, size_t n) {
+        ASSERT_LE(pos + n, out.size());
+        std::memcpy(dst, &out[pos], n);
+        pos += n;
+    };
+
+    char     magic[4];
+    uint16_t version = 0;
+    uint16_t ncols   = 0;
+    uint64_t rows    = 0;
+    get(magic, 4);
+    get(&version, 2);
+    get(&ncols, 2);
+    get(&rows, 8);
+    EXPECT_EQ(std::memcmp(magic, "ACSC", 4), 0);
+    EXPECT_EQ(version, 1U);
+    ASSERT_EQ(ncols, 4U);
+    EXPECT_EQ(rows, 2U);
+
+    const char *names[4] = {"timestamp_us", "field_x", "field_y", "field_z"};
+    for (const char *name : names)
+    {
+        uint8_t type = 0;
+        uint8_t len  = 0;
+        double  scale;
+        get(&type, 1);
+        get(&len, 1);
+        std::string n(len, '\0');
+        get(n.data(), len);
+        get(&scale, 8);
+        EXPECT_EQ(n, name);
+        EXPECT_EQ(type, static_cast<uint8_t>(n == "timestamp_us" ? LogFieldType::U32
+                                                                  : LogFieldType::I16));
+    }
+
+    uint32_t t[2];
+    int16_t  fx[2];
+    int16_t  fy[2];
+    get(t, sizeof(t));
+    get(fx, sizeof(fx));
+    get(fy, sizeof(fy));
+    EXPECT_EQ(t[1], 8U);
+    EXPECT_EQ(fx[1], 4);
+    EXPECT_EQ(fy[0], -2);
+    EXPECT_EQ(out.size(), pos + sizeof(fx)); /* field_z na koncu */
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Schema
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(LogSchema, RoundTripMatchesLogFormat)
+{
+    uint8_t      block[log_schema_size()];
+    const size_t n = log_schema_write(block, sizeof(block));
+    ASSERT_EQ(n, sizeof(block));
+    EXPECT_EQ(log_schema_write(block, sizeof(block) - 1), 0U);
+
+    std::vector<LogSchemaMsg> parsed;
+    ASSERT_EQ(log_schema_parse(block, n, parsed), n);
+
+    const std::vector<LogSchemaMsg> builtin = log_schema_builtin();
+    ASSERT_EQ(parsed.size(), builtin.size());
+    for (size_t i = 0; i < parsed.size(); ++i)
+    {
+        EXPECT_EQ(parsed[i].id, builtin[i].id);
+        EXPECT_EQ(parsed[i].name, builtin[i].name);
+        EXPECT_EQ(parsed[i].layout, builtin[i].layout);
+        EXPECT_EQ(parsed[i].layout_arg, builtin[i].layout_arg);
+        EXPECT_EQ(parsed[i].fixed_size, builtin[i].fixed_size);
+        ASSERT_EQ(parsed[i].fields.size(), builtin[i].fields.size());
+        for (size_t k = 0; k < parsed[i].fields.size(); ++k)
+        {
+            EXPECT_EQ(parsed[i].fields[k].name, builtin[i].fields[k].name);
+            EXPECT_EQ(parsed[i].fields[k].type, builtin[i].fields[k].type);
+            EXPECT_EQ(parsed[i].fields[k].scale, builtin[i].fields[k].scale);
+            EXPECT_EQ(parsed[i].fields[k].decimals, builtin[i].fields[k].decimals);
+        }
+    }
+}
+
+TEST(LogSchema, FixedSizesMatchRecordStructs)
+{
+    EXPECT_EQ(log_msg_fixed_size(*log_msg_desc(LogMsgId::NAV)), sizeof(LogNav));
+    EXPECT_EQ(log_msg_fixed_size(*log_msg_desc(LogMsgId::EVENT)), sizeof(LogEvent));
+    EXPECT_EQ(log_msg_fixed_size(*log_msg_desc(LogMsgId::IMU_BLOCK)),
+              sizeof(LogImuBlock));
+    EXPECT_EQ(log_msg_desc(static_cast<LogMsgId>(0x7F)), nullptr);
+}
+
+TEST(LogSchema, PreSchemaFileUsesBuiltinSchema)
+{
+    LogImage img(3);
+    img.add(LogBaro{hdr(LogMsgId::BARO, 10), 100000, 5});
+
+    const DecodedLog log = decode(img);
+    EXPECT_FALSE(log.schema_in_file);
+    EXPECT_EQ(log.schema.size(), log_schema_builtin().size());
+    EXPECT_EQ(log.table("baro")->rows, 1U);
+    EXPECT_EQ(log.parse_errors, 0U);
+    EXPECT_EQ(log.bytes_consumed, img.bytes.size());
+}
+
+TEST(LogSchema, UnknownFixedTypeDecodesFromFileSchema)
+{
+    /* Typ 0x20 dodany po tej kompilacji: naglowek + i32 + u8 */
+    SchemaBlock sb;
+    sb.msg(0x20, "gnss", LogLayout::FIXED, 0, 2);
+    sb.field("lat_deg", LogFieldType::I32, 1e-7, 7);
+    sb.field("sats", LogFieldType::U8, 1.0, 0);
+    sb.msg(static_cast<uint8_t>(LogMsgId::BARO), "baro", LogLayout::FIXED, 0, 2);
+    sb.field("pressure_pa", LogFieldType::U32, 1.0, 0);
+    sb.field("altitude_m", LogFieldType::I32, 0.001, 3);
+
+    LogImage img(LOG_FORMAT_VERSION);
+    img.append(sb.finish().data(), sb.bytes.size());
+    img.open_frame();
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+        const uint8_t id  = 0x20;
+        const int32_t lat = 510000000 + static_cast<int32_t>(k);
+        const uint8_t sat = static_cast<uint8_t>(7 + k);
+        const auto    t   = 1000 * (k + 1);
+        img.append(&id, 1);
+        img.append(&t, 4);
+        img.append(&lat, 4);
+        img.append(&sat, 1);
+    }
+    img.add(LogBaro{hdr(LogMsgId::BARO, 5000), 101325, -1250});
+
+    const DecodedLog log = decode(img);
+    EXPECT_TRUE(log.schema_in_file);
+    EXPECT_EQ(log.parse_errors, 0U);
+    EXPECT_EQ(log.unknown_count, 0U);
+    EXPECT_EQ(log.records, 4U);
+    EXPECT_EQ(log.table("imu"), nullptr); /* nie ma w schemacie pliku */
+
+    const LogTable *gnss = log.table("gnss");
+    ASSERT_NE(gnss, nullptr);
+    ASSERT_EQ(gnss->rows, 3U);
+    EXPECT_EQ(gnss->cols[0].raw(2), 3000);
+    EXPECT_EQ(gnss->cols[1].raw(1), 510000001);
+    EXPECT_EQ(gnss->cols[2].raw(2), 9);
+    EXPECT_EQ(to_string(log_write_csv, *gnss),
+              "timestamp_us,lat_deg,sats\n"
+              "1000,51.0000000,7\n"
+              "2000,51.0000001,8\n"
+              "3000,51.0000002,9\n");
+    EXPECT_EQ(log.table("baro")->rows, 1U);
+}
+
+TEST(LogSchema, UnknownLen16AndVarintTypesAreSkippedByLength)
+{
+    SchemaBlock sb;
+    sb.msg(0x21, "blob", LogLayout::LEN16, 5, 1); /* u16 dlugosc zaraz po naglowku */
+    sb.field("payload_len", LogFieldType::U16, 1.0, 0);
+    sb.msg(0x22, "packed", LogLayout::VARINTS, 2, 0);
+    sb.msg(static_cast<uint8_t>(LogMsgId::MAG), "mag", LogLayout::FIXED, 0, 3);
+    sb.field("field_x", LogFieldType::I16, 1.0, 0);
+    sb.field("field_y", LogFieldType::I16, 1.0, 0);
+    sb.field("field_z", LogFieldType::I16, 1.0, 0);
+
+    LogImage img(LOG_FORMAT_VERSION);
+    img.append(sb.finish().data(), sb.bytes.size());
+    img.open_frame();
+
+    const uint8_t blob[] = {0x21, 10, 0, 0, 0, 4, 0, 0x21, 0x22, 0xFF, 0x01};
+    img.append(blob, sizeof(blob));
+    const uint8_t packed[] = {0x22, 0x80, 0x01, 0x05}; /* 2 varinty: 128, 5 */
+    img.append(packed, sizeof(packed));
+    img.add(LogMag{hdr(LogMsgId::MAG, 20), {1, 2, 3}});
+
+    const DecodedLog log = decode(img, 0);
+    EXPECT_EQ(log.parse_errors, 0U);
+    EXPECT_EQ(log.unknown_count, 0U);
+    EXPECT_EQ(log.records, 3U);
+    EXPECT_EQ(log.table("packed"), nullptr);
+
+    const LogTable *b = log.table("blob");
+    ASSERT_NE(b, nullptr);
+    ASSERT_EQ(b->rows, 1U);
+    EXPECT_EQ(b->cols[1].raw(0), 4);
+    EXPECT_EQ(log.table("mag")->rows, 1U);
+    EXPECT_EQ(log.index.size(), 2U); /* VARINTS bez znacznika czasu */
+    EXPECT_EQ(log.bytes_consumed, img.bytes.size());
+}
+
+TEST(LogSchema, RejectsCorruptBlocks)
+{
+    std::vector<LogSchemaMsg> out;
+    uint8_t                   block[log_schema_size()];
+    const size_t              n = log_schema_write(block, sizeof(block));
+
+    EXPECT_EQ(log_schema_parse(block, n - 1, out), 0U); /* ucieta */
+
+    std::vector<uint8_t> bad(block, block + n);
+    bad[0] = 'X';
+    EXPECT_EQ(log_schema_parse(bad.data(), bad.size(), out), 0U);
+
+    bad.assign(block, block + n);
+    bad[6] = static_cast<uint8_t>(bad[6] + 1); /* wiecej typow niz danych */
+    EXPECT_EQ(log_schema_parse(bad.data(), bad.size(), out), 0U);
+
+    SchemaBlock bad_type;
+    bad_type.msg(0x20, "x", LogLayout::FIXED, 0, 1);
+    bad_type.field("f", static_cast<LogFieldType>(9), 1.0, 0);
+    EXPECT_EQ(log_schema_parse(bad_type.finish().data(), bad_type.bytes.size(), out), 0U);
+
+    SchemaBlock bad_len; /* u16 dlugosci poza czescia stala */
+    bad_len.msg(0x20, "x", LogLayout::LEN16, 5, 0);
+    EXPECT_EQ(log_schema_parse(bad_len.finish().data(), bad_len.bytes.size(), out), 0U);
+
+    SchemaBlock pad_id;
+    pad_id.msg(LOG_PAD_BYTE, "x", LogLayout::FIXED, 0, 0);
+    EXPECT_EQ(log_schema_parse(pad_id.finish().data(), pad_id.bytes.size(), out), 0U);
+
+    /* Plik v4 z uszkodzonym schematem: wbudowany, reszta jak zwykle */
+    LogImage img(LOG_FORMAT_VERSION);
+    img.append(bad_type.bytes.data(), bad_type.bytes.size());
+    const DecodedLog log = decode(img);
+    EXPECT_TRUE(log.header_ok);
+    EXPECT_FALSE(log.schema_in_file);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Frames
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+namespace
+{
+
+/* Log do testow odpornosci: IMU (delty, klatka kluczowa co 8) i BARO
+ * z licznikiem w pressure_pa; ramki po ~2 KiB (wieksze od sektora, jak
+ * w firmware — przeniesiony stary sektor nie zawiera calej ramki) */
+struct FramedLog
+{
+    LogImage                                img;
+    std::vector<std::pair<size_t, size_t>>  frames; /* [start, end) */
+    std::vector<std::set<uint32_t>>         baro;   /* liczniki BARO w ramce */
+
+    static ImuFixed imu_at(uint32_t k)
+    {
+        return sample(1000 + k * 1000, static_cast<int16_t>((k * 37U) % 4000U) - 2000);
+    }
+
+    explicit FramedLog(uint32_t samples = 3000)
+    {
+        ImuDeltaEncoder enc(8);
+        uint8_t         rec[LOG_MAX_RECORD_SIZE];
+        baro.emplace_back();
+        for (uint32_t k = 0; k < samples; ++k)
+        {
+            if (img.bytes.size() - img.frame > 2048)
+            {
+                next_frame();
+            }
+            img.append(rec, enc.encode(imu_at(k), rec));
+            if (k % 5 == 0)
+            {
+                img.add(LogBaro{hdr(LogMsgId::BARO, 1000 + k * 1000), k, 0});
+                baro.back().insert(k);
+            }
+        }
+        const size_t start = img.frame;
+        img.seal();
+        frames.emplace_back(start, img.bytes.size());
+    }
+
+    void next_frame()
+    {
+        const size_t start = img.frame;
+        img.open_frame();
+        frames.emplace_back(start, img.frame);
+        baro.emplace_back();
+    }
+
+    size_t first_frame() const
+    {
+        return frames.front().first;
+    }
+};
+
+/* Sprawdza odzysk po uszkodzeniu: tabele = dokladnie nietkniete ramki */
+void expect_recovered(const FramedLog &fl, const std::vector<uint8_t> &bad)
+{
+    const std::vector<uint8_t> &good = fl.img.bytes;
+
+    std::set<uint32_t> expect_baro;
+    size_t             intact = 0;
+    size_t             last   = 0; /* 1 + indeks ostatniej nietknietej */
+    for (size_t i = 0; i < fl.frames.size(); ++i)
+    {
+        const auto [a, b] = fl.frames[i];
+        const bool touched =
+            b > bad.size() || std::memcmp(&good[a], &bad[a], b - a) != 0;
+        if (!touched)
+        {
+            expect_baro.insert(fl.baro[i].begin(), fl.baro[i].end());
+            ++intact;
+            last = i + 1;
+        }
+    }
+
+    const DecodedLog log = log_decode(bad.data(), bad.size());
+    ASSERT_TRUE(log.header_ok);
+    EXPECT_EQ(log.frames, intact);
+    EXPECT_EQ(log.frames + log.frames_lost, last);
+    EXPECT_EQ(log.bytes_consumed, bad.size());
+
+    const LogTable *baro = log.table("baro");
+    std::set<uint32_t> got;
+    for (size_t r = 0; r < baro->rows; ++r)
+    {
+        const auto k = static_cast<uint32_t>(baro->cols[1].raw(r));
+        EXPECT_EQ(baro->cols[0].raw(r), 1000 + int64_t{k} * 1000);
+        got.insert(k);
+    }
+    EXPECT_EQ(got, expect_baro);
+
+    /* IMU: kazdy wiersz to prawdziwa probka — lancuch delt po dziurze
+     * czeka na klatke kluczowa zamiast sklejac smieci */
+    const LogTable *imu = log.table("imu");
+    for (size_t r = 0; r < imu->rows; ++r)
+    {
+        const auto     k = static_cast<uint32_t>((imu->cols[0].raw(r) - 1000) / 1000);
+        const ImuFixed s = FramedLog::imu_at(k);
+        ASSERT_EQ(imu->cols[0].raw(r), s.timestamp_us);
+        ASSERT_EQ(imu->cols[1].raw(r), s.accel[0]) << "t=" << s.timestamp_us;
+        ASSERT_EQ(imu->cols[6].raw(r), s.gyro[2]) << "t=" << s.timestamp_us;
+    }
+}
+
+}  // namespace
+
+TEST(LogFrames, CleanLogDecodesEveryFrame)
+{
+    const FramedLog  fl;
+    const DecodedLog log = log_decode(fl.img.bytes.data(), fl.img.bytes.size());
+    EXPECT_GT(fl.frames.size(), 10U);
+    EXPECT_EQ(log.frames, fl.frames.size());
+    EXPECT_EQ(log.frames_lost, 0U);
+    EXPECT_EQ(log.corrupt_regions, 0U);
+    EXPECT_EQ(log.parse_errors, 0U);
+    EXPECT_EQ(log.table("imu")->rows, 3000U);
+    expect_recovered(fl, fl.img.bytes);
+}
+
+TEST(LogFrames, PaddingBetweenFramesIsSkipped)
+{
+    FramedLog fl;
+    auto     &b   = fl.img.bytes;
+    const auto at = static_cast<std::ptrdiff_t>(fl.frames[3].first);
+    b.insert(b.begin() + at, 700, LOG_PAD_BYTE);
+    b.insert(b.end(), 5000, LOG_PAD_BYTE); /* nieobciety plik po zaniku zasilania */
+
+    const DecodedLog log = log_decode(b.data(), b.size());
+    EXPECT_EQ(log.frames, fl.frames.size());
+    EXPECT_EQ(log.padding_bytes, 5700U);
+    EXPECT_EQ(log.corrupt_regions, 0U);
+    EXPECT_EQ(log.table("imu")->rows, 3000U);
+}
+
+TEST(LogFrames, BadRecordDropsOnlyTheRestOfItsFrame)
+{
+    LogImage img;
+    img.add(LogBaro{hdr(LogMsgId::BARO, 1), 1, 0});
+    const LogNav nav{hdr(LogMsgId::NAV, 2), {}, {}, {}};
+    img.append(&nav, sizeof(nav) - 1); /* ramka konczy sie w srodku rekordu */
+    img.open_frame();
+    img.add(LogBaro{hdr(LogMsgId::BARO, 3), 3, 0});
+
+    const DecodedLog log = decode(img);
+    EXPECT_EQ(log.frames, 2U);
+    EXPECT_EQ(log.parse_errors, 1U);
+    EXPECT_EQ(log.table("baro")->rows, 2U);
+    EXPECT_EQ(log.table("nav")->rows, 0U);
+}
+
+TEST(LogFrames, StaleFramesOfAnotherFileAreRejected)
+{
+    /* Prealokacja odslania stare sektory — ramki innego pliku maja inne
+     * ziarno CRC */
+    LogImage old;
+    old.bytes[10] ^= 0x01; /* inny boot_time_ms */
+    old.open_frame();
+    old.add(LogBaro{hdr(LogMsgId::BARO, 9), 99, 0});
+    old.seal();
+
+    LogImage img;
+    img.add(LogBaro{hdr(LogMsgId::BARO, 1), 1, 0});
+    img.seal();
+    const size_t from = old.bytes.size() - sizeof(LogFrameHeader) - sizeof(LogBaro);
+    img.bytes.insert(img.bytes.end(), old.bytes.begin() + static_cast<std::ptrdiff_t>(from),
+                     old.bytes.end());
+
+    const DecodedLog log = log_decode(img.bytes.data(), img.bytes.size());
+    EXPECT_EQ(log.frames, 1U);
+    EXPECT_EQ(log.corrupt_regions, 1U);
+    EXPECT_EQ(log.corrupt_bytes, sizeof(LogFrameHeader) + sizeof(LogBaro));
+    EXPECT_EQ(log.table("baro")->rows, 1U);
+}
+
+TEST(LogFrames, FuzzFlippedBytes)
+{
+    const FramedLog fl;
+    std::mt19937    rng(12345);
+    for (int round = 0; round < 200; ++round)
+    {
+        std::vector<uint8_t> bad = fl.img.bytes;
+        std::uniform_int_distribution<size_t> at(fl.first_frame(), bad.size() - 1);
+        const int flips = 1 + round % 8;
+        for (int i = 0; i < flips; ++i)
+        {
+            bad[at(rng)] ^= static_cast<uint8_t>(1U + rng() % 255U);
+        }
+        SCOPED_TRACE(round);
+        expect_recovered(fl, bad);
+    }
+}
+
+TEST(LogFrames, FuzzTornSectors)
+{
+    const FramedLog fl;
+    std::mt19937    rng(777);
+    const size_t    first_sector = fl.first_frame() / 512 + 1;
+    const size_t    sectors      = fl.img.bytes.size() / 512;
+    for (int round = 0; round < 200; ++round)
+    {
+        std::vector<uint8_t> bad = fl.img.bytes;
+        const size_t s   = first_sector + rng() % (sectors - first_sector);
+        const size_t n   = 1 + rng() % 3;
+        uint8_t     *dst = &bad[s * 512];
+        const size_t len = std::min(n * 512, bad.size() - s * 512);
+        switch (round % 3)
+        {
+            case 0: /* niezapisane sektory */
+                std::memset(dst, 0x00, len);
+                break;
+            case 1: /* skasowany blok */
+                std::memset(dst, 0xFF, len);
+                break;
+            default: /* stara zawartosc — inny fragment tego samego pliku */
+                std::memcpy(dst, &fl.img.bytes[(s * 7919U % sectors) * 512],
+                            std::min(len, bad.size() - (s * 7919U % sectors) * 512));
+                break;
+        }
+        SCOPED_TRACE(round);
+        expect_recovered(fl, bad);
+    }
+}
+
+TEST(LogFrames, FuzzTruncation)
+{
+    const FramedLog fl;
+    std::mt19937    rng(42);
+    for (int round = 0; round < 50; ++round)
+    {
+        const size_t         cut = fl.first_frame() + rng() % (fl.img.bytes.size() -
+                                                               fl.first_frame());
+        std::vector<uint8_t> bad(fl.img.bytes.begin(),
+                                 fl.img.bytes.begin() + static_cast<std::ptrdiff_t>(cut));
+        SCOPED_TRACE(cut);
+        expect_recovered(fl, bad);
+    }
+}
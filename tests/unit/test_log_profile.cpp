@@ -0,0 +1,163 @@
+/**
+ * @file test_log_profile.cpp
+ * @brief Unit tests for the logging profiles (LogDecimator).
+ *
+ * Covers:
+ *   - FULL admits everything, ratio N keeps exactly 1 in N
+ *   - IMU_BLOCK / IMU_DELTA / EVENT and unprofiled IDs always pass
+ *   - a switch takes effect on the next record
+ *   - concurrent producers of one type keep the exact ratio
+ *   - lookup by name
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "logger/log_profile.h"
+
+using namespace acs;
+
+namespace
+{
+
+constexpr auto id8(LogMsgId id)
+{
+    return static_cast<uint8_t>(id);
+}
+
+/* Ile z n rekordow typu id przepuszcza decymator */
+int admitted(LogDecimator &d, LogMsgId id, int n)
+{
+    int kept = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        kept += d.admit(id8(id)) ? 1 : 0;
+    }
+    return kept;
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Ratios
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(LogProfile, FullAdmitsEverything)
+{
+    LogDecimator d;
+    EXPECT_EQ(d.active(), LogProfileId::FULL);
+    for (uint8_t id = 0; id < LOG_PROFILE_TYPES; ++id)
+    {
+        EXPECT_TRUE(d.admit(id)) << int{id};
+    }
+}
+
+TEST(LogProfile, RatioKeepsOneInN)
+{
+    LogDecimator d;
+    d.select(LogProfileId::PAD);
+    const uint16_t n = log_profile(LogProfileId::PAD).every[id8(LogMsgId::IMU)];
+    ASSERT_GT(n, 1);
+
+    /* Pierwszy przepuszczony od razu, potem co n-ty */
+    EXPECT_TRUE(d.admit(id8(LogMsgId::IMU)));
+    EXPECT_EQ(admitted(d, LogMsgId::IMU, n - 1), 0);
+    EXPECT_EQ(admitted(d, LogMsgId::IMU, 10 * n), 10);
+}
+
+TEST(LogProfile, TypesCountIndependently)
+{
+    LogDecimator d;
+    d.select(LogProfileId::PAD);
+    const LogProfile &p = log_profile(LogProfileId::PAD);
+
+    EXPECT_EQ(admitted(d, LogMsgId::BARO, 3 * p.every[id8(LogMsgId::BARO)]), 3);
+    EXPECT_EQ(admitted(d, LogMsgId::MAG, 7 * p.every[id8(LogMsgId::MAG)]), 7);
+    EXPECT_EQ(admitted(d, LogMsgId::BARO, 2 * p.every[id8(LogMsgId::BARO)]), 2);
+}
+
+TEST(LogProfile, MakeDefaultsToAll)
+{
+    static constexpr LogProfile kOff = log_profile_detail::make("off", {{LogMsgId::MAG, 0}});
+    EXPECT_EQ(kOff.every[id8(LogMsgId::MAG)], 0);
+    EXPECT_EQ(kOff.every[id8(LogMsgId::BARO)], 1);
+    EXPECT_EQ(kOff.every[LOG_PROFILE_TYPES - 1], 1);
+}
+
+TEST(LogProfile, UnthinnedTypesAlwaysPass)
+{
+    for (size_t i = 0; i < static_cast<size_t>(LogProfileId::COUNT); ++i)
+    {
+        LogDecimator d;
+        d.select(static_cast<LogProfileId>(i));
+        EXPECT_EQ(admitted(d, LogMsgId::IMU_BLOCK, 1000), 1000);
+        EXPECT_EQ(admitted(d, LogMsgId::IMU_DELTA, 1000), 1000);
+        EXPECT_EQ(admitted(d, LogMsgId::EVENT, 1000), 1000);
+        EXPECT_TRUE(d.admit(LOG_PROFILE_TYPES));
+        EXPECT_TRUE(d.admit(0xFF));
+    }
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Switching
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(LogProfile, SwitchTakesEffectOnNextRecord)
+{
+    LogDecimator d;
+    d.select(LogProfileId::PAD);
+    EXPECT_TRUE(d.admit(id8(LogMsgId::NAV)));
+    EXPECT_FALSE(d.admit(id8(LogMsgId::NAV)));
+
+    d.select(LogProfileId::FULL); /* start — od razu pelna czestotliwosc */
+    EXPECT_EQ(d.active(), LogProfileId::FULL);
+    EXPECT_EQ(admitted(d, LogMsgId::NAV, 50), 50);
+
+    d.select(LogProfileId::DESCENT);
+    EXPECT_EQ(d.every(LogMsgId::NAV), log_profile(LogProfileId::DESCENT).every[id8(LogMsgId::NAV)]);
+    const uint16_t n = d.every(LogMsgId::NAV);
+    EXPECT_EQ(admitted(d, LogMsgId::NAV, 100 * n), 100);
+}
+
+TEST(LogProfile, ConcurrentProducersKeepExactRatio)
+{
+    LogDecimator d;
+    d.select(LogProfileId::PAD);
+    const uint16_t n = d.every(LogMsgId::IMU);
+
+    constexpr int    kThreads   = 4;
+    constexpr int    kPerThread = 100000;
+    std::atomic<int> kept{0};
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        producers.emplace_back([&] { kept += admitted(d, LogMsgId::IMU, kPerThread); });
+    }
+    for (std::thread &t : producers)
+    {
+        t.join();
+    }
+
+    /* Jeden licznik na typ — suma dokladna niezaleznie od przeplotu */
+    EXPECT_EQ(kept.load(), (kThreads * kPerThread + n - 1) / n);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Lookup
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(LogProfile, FindByName)
+{
+    LogProfileId id = LogProfileId::FULL;
+    ASSERT_TRUE(log_profile_find("descent", id));
+    EXPECT_EQ(id, LogProfileId::DESCENT);
+    ASSERT_TRUE(log_profile_find("pad", id));
+    EXPECT_EQ(id, LogProfileId::PAD);
+    EXPECT_FALSE(log_profile_find("padx", id));
+    EXPECT_FALSE(log_profile_find("", id));
+    EXPECT_EQ(id, LogProfileId::PAD) << "unchanged on a miss";
+}
@@ -0,0 +1,315 @@
+/**
+ * @file test_log_ring.cpp
+ * @brief Unit tests for the lock-free multi-producer log ring.
+ *
+ * Covers:
+ *   - single-thread semantics: round trip, wrap-around, whole-record
+ *     reads (with per-record boundaries), full ring and bad lengths
+ *     counted as drops
+ *   - concurrent stress (std::thread): several producers with varying
+ *     record lengths, one consumer. Every record carries its producer id,
+ *     sequence number and a derived byte pattern, so any loss, duplicate,
+ *     reordering within a producer or interleaved (torn) bytes is caught.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "logger/log_ring.h"
+
+using namespace acs;
+
+namespace
+{
+
+/* Rekord testowy: [len][producer][seq u32][wzor...] */
+constexpr size_t kRecHeader = 6;
+
+size_t make_record(uint8_t *out, uint8_t producer, uint32_t seq)
+{
+    const size_t len = kRecHeader + (seq * 7U + producer) % 90U;
+    out[0]           = static_cast<uint8_t>(len);
+    out[1]           = producer;
+    std::memcpy(&out[2], &seq, sizeof(seq));
+    for (size_t i = kRecHeader; i < len; ++i)
+    {
+        out[i] = static_cast<uint8_t>(seq * 31U + producer * 17U + i);
+    }
+    return len;
+}
+
+bool check_record(const uint8_t *rec, uint8_t &producer, uint32_t &seq)
+{
+    producer = rec[1];
+    std::memcpy(&seq, &rec[2], sizeof(seq));
+    uint8_t      expect[128];
+    const size_t len = make_record(expect, producer, seq);
+    return rec[0] == len && std::memcmp(rec, expect, len) == 0;
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  LogRing — single thread
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(LogRing, EmptyReadReturnsNothing)
+{
+    LogRing<256> ring;
+    uint8_t      out[64];
+    uint32_t     recs = 99;
+    EXPECT_EQ(ring.read(out, sizeof(out), &recs), 0U);
+    EXPECT_EQ(recs, 0U);
+    EXPECT_EQ(ring.used(), 0U);
+}
+
+TEST(LogRing, RecordsComeOutBackToBack)
+{
+    LogRing<256>  ring;
+    const uint8_t a[3] = {1, 2, 3};
+    const uint8_t b[5] = {4, 5, 6, 7, 8};
+    ASSERT_TRUE(ring.write(a, sizeof(a)));
+    ASSERT_TRUE(ring.write(b, sizeof(b)));
+    EXPECT_EQ(ring.used(), (1 + 1 + 1 + 2) * 4U);
+
+    uint8_t  out[16] = {};
+    uint32_t recs    = 0;
+    ASSERT_EQ(ring.read(out, sizeof(out), &recs), 8U);
+    EXPECT_EQ(recs, 2U);
+    const uint8_t expect[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    EXPECT_EQ(std::memcmp(out, expect, 8), 0);
+    EXPECT_EQ(ring.used(), 0U);
+}
+
+TEST(LogRing, ReadCopiesWholeRecordsOnly)
+{
+    LogRing<256>  ring;
+    const uint8_t rec[10] = {};
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(ring.write(rec, sizeof(rec)));
+    }
+
+    uint8_t out[64];
+    EXPECT_EQ(ring.read(out, 25), 20U);
+    EXPECT_EQ(ring.read(out, 9), 0U);
+    EXPECT_EQ(ring.read(out, 10), 10U);
+}
+
+TEST(LogRing, ReadReportsRecordBoundaries)
+{
+    LogRing<256>  ring;
+    const uint8_t a[3] = {1, 2, 3};
+    const uint8_t b[6] = {4, 5, 6, 7, 8, 9};
+    ASSERT_TRUE(ring.write(a, sizeof(a)));
+    ASSERT_TRUE(ring.write(b, sizeof(b)));
+
+    uint8_t             out[16];
+    std::vector<size_t> offs;
+    std::vector<size_t> lens;
+    ASSERT_EQ(ring.read(out, sizeof(out), nullptr,
+                        [&](const uint8_t *rec, size_t len) {
+                            offs.push_back(static_cast<size_t>(rec - out));
+                            lens.push_back(len);
+                        }),
+              9U);
+    EXPECT_EQ(offs, (std::vector<size_t>{0, 3}));
+    EXPECT_EQ(lens, (std::vector<size_t>{3, 6}));
+}
+
+TEST(LogRing, FullRingDropsAndRecovers)
+{
+    LogRing<64> ring; /* 16 slow, rekord 12 B = 4 slowa */
+    uint8_t     rec[12];
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        std::memset(rec, i, sizeof(rec));
+        ASSERT_TRUE(ring.write(rec, sizeof(rec)));
+    }
+    EXPECT_FALSE(ring.write(rec, sizeof(rec)));
+    EXPECT_FALSE(ring.write(rec, 1));
+    EXPECT_EQ(ring.dropped(), 2U);
+
+    uint8_t out[12];
+    ASSERT_EQ(ring.read(out, sizeof(out)), 12U);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_TRUE(ring.write(rec, sizeof(rec)));
+}
+
+TEST(LogRing, RejectsEmptyAndOversizedRecords)
+{
+    LogRing<256>  ring;
+    const uint8_t big[LogRing<256>::kMaxRecord + 1] = {};
+    EXPECT_FALSE(ring.write(big, 0));
+    EXPECT_FALSE(ring.write(big, sizeof(big)));
+    EXPECT_TRUE(ring.write(big, sizeof(big) - 1));
+    EXPECT_EQ(ring.dropped(), 2U);
+}
+
+TEST(LogRing, WrapsManyLapsIntact)
+{
+    LogRing<256> ring;
+    uint8_t      rec[128];
+    uint8_t      out[128];
+    for (uint32_t seq = 0; seq < 5000; ++seq)
+    {
+        const size_t len = make_record(rec, 3, seq) % 30 + kRecHeader; /* krotkie */
+        rec[0]           = static_cast<uint8_t>(len);
+        ASSERT_TRUE(ring.write(rec, len)) << seq;
+        ASSERT_EQ(ring.read(out, sizeof(out)), len) << seq;
+        ASSERT_EQ(std::memcmp(out, rec, len), 0) << seq;
+    }
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  LogRing — concurrent stress
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+namespace
+{
+
+struct StressResult
+{
+    std::vector<uint32_t> received; /* per producer */
+    size_t                corrupt      = 0;
+    size_t                out_of_order = 0;
+};
+
+/* Konsument: parsuje strumien bajtow rekord po rekordzie */
+template <size_t Cap>
+StressResult consume(LogRing<Cap>              &ring,
+                     size_t                     producers,
+                     const std::atomic<size_t> &done,
+                     std::vector<uint32_t>     *expected_next)
+{
+    StressResult r;
+    r.received.assign(producers, 0);
+    std::vector<uint8_t> buf(4096);
+
+    auto parse = [&](size_t n) {
+        size_t pos = 0;
+        while (pos < n)
+        {
+            uint8_t  p   = 0;
+            uint32_t seq = 0;
+            if (!check_record(&buf[pos], p, seq) || p >= producers)
+            {
+                ++r.corrupt;
+                return;
+            }
+            if (expected_next != nullptr && seq != (*expected_next)[p])
+            {
+                ++r.out_of_order;
+            }
+            if (expected_next != nullptr)
+            {
+                (*expected_next)[p] = seq + 1;
+            }
+            ++r.received[p];
+            pos += buf[pos];
+        }
+    };
+
+    while (done.load(std::memory_order_acquire) < producers)
+    {
+        const size_t n = ring.read(buf.data(), buf.size());
+        if (n == 0)
+        {
+            std::this_thread::yield();
+        }
+        parse(n);
+    }
+    for (size_t n; (n = ring.read(buf.data(), buf.size())) > 0;)
+    {
+        parse(n);
+    }
+    return r;
+}
+
+}  // namespace
+
+TEST(LogRingStress, NoLossNoTearingWithRetryingProducers)
+{
+    constexpr size_t   kProducers = 4;
+    constexpr uint32_t kPerThread = 20000;
+
+    LogRing<4096>       ring; /* maly — wymusza czeste zapelnienie */
+    std::atomic<size_t> done{0};
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&, p]() {
+            uint8_t rec[128];
+            for (uint32_t seq = 0; seq < kPerThread; ++seq)
+            {
+                const size_t len = make_record(rec, static_cast<uint8_t>(p), seq);
+                while (!ring.write(rec, len))
+                {
+                    std::this_thread::yield();
+                }
+            }
+            done.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    std::vector<uint32_t> next(kProducers, 0);
+    const StressResult    r = consume(ring, kProducers, done, &next);
+    for (auto &t : producers)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(r.corrupt, 0U);
+    EXPECT_EQ(r.out_of_order, 0U);
+    for (size_t p = 0; p < kProducers; ++p)
+    {
+        EXPECT_EQ(r.received[p], kPerThread) << "producer " << p;
+    }
+    EXPECT_EQ(ring.used(), 0U);
+}
+
+TEST(LogRingStress, DroppedPlusReceivedEqualsSent)
+{
+    constexpr size_t   kProducers = 6;
+    constexpr uint32_t kPerThread = 30000;
+
+    LogRing<1024>         ring;
+    std::atomic<size_t>   done{0};
+    std::atomic<uint32_t> accepted{0};
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&, p]() {
+            uint8_t rec[128];
+            for (uint32_t seq = 0; seq < kPerThread; ++seq)
+            {
+                const size_t len = make_record(rec, static_cast<uint8_t>(p), seq);
+                if (ring.write(rec, len))
+                {
+                    accepted.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            done.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    const StressResult r = consume(ring, kProducers, done, nullptr);
+    for (auto &t : producers)
+    {
+        t.join();
+    }
+
+    uint32_t received = 0;
+    for (uint32_t n : r.received)
+    {
+        received += n;
+    }
+    EXPECT_EQ(r.corrupt, 0U);
+    EXPECT_EQ(received, accepted.load());
+    EXPECT_EQ(received + ring.dropped(), kProducers * kPerThread);
+}
@@ -0,0 +1,279 @@
+/**
+ * @file test_preintegration.cpp
+ * @brief Unit tests for coning / sculling compensated IMU preintegration.
+ *
+ * Coverage:
+ *   - trivial motion (constant rate, constant accel, take/reset)
+ *   - coning: two quadrature angular oscillations; 10 ms nav steps from a
+ *     1 kHz IMU vs. a 1 MHz double-precision truth integration
+ *   - sculling: in-phase angular + linear oscillation; rectified velocity
+ *     vs. truth
+ * Each dynamic test also runs an uncompensated single-step integrator to
+ * show the compensation actually buys accuracy.
+ */
+
+#include <Eigen/Geometry>
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "navigation/preintegration.h"
+
+using namespace acs::nav;
+
+namespace
+{
+
+constexpr double kPi      = 3.14159265358979323846;
+constexpr double kImuHz   = 1000.0;
+constexpr int    kPerStep = 10; /* 1 kHz IMU → 100 Hz nav */
+
+using Vec3d = Eigen::Vector3d;
+using Quatd = Eigen::Quaterniond;
+
+Quatd exp_d(const Vec3d &rv)
+{
+    const double a = rv.norm();
+    if (a < 1e-15)
+    {
+        return Quatd(1.0, 0.5 * rv.x(), 0.5 * rv.y(), 0.5 * rv.z()).normalized();
+    }
+    const Vec3d u = rv / a;
+    return Quatd(Eigen::AngleAxisd(a, u));
+}
+
+float angle_between(const Quat &a, const Quatd &b)
+{
+    const Quatd ad(a.w(), a.x(), a.y(), a.z());
+    return static_cast<float>(ad.angularDistance(b));
+}
+
+/* Motion definitions: rate and specific force, plus their exact integrals
+ * over [t0, t1] (what a mean-over-interval IMU sample reports × dt). */
+struct Coning
+{
+    double A = 3.0;              /* rad/s */
+    double W = 2.0 * kPi * 20.0; /* rad/s */
+
+    Vec3d omega(double t) const { return {A * std::cos(W * t), A * std::sin(W * t), 0.0}; }
+    Vec3d force(double) const { return Vec3d::Zero(); }
+    Vec3d omega_int(double t0, double t1) const
+    {
+        return {A * (std::sin(W * t1) - std::sin(W * t0)) / W,
+                A * (std::cos(W * t0) - std::cos(W * t1)) / W,
+                0.0};
+    }
+    Vec3d force_int(double, double) const { return Vec3d::Zero(); }
+};
+
+struct Sculling
+{
+    double A = 3.0;              /* rad/s */
+    double B = 20.0;             /* m/s² */
+    double W = 2.0 * kPi * 25.0; /* rad/s */
+
+    /* φ(t) = (A/W)·sin(Wt)  → ω_x = A·cos(Wt);  f_y = B·sin(Wt) in phase with φ */
+    Vec3d omega(double t) const { return {A * std::cos(W * t), 0.0, 0.0}; }
+    Vec3d force(double t) const { return {0.0, B * std::sin(W * t), 0.0}; }
+    Vec3d omega_int(double t0, double t1) const
+    {
+        return {A * (std::sin(W * t1) - std::sin(W * t0)) / W, 0.0, 0.0};
+    }
+    Vec3d force_int(double t0, double t1) const
+    {
+        return {0.0, B * (std::cos(W * t0) - std::cos(W * t1)) / W, 0.0};
+    }
+};
+
+struct Truth
+{
+    Quatd q = Quatd::Identity();
+    Vec3d v = Vec3d::Zero();
+};
+
+/* 1 MHz midpoint integration in double precision. */
+template <typename Motion>
+Truth integrate_truth(const Motion &m, double duration)
+{
+    constexpr double h = 1e-6;
+    Truth            tr;
+    const int        n = static_cast<int>(std::lround(duration / h));
+    for (int i = 0; i < n; ++i)
+    {
+        const double t  = i * h;
+        const Quatd  qm = tr.q * exp_d(m.omega(t + 0.25 * h) * (0.5 * h));
+        tr.v += qm * (m.force(t + 0.5 * h) * h);
+        tr.q = (tr.q * exp_d(m.omega(t + 0.5 * h) * h)).normalized();
+    }
+    return tr;
+}
+
+struct NavResult
+{
+    Quat q = Quat::Identity();
+    Vec3 v = Vec3::Zero();
+};
+
+/* Nav at 100 Hz from 1 kHz mean-rate samples, with or without compensation. */
+template <typename Motion>
+NavResult integrate_nav(const Motion &m, double duration, bool compensated)
+{
+    const double     dt_imu = 1.0 / kImuHz;
+    const int        n      = static_cast<int>(std::lround(duration * kImuHz));
+    ImuPreintegrator pre;
+    NavResult        nav;
+    Vec3             sum_w = Vec3::Zero();
+    Vec3             sum_f = Vec3::Zero();
+
+    for (int i = 0; i < n; ++i)
+    {
+        const double t0 = i * dt_imu;
+        const double t1 = t0 + dt_imu;
+        const Vec3   w  = (m.omega_int(t0, t1) / dt_imu).template cast<float>();
+        const Vec3   f  = (m.force_int(t0, t1) / dt_imu).template cast<float>();
+
+        pre.add(w, f, static_cast<float>(dt_imu), static_cast<uint32_t>(i));
+        sum_w += w;
+        sum_f += f;
+
+        if ((i + 1) % kPerStep == 0)
+        {
+            const DeltaState d = pre.take();
+            if (compensated)
+            {
+                nav.v += nav.q * d.dvel;
+                nav.q = apply_delta_angle(nav.q, d.dtheta);
+            }
+            else
+            {
+                const float T = d.dt;
+                nav.v += nav.q * (sum_f / kPerStep * T);
+                nav.q = quat_integrate(nav.q, sum_w / kPerStep, T);
+            }
+            sum_w.setZero();
+            sum_f.setZero();
+        }
+    }
+    return nav;
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Trivial motion
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(Preintegration, ConstantRateSumsExactly)
+{
+    ImuPreintegrator pre;
+    const Vec3       w(0.0f, 0.0f, 2.0f);
+    for (int i = 0; i < 8; ++i)
+    {
+        pre.add(w, Vec3::Zero(), 0.00125f, static_cast<uint32_t>(i * 125));
+    }
+    const DeltaState d = pre.take();
+    EXPECT_NEAR(d.dtheta.z(), 0.02f, 1e-6f);
+    EXPECT_NEAR(d.dtheta.head<2>().norm(), 0.0f, 1e-9f);
+    EXPECT_NEAR(d.dt, 0.01f, 1e-7f);
+    EXPECT_EQ(d.samples, 8u);
+    EXPECT_EQ(d.t_end_us, 875u);
+}
+
+TEST(Preintegration, ConstantAccelNoRotation)
+{
+    ImuPreintegrator pre;
+    for (int i = 0; i < 10; ++i)
+    {
+        pre.add(Vec3::Zero(), Vec3(1.0f, -2.0f, 9.81f), 0.001f, 0);
+    }
+    const DeltaState d = pre.peek();
+    EXPECT_NEAR(d.dvel.x(), 0.01f, 1e-6f);
+    EXPECT_NEAR(d.dvel.y(), -0.02f, 1e-6f);
+    EXPECT_NEAR(d.dvel.z(), 0.0981f, 1e-6f);
+}
+
+TEST(Preintegration, RotationCompensationUnderSteadySpin)
+{
+    /* Constant spin about z with constant body-x accel: the body-x axis
+     * sweeps, so start-frame Δv gains a y component ≈ ½·α×υ. */
+    ImuPreintegrator pre;
+    const float      wz = 5.0f;
+    const float      ax = 10.0f;
+    for (int i = 0; i < 10; ++i)
+    {
+        pre.add(Vec3(0.0f, 0.0f, wz), Vec3(ax, 0.0f, 0.0f), 0.001f, 0);
+    }
+    const DeltaState d = pre.take();
+
+    /* Exact: ∫ ax·(cos wz t, sin wz t) dt over 10 ms. The algorithm is
+     * second order, so x keeps a third-order residual ax·T·(wz·T)²/6. */
+    const float T  = 0.01f;
+    const float ex = ax * std::sin(wz * T) / wz;
+    const float ey = ax * (1.0f - std::cos(wz * T)) / wz;
+    EXPECT_NEAR(d.dvel.x(), ex, 1e-4f);
+    EXPECT_NEAR(d.dvel.y(), ey, 2e-5f);
+}
+
+TEST(Preintegration, TakeStartsNewInterval)
+{
+    ImuPreintegrator pre;
+    pre.add(Vec3(1.0f, 0.0f, 0.0f), Vec3(1.0f, 0.0f, 0.0f), 0.001f, 1);
+    (void)pre.take();
+    EXPECT_EQ(pre.samples(), 0u);
+    EXPECT_FLOAT_EQ(pre.elapsed_s(), 0.0f);
+    EXPECT_FLOAT_EQ(pre.peek().dtheta.norm(), 0.0f);
+}
+
+TEST(Preintegration, NonPositiveDtIgnored)
+{
+    ImuPreintegrator pre;
+    pre.add(Vec3(1.0f, 0.0f, 0.0f), Vec3::Zero(), 0.0f, 1);
+    pre.add(Vec3(1.0f, 0.0f, 0.0f), Vec3::Zero(), -0.001f, 2);
+    EXPECT_EQ(pre.samples(), 0u);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Coning
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(PreintegrationConing, TracksHighRateTruth)
+{
+    const Coning m;
+    const double T = 2.0;
+
+    const Truth     truth = integrate_truth(m, T);
+    const NavResult comp  = integrate_nav(m, T, true);
+    const NavResult naive = integrate_nav(m, T, false);
+
+    const float err_comp  = angle_between(comp.q, truth.q);
+    const float err_naive = angle_between(naive.q, truth.q);
+
+    /* Uncompensated 100 Hz steps drift by degrees; compensation holds
+     * the error near the 1 kHz sampling limit. */
+    EXPECT_GT(err_naive, 0.01f);
+    EXPECT_LT(err_comp, 1e-5f);
+    EXPECT_LT(err_comp, 1e-3f * err_naive);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Sculling
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(PreintegrationSculling, RectifiedVelocityMatchesTruth)
+{
+    const Sculling m;
+    const double   T = 1.0;
+
+    const Truth     truth = integrate_truth(m, T);
+    const NavResult comp  = integrate_nav(m, T, true);
+    const NavResult naive = integrate_nav(m, T, false);
+
+    const Vec3  vt        = truth.v.cast<float>();
+    const float err_comp  = (comp.v - vt).norm();
+    const float err_naive = (naive.v - vt).norm();
+
+    /* Truth drifts along z (sculling rectification) */
+    EXPECT_GT(std::fabs(vt.z()), 0.1f);
+    EXPECT_GT(err_naive, 0.05f);
+    EXPECT_LT(err_comp, 1e-4f);
+    EXPECT_LT(err_comp, 1e-2f * err_naive);
+}
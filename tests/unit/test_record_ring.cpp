@@ -0,0 +1,312 @@
+/**
+ * @file test_record_ring.cpp
+ * @brief Unit tests for the indexed record ring behind the RAM log.
+ *
+ * Covers:
+ *   - push / random access / exact count, rejected lengths
+ *   - whole-record eviction over many laps with varying lengths: the live
+ *     records are always consecutive, intact, and never straddle the end
+ *   - eviction when the index (not the data) is full
+ *   - seek by timestamp: exact hit, between records, before / after the
+ *     live range, across the DWT µs clock wrap (~7.8 s) and the uint32 one
+ *   - chunked copy with a cursor, incl. a cursor overtaken by eviction
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "logger/record_ring.h"
+
+using namespace acs;
+
+namespace
+{
+
+/* Rekord testowy: [len][seq u32][wzor...] */
+constexpr size_t kRecHeader = 5;
+
+size_t make_record(uint8_t *out, uint32_t seq)
+{
+    const size_t len = kRecHeader + (seq * 13U) % 60U;
+    out[0]           = static_cast<uint8_t>(len);
+    std::memcpy(&out[1], &seq, sizeof(seq));
+    for (size_t i = kRecHeader; i < len; ++i)
+    {
+        out[i] = static_cast<uint8_t>(seq * 31U + i);
+    }
+    return len;
+}
+
+bool check_record(const uint8_t *rec, size_t len, uint32_t &seq)
+{
+    std::memcpy(&seq, &rec[1], sizeof(seq));
+    uint8_t expect[128];
+    return make_record(expect, seq) == len && std::memcmp(rec, expect, len) == 0;
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Push / access
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(RecordRing, StartsEmpty)
+{
+    RecordRing<256, 16> ring;
+    EXPECT_EQ(ring.size(), 0U);
+    EXPECT_EQ(ring.bytes(), 0U);
+    EXPECT_EQ(ring.first_seq(), ring.end_seq());
+    EXPECT_EQ(ring.seek(0), ring.end_seq());
+}
+
+TEST(RecordRing, PushAndRandomAccess)
+{
+    RecordRing<256, 16> ring;
+    const uint8_t       a[3] = {1, 2, 3};
+    const uint8_t       b[5] = {4, 5, 6, 7, 8};
+    ASSERT_TRUE(ring.push(a, sizeof(a), 100));
+    ASSERT_TRUE(ring.push(b, sizeof(b), 200));
+    EXPECT_EQ(ring.size(), 2U);
+    EXPECT_EQ(ring.bytes(), 8U);
+
+    const auto v = ring.at(ring.first_seq() + 1);
+    EXPECT_EQ(v.len, 5U);
+    EXPECT_EQ(v.time_us, 200U);
+    EXPECT_EQ(std::memcmp(v.data, b, 5), 0);
+}
+
+TEST(RecordRing, RejectsEmptyAndOversized)
+{
+    RecordRing<256, 16> ring;
+    const uint8_t       big[RecordRing<256, 16>::kMaxRecord + 1] = {};
+    EXPECT_FALSE(ring.push(big, 0, 0));
+    EXPECT_FALSE(ring.push(big, sizeof(big), 0));
+    EXPECT_TRUE(ring.push(big, sizeof(big) - 1, 0));
+    EXPECT_EQ(ring.size(), 1U);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Eviction
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(RecordRing, EvictsWholeRecordsOverManyLaps)
+{
+    RecordRing<1024, 256> ring;
+    uint8_t               rec[128];
+
+    for (uint32_t seq = 0; seq < 20000; ++seq)
+    {
+        const size_t len = make_record(rec, seq);
+        ASSERT_TRUE(ring.push(rec, len, seq * 10U));
+        ASSERT_EQ(ring.end_seq() - 1, seq);
+
+        /* Zywe rekordy: kolejne, nienaruszone, bez zawijania */
+        size_t bytes = 0;
+        for (uint32_t s = ring.first_seq(); s != ring.end_seq(); ++s)
+        {
+            const auto v      = ring.at(s);
+            uint32_t   stored = 0;
+            ASSERT_TRUE(check_record(v.data, v.len, stored)) << seq;
+            ASSERT_EQ(stored, s);
+            ASSERT_EQ(v.time_us, s * 10U);
+            bytes += v.len;
+        }
+        ASSERT_EQ(bytes, ring.bytes());
+        ASSERT_LE(ring.bytes(), 1024U);
+        ASSERT_EQ(ring.first_seq() + ring.size(), ring.end_seq());
+    }
+
+    EXPECT_EQ(ring.evicted(), ring.first_seq());
+    EXPECT_GT(ring.bytes(), 1024U / 2); /* strata na koncu okrazenia < rekord */
+}
+
+TEST(RecordRing, EvictsWhenIndexIsFull)
+{
+    RecordRing<1024, 8> ring;
+    const uint8_t       rec[4] = {};
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        ASSERT_TRUE(ring.push(rec, sizeof(rec), i));
+    }
+    EXPECT_EQ(ring.size(), 8U);
+    EXPECT_EQ(ring.first_seq(), 12U);
+    EXPECT_EQ(ring.at(12).time_us, 12U);
+    EXPECT_EQ(ring.bytes(), 32U);
+}
+
+TEST(RecordRing, ClearKeepsSequenceNumbers)
+{
+    RecordRing<256, 16> ring;
+    const uint8_t       rec[4] = {};
+    ASSERT_TRUE(ring.push(rec, sizeof(rec), 1));
+    ASSERT_TRUE(ring.push(rec, sizeof(rec), 2));
+    ring.clear();
+    EXPECT_EQ(ring.size(), 0U);
+    EXPECT_EQ(ring.first_seq(), 2U);
+    ASSERT_TRUE(ring.push(rec, sizeof(rec), 3));
+    EXPECT_EQ(ring.first_seq(), 2U);
+    EXPECT_EQ(ring.at(2).time_us, 3U);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Seek
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(RecordRing, SeekFindsFirstAtOrAfter)
+{
+    RecordRing<4096, 64> ring;
+    const uint8_t        rec[8] = {};
+    for (uint32_t i = 0; i < 50; ++i)
+    {
+        ASSERT_TRUE(ring.push(rec, sizeof(rec), 1000U + i * 100U));
+    }
+
+    EXPECT_EQ(ring.seek(1000), 0U);
+    EXPECT_EQ(ring.seek(0), 0U);       /* przed zakresem */
+    EXPECT_EQ(ring.seek(1500), 5U);    /* trafienie */
+    EXPECT_EQ(ring.seek(1501), 6U);    /* miedzy rekordami */
+    EXPECT_EQ(ring.seek(5900), 49U);
+    EXPECT_EQ(ring.seek(5901), 50U);   /* za zakresem = end_seq() */
+}
+
+TEST(RecordRing, SeekSkipsEvictedRecords)
+{
+    RecordRing<4096, 16> ring;
+    const uint8_t        rec[8] = {};
+    for (uint32_t i = 0; i < 40; ++i)
+    {
+        ASSERT_TRUE(ring.push(rec, sizeof(rec), i * 10U));
+    }
+    EXPECT_EQ(ring.first_seq(), 24U);
+    EXPECT_EQ(ring.seek(0), 24U);
+    EXPECT_EQ(ring.seek(300), 30U);
+}
+
+TEST(RecordRing, SeekAcrossTimestampWrap)
+{
+    /* Zegar DWT µs (550 MHz) zawija co ~7.8 s; ring RAM logu trzyma wiecej */
+    constexpr uint32_t kWrapUs = static_cast<uint32_t>(0x100000000ULL / 550U);
+
+    RecordRing<49152, 1024> ring(kWrapUs);
+    const uint8_t           rec[8] = {};
+    const uint32_t          t0     = kWrapUs - 1000000U; /* 1 s przed wrapem */
+    for (uint32_t i = 0; i < 1000; ++i)                  /* 2 s, co 2 ms */
+    {
+        ASSERT_TRUE(ring.push(rec, sizeof(rec), (t0 + i * 2000U) % kWrapUs));
+    }
+    ASSERT_EQ(ring.size(), 1000U);
+    const uint32_t t_last   = (t0 + 999U * 2000U) % kWrapUs;
+    const uint32_t t_window = (t_last + kWrapUs - 1500000U) % kWrapUs; /* ostatnie 1.5 s */
+
+    EXPECT_EQ(ring.seek(t0), 0U);
+    EXPECT_EQ(ring.seek(t0 + 1000U), 1U);
+    EXPECT_EQ(ring.seek(0), 500U);                     /* dokladnie na wrapie */
+    EXPECT_EQ(ring.seek(t_window), 249U);
+    EXPECT_EQ(ring.seek(t_last), 999U);
+    EXPECT_EQ(ring.seek(t_last + 1U), ring.end_seq()); /* za najnowszym */
+    EXPECT_EQ(ring.seek(t0 - 500000U), 0U);            /* przed zakresem */
+
+    /* Czas ciagly rosnie przez wrap */
+    EXPECT_EQ(ring.at(999).time_us - ring.at(0).time_us, 999U * 2000U);
+}
+
+TEST(RecordRing, SeekWithNaturalWrap)
+{
+    RecordRing<4096, 64> ring;
+    const uint8_t        rec[8] = {};
+    const uint32_t       t0     = UINT32_MAX - 2000U;
+    for (uint32_t i = 0; i < 40; ++i)
+    {
+        ASSERT_TRUE(ring.push(rec, sizeof(rec), t0 + i * 100U)); /* zawija po ~20 */
+    }
+
+    EXPECT_EQ(ring.seek(t0), 0U);
+    EXPECT_EQ(ring.seek(t0 + 1000U), 10U);
+    EXPECT_EQ(ring.seek(500U), 26U); /* t0 + 2501 → po zawinieciu */
+    EXPECT_EQ(ring.seek(t0 - 50000U), 0U);
+}
+
+TEST(RecordRing, SmallStepBackIsNotAWrap)
+{
+    constexpr uint32_t kWrapUs = 1000000U;
+
+    RecordRing<4096, 64> ring(kWrapUs);
+    const uint8_t        rec[8] = {};
+    ASSERT_TRUE(ring.push(rec, sizeof(rec), 5000));
+    ASSERT_TRUE(ring.push(rec, sizeof(rec), 4990)); /* lekko poza kolejnoscia */
+    ASSERT_TRUE(ring.push(rec, sizeof(rec), 6000));
+    EXPECT_EQ(ring.at(1).time_us, 4990U);
+    EXPECT_EQ(ring.at(2).time_us, 6000U);
+    EXPECT_EQ(ring.seek(5500), 2U);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Copy
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(RecordRing, CopyInChunksOfWholeRecords)
+{
+    RecordRing<4096, 256> ring;
+    uint8_t               rec[128];
+    for (uint32_t seq = 0; seq < 100; ++seq)
+    {
+        ASSERT_TRUE(ring.push(rec, make_record(rec, seq), seq));
+    }
+
+    uint32_t             cur = ring.first_seq();
+    const uint32_t       end = ring.end_seq();
+    std::vector<uint8_t> out(100);
+    uint32_t             next = 0;
+    while (cur != end)
+    {
+        const size_t n = ring.copy(cur, end, out.data(), out.size());
+        ASSERT_GT(n, 0U);
+        for (size_t pos = 0; pos < n; pos += out[pos])
+        {
+            uint32_t seq = 0;
+            ASSERT_TRUE(check_record(&out[pos], out[pos], seq));
+            ASSERT_EQ(seq, next++);
+        }
+    }
+    EXPECT_EQ(next, 100U);
+    EXPECT_EQ(ring.copy(cur, end, out.data(), out.size()), 0U);
+}
+
+TEST(RecordRing, CopySkipsRecordsEvictedSinceSnapshot)
+{
+    RecordRing<512, 64> ring;
+    uint8_t             rec[128];
+    uint32_t            seq = 0;
+    for (; seq < 10; ++seq)
+    {
+        ASSERT_TRUE(ring.push(rec, make_record(rec, seq), seq));
+    }
+
+    uint32_t       cur = ring.first_seq();
+    const uint32_t end = ring.end_seq();
+    for (; seq < 200; ++seq) /* nadpisuje caly snapshot */
+    {
+        ASSERT_TRUE(ring.push(rec, make_record(rec, seq), seq));
+    }
+
+    uint8_t out[512];
+    EXPECT_EQ(ring.copy(cur, end, out, sizeof(out)), 0U);
+    EXPECT_EQ(cur, ring.first_seq()); /* kursor przesuniety, koniec snapshotu minal */
+}
+
+TEST(RecordRing, CopyStopsAtRecordThatDoesNotFit)
+{
+    RecordRing<256, 16> ring;
+    const uint8_t       rec[10] = {};
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(ring.push(rec, sizeof(rec), 0));
+    }
+    uint32_t cur = ring.first_seq();
+    uint8_t  out[64];
+    EXPECT_EQ(ring.copy(cur, ring.end_seq(), out, 25), 20U);
+    EXPECT_EQ(ring.copy(cur, ring.end_seq(), out, 9), 0U);
+    EXPECT_EQ(ring.copy(cur, ring.end_seq(), out, 10), 10U);
+}
@@ -0,0 +1,313 @@
+/**
+ * @file test_sample_ring.cpp
+ * @brief Unit tests for the multi-consumer SampleRing and SensorHub history.
+ *
+ * Covers:
+ *   - Batch read, partial reads, empty ring
+ *   - Independent cursors (late subscribe, multiple consumers)
+ *   - Overrun accounting when a consumer falls behind
+ *   - Concurrent stress: one producer, several consumers (std::thread);
+ *     every sample is either delivered in order or counted as an overrun.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "sensors/sensor_hub.h"
+#include "utils/sample_ring.h"
+
+namespace
+{
+
+struct Sample
+{
+    uint32_t timestamp_us;
+    uint32_t value[5];
+    uint32_t check;
+};
+
+Sample make_sample(uint32_t n)
+{
+    Sample s{};
+    s.timestamp_us = n;
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        s.value[i] = n * 40503U + i;
+    }
+    s.check = ~n;
+    return s;
+}
+
+bool is_consistent(const Sample &s)
+{
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        if (s.value[i] != s.timestamp_us * 40503U + i)
+        {
+            return false;
+        }
+    }
+    return s.check == ~s.timestamp_us;
+}
+
+using Ring = acs::SampleRing<Sample, 16>;
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Single thread
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(SampleRing, EmptyRingReadsNothing)
+{
+    Ring              ring;
+    acs::SampleCursor cur = ring.subscribe();
+    Sample            out[4];
+    EXPECT_EQ(ring.available(cur), 0u);
+    EXPECT_EQ(ring.read(cur, out, 4), 0u);
+    EXPECT_FALSE(ring.latest(out[0]));
+}
+
+TEST(SampleRing, BatchReadInOrder)
+{
+    Ring              ring;
+    acs::SampleCursor cur = ring.subscribe();
+    for (uint32_t n = 1; n <= 10; ++n)
+    {
+        ring.push(make_sample(n));
+    }
+    EXPECT_EQ(ring.available(cur), 10u);
+
+    Sample out[16];
+    ASSERT_EQ(ring.read(cur, out, 4), 4u);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(out[i].timestamp_us, i + 1);
+    }
+    ASSERT_EQ(ring.read(cur, out, 16), 6u);
+    EXPECT_EQ(out[0].timestamp_us, 5u);
+    EXPECT_EQ(out[5].timestamp_us, 10u);
+    EXPECT_EQ(cur.overruns, 0u);
+}
+
+TEST(SampleRing, LateSubscriberSeesOnlyNewSamples)
+{
+    Ring ring;
+    for (uint32_t n = 1; n <= 5; ++n)
+    {
+        ring.push(make_sample(n));
+    }
+    acs::SampleCursor cur = ring.subscribe();
+    ring.push(make_sample(6));
+
+    Sample out[4];
+    ASSERT_EQ(ring.read(cur, out, 4), 1u);
+    EXPECT_EQ(out[0].timestamp_us, 6u);
+}
+
+TEST(SampleRing, ConsumersAreIndependent)
+{
+    Ring              ring;
+    acs::SampleCursor a = ring.subscribe();
+    acs::SampleCursor b = ring.subscribe();
+    for (uint32_t n = 1; n <= 8; ++n)
+    {
+        ring.push(make_sample(n));
+    }
+
+    Sample out[8];
+    EXPECT_EQ(ring.read(a, out, 8), 8u);
+    EXPECT_EQ(ring.available(a), 0u);
+    EXPECT_EQ(ring.available(b), 8u);
+    ASSERT_EQ(ring.read(b, out, 8), 8u);
+    EXPECT_EQ(out[0].timestamp_us, 1u);
+}
+
+TEST(SampleRing, OverrunSkipsToOldestAndCounts)
+{
+    Ring              ring;
+    acs::SampleCursor cur = ring.subscribe();
+    for (uint32_t n = 1; n <= 40; ++n)
+    {
+        ring.push(make_sample(n));
+    }
+    EXPECT_EQ(ring.available(cur), Ring::kCapacity);
+
+    Sample out[32];
+    ASSERT_EQ(ring.read(cur, out, 32), Ring::kCapacity);
+    EXPECT_EQ(cur.overruns, 40u - Ring::kCapacity);
+    EXPECT_EQ(out[0].timestamp_us, 40u - Ring::kCapacity + 1);
+    EXPECT_EQ(out[Ring::kCapacity - 1].timestamp_us, 40u);
+}
+
+TEST(SampleRing, LatestReturnsNewest)
+{
+    Ring ring;
+    for (uint32_t n = 1; n <= 20; ++n)
+    {
+        ring.push(make_sample(n));
+    }
+    Sample s{};
+    ASSERT_TRUE(ring.latest(s));
+    EXPECT_EQ(s.timestamp_us, 20u);
+    EXPECT_EQ(ring.total(), 20u);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * Concurrent stress
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(SampleRingStress, EverySampleDeliveredOrCounted)
+{
+    constexpr uint32_t kPushes    = 300000;
+    constexpr int      kConsumers = 3;
+
+    acs::SampleRing<Sample, 64> ring;
+    std::atomic<bool>           done{false};
+
+    struct Result
+    {
+        uint32_t start    = 0;
+        uint32_t received = 0;
+        uint32_t overruns = 0;
+        uint32_t errors   = 0;
+    };
+    std::vector<Result>      results(kConsumers);
+    std::vector<std::thread> consumers;
+
+    for (int c = 0; c < kConsumers; ++c)
+    {
+        consumers.emplace_back([&, c] {
+            acs::SampleCursor cur = ring.subscribe();
+            Result           &res = results[c];
+            uint32_t          last = cur.next;
+            Sample            batch[8];
+            res.start = cur.next;
+
+            auto drain = [&] {
+                size_t n;
+                while ((n = ring.read(cur, batch, 8 - static_cast<size_t>(c))) > 0)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        if (!is_consistent(batch[i]) || batch[i].timestamp_us <= last)
+                        {
+                            ++res.errors;
+                        }
+                        last = batch[i].timestamp_us;
+                    }
+                    res.received += static_cast<uint32_t>(n);
+                }
+            };
+
+            while (!done.load(std::memory_order_acquire))
+            {
+                drain();
+            }
+            drain();
+            res.overruns = cur.overruns;
+        });
+    }
+
+    /* Consumers may subscribe after the first pushes; accounting is
+     * relative to each cursor's own starting point. */
+    for (uint32_t n = 1; n <= kPushes; ++n)
+    {
+        ring.push(make_sample(n));
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &t : consumers)
+    {
+        t.join();
+    }
+
+    for (const auto &res : results)
+    {
+        EXPECT_EQ(res.errors, 0u);
+        EXPECT_EQ(res.received + res.overruns, kPushes - res.start);
+    }
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * SensorHub history
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(SensorHubHistory, ImuRingKeepsEverySample)
+{
+    acs::SensorHub    hub;
+    acs::SampleCursor nav    = hub.imu_history().subscribe();
+    acs::SampleCursor logger = hub.imu_history().subscribe();
+
+    for (uint32_t n = 1; n <= 100; ++n)
+    {
+        const float v = static_cast<float>(n);
+        hub.update_imu({v, 0.0f, 0.0f}, {0.0f, 0.0f, v}, 25.0f, n * 1000);
+    }
+
+    acs::ImuReading batch[128];
+    ASSERT_EQ(hub.imu_history().read(nav, batch, 128), 100u);
+    EXPECT_EQ(batch[0].timestamp_us, 1000u);
+    EXPECT_EQ(batch[99].timestamp_us, 100000u);
+    EXPECT_FLOAT_EQ(batch[99].gyro_rads[2], 100.0f);
+
+    ASSERT_EQ(hub.imu_history().read(logger, batch, 50), 50u);
+    EXPECT_EQ(hub.imu_history().available(logger), 50u);
+    EXPECT_EQ(nav.overruns + logger.overruns, 0u);
+}
+
+TEST(SensorHubHistory, BaroAndMagRingsIndependentOfSnapshot)
+{
+    acs::SensorHub    hub;
+    acs::SampleCursor baro = hub.baro_history().subscribe();
+    acs::SampleCursor mag  = hub.mag_history().subscribe();
+
+    hub.update_baro(101325.0f, 20.0f, 0.0f, 10);
+    hub.update_baro(101300.0f, 20.0f, 2.0f, 20);
+    hub.update_mag({1.0f, 2.0f, 3.0f}, 15);
+
+    /* snapshot() consuming the fresh flags must not affect ring cursors */
+    (void)hub.snapshot();
+
+    acs::BaroReading b[4];
+    acs::MagReading  m[4];
+    ASSERT_EQ(hub.baro_history().read(baro, b, 4), 2u);
+    EXPECT_FLOAT_EQ(b[1].altitude_m, 2.0f);
+    ASSERT_EQ(hub.mag_history().read(mag, m, 4), 1u);
+    EXPECT_EQ(m[0].timestamp_us, 15u);
+}
+
+TEST(SensorHubHistory, ImuBatchPushesAllAndLatchesNewest)
+{
+    acs::SensorHub    hub;
+    acs::SampleCursor cur = hub.imu_history().subscribe();
+
+    acs::ImuReading fifo[8]{};
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        fifo[i].timestamp_us = 1000 + i * 125; /* 8 kHz burst */
+        fifo[i].gyro_rads    = {0.0f, 0.0f, static_cast<float>(i)};
+        fifo[i].temp_c       = 30.0f;
+    }
+    hub.update_imu_batch(fifo, 8);
+
+    acs::ImuReading out[8];
+    ASSERT_EQ(hub.imu_history().read(cur, out, 8), 8u);
+    EXPECT_EQ(out[0].timestamp_us, 1000u);
+    EXPECT_EQ(out[7].timestamp_us, 1875u);
+
+    const auto s = hub.snapshot();
+    EXPECT_TRUE(s.imu_valid);
+    EXPECT_EQ(s.imu_timestamp_us, 1875u);
+    EXPECT_FLOAT_EQ(s.gyro_rads[2], 7.0f);
+}
+
+TEST(SensorHubHistory, EmptyImuBatchIsIgnored)
+{
+    acs::SensorHub hub;
+    hub.update_imu_batch(nullptr, 4);
+    EXPECT_EQ(hub.imu_history().total(), 0u);
+    EXPECT_FALSE(hub.snapshot().imu_valid);
+}
@@ -0,0 +1,326 @@
+/**
+ * @file test_seqlock.cpp
+ * @brief Unit tests for the SeqLatch publication primitive and SensorHub.
+ *
+ * Covers:
+ *   - SeqLatch single-thread semantics (sequence numbering, round-trip)
+ *   - Concurrent stress: one writer per latch, several readers, std::thread.
+ *     Every published value is self-consistent (all fields derived from one
+ *     counter), so any torn copy is detected immediately.
+ *   - SensorHub: per-section publication, fresh flags, board-frame rotation,
+ *     and a concurrent stress over all three sections.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "sensors/sensor_hub.h"
+#include "utils/seqlock.h"
+
+namespace
+{
+
+/* ~64 bytes: large enough that a copy spans many words. */
+struct Payload
+{
+    uint32_t counter;
+    uint32_t words[14];
+    uint32_t check;
+};
+
+Payload make_payload(uint32_t n)
+{
+    Payload p{};
+    p.counter = n;
+    for (uint32_t i = 0; i < 14; ++i)
+    {
+        p.words[i] = n * 2654435761U + i;
+    }
+    p.check = ~n;
+    return p;
+}
+
+bool is_consistent(const Payload &p)
+{
+    if (p.check != ~p.counter)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < 14; ++i)
+    {
+        if (p.words[i] != p.counter * 2654435761U + i)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr uint32_t kStressWrites  = 200000;
+constexpr int      kStressReaders = 3;
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * SeqLatch — single thread
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(SeqLatch, StartsAtSequenceZero)
+{
+    acs::SeqLatch<Payload> latch;
+    Payload                out{};
+    EXPECT_EQ(latch.sequence(), 0u);
+    EXPECT_EQ(latch.read(out), 0u);
+    EXPECT_EQ(out.counter, 0u);
+}
+
+TEST(SeqLatch, WriteAdvancesSequenceByTwo)
+{
+    acs::SeqLatch<Payload> latch;
+    latch.write(make_payload(1));
+    EXPECT_EQ(latch.sequence(), 2u);
+    latch.write(make_payload(2));
+    EXPECT_EQ(latch.sequence(), 4u);
+}
+
+TEST(SeqLatch, ReadReturnsLastWrite)
+{
+    acs::SeqLatch<Payload> latch;
+    for (uint32_t n = 1; n <= 10; ++n)
+    {
+        latch.write(make_payload(n));
+        Payload out{};
+        EXPECT_EQ(latch.read(out), 2 * n);
+        EXPECT_EQ(out.counter, n);
+        EXPECT_TRUE(is_consistent(out));
+    }
+}
+
+TEST(SeqLatch, OddSizedPayloadRoundTrips)
+{
+    struct Odd
+    {
+        uint8_t bytes[7];
+    };
+    acs::SeqLatch<Odd> latch;
+    latch.write(Odd{{1, 2, 3, 4, 5, 6, 7}});
+    const Odd out = latch.read();
+    for (int i = 0; i < 7; ++i)
+    {
+        EXPECT_EQ(out.bytes[i], i + 1);
+    }
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * SeqLatch — concurrent stress
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(SeqLatchStress, ReadersNeverSeeTornValue)
+{
+    acs::SeqLatch<Payload> latch;
+    std::atomic<bool>      done{false};
+    std::atomic<uint32_t>  torn{0};
+    std::atomic<uint32_t>  backwards{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kStressReaders; ++r)
+    {
+        readers.emplace_back([&] {
+            uint32_t last_counter = 0;
+            uint32_t last_seq     = 0;
+            while (!done.load(std::memory_order_acquire))
+            {
+                Payload        p{};
+                const uint32_t seq = latch.read(p);
+                if (seq == 0)
+                {
+                    continue; /* nothing published yet (zero-initialised) */
+                }
+                if (!is_consistent(p))
+                {
+                    torn.fetch_add(1);
+                }
+                /* Sequence and payload must stay paired and monotonic. */
+                if (seq != 2 * p.counter || seq < last_seq || p.counter < last_counter)
+                {
+                    backwards.fetch_add(1);
+                }
+                last_seq     = seq;
+                last_counter = p.counter;
+            }
+        });
+    }
+
+    for (uint32_t n = 1; n <= kStressWrites; ++n)
+    {
+        latch.write(make_payload(n));
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &t : readers)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0u);
+    EXPECT_EQ(backwards.load(), 0u);
+    EXPECT_EQ(latch.read().counter, kStressWrites);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ * SensorHub
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(SensorHub, InvalidBeforeFirstUpdate)
+{
+    acs::SensorHub hub;
+    const auto     s = hub.snapshot();
+    EXPECT_FALSE(s.imu_valid);
+    EXPECT_FALSE(s.baro_valid);
+    EXPECT_FALSE(s.mag_valid);
+    EXPECT_FALSE(s.baro_fresh);
+    EXPECT_FALSE(s.mag_fresh);
+}
+
+TEST(SensorHub, FreshFlagsSetOncePerSample)
+{
+    acs::SensorHub hub;
+    hub.update_baro(101325.0f, 20.0f, 0.0f, 100);
+    hub.update_mag({1.0f, 2.0f, 3.0f}, 200);
+
+    auto s = hub.snapshot();
+    EXPECT_TRUE(s.baro_valid);
+    EXPECT_TRUE(s.baro_fresh);
+    EXPECT_TRUE(s.mag_valid);
+    EXPECT_TRUE(s.mag_fresh);
+
+    s = hub.snapshot();
+    EXPECT_TRUE(s.baro_valid);
+    EXPECT_FALSE(s.baro_fresh);
+    EXPECT_TRUE(s.mag_valid);
+    EXPECT_FALSE(s.mag_fresh);
+
+    hub.update_baro(101300.0f, 20.0f, 2.0f, 300);
+    s = hub.snapshot();
+    EXPECT_TRUE(s.baro_fresh);
+    EXPECT_FALSE(s.mag_fresh);
+    EXPECT_FLOAT_EQ(s.altitude_m, 2.0f);
+    EXPECT_EQ(s.baro_timestamp_us, 300u);
+}
+
+#ifndef ACS4_LAYOUT_JEDRZEJ
+TEST(SensorHub, DefaultLayoutRotations)
+{
+    acs::SensorHub hub;
+    hub.update_imu({1.0f, 2.0f, 3.0f}, {0.1f, 0.2f, 0.3f}, 25.0f, 42);
+    hub.update_mag({1.0f, 2.0f, 3.0f}, 43);
+
+    const auto s = hub.snapshot();
+    EXPECT_TRUE(s.imu_valid);
+    EXPECT_EQ(s.imu_timestamp_us, 42u);
+    EXPECT_FLOAT_EQ(s.accel_mps2[0], 1.0f);
+    EXPECT_FLOAT_EQ(s.gyro_rads[2], 0.3f);
+    EXPECT_FLOAT_EQ(s.imu_temp_c, 25.0f);
+
+    /* board = (+my, -mx, -mz) */
+    EXPECT_FLOAT_EQ(s.mag_ut[0], 2.0f);
+    EXPECT_FLOAT_EQ(s.mag_ut[1], -1.0f);
+    EXPECT_FLOAT_EQ(s.mag_ut[2], -3.0f);
+}
+#endif
+
+TEST(SensorHubStress, ConcurrentWritersAndReadersNeverTear)
+{
+    acs::SensorHub        hub;
+    std::atomic<int>      writers_left{3};
+    std::atomic<uint32_t> torn{0};
+
+    /* Every field of a section is derived from the same counter v.
+     * Mag input (-v, v, -v) maps to board (v, v, v) in the default layout;
+     * under ACS4_LAYOUT_JEDRZEJ it maps to (-v, -v, v) — compare magnitudes. */
+    std::thread imu_writer([&] {
+        for (uint32_t n = 1; n <= kStressWrites; ++n)
+        {
+            const float v = static_cast<float>(n);
+            hub.update_imu({v, v, v}, {v, v, v}, v, n);
+        }
+        writers_left.fetch_sub(1);
+    });
+    std::thread baro_writer([&] {
+        for (uint32_t n = 1; n <= kStressWrites; ++n)
+        {
+            const float v = static_cast<float>(n);
+            hub.update_baro(v, v, v, n);
+        }
+        writers_left.fetch_sub(1);
+    });
+    std::thread mag_writer([&] {
+        for (uint32_t n = 1; n <= kStressWrites; ++n)
+        {
+            const float v = static_cast<float>(n);
+            hub.update_mag({-v, v, -v}, n);
+        }
+        writers_left.fetch_sub(1);
+    });
+
+    auto check = [&](const acs::SensorSnapshot &s) {
+        const float imu_v = static_cast<float>(s.imu_timestamp_us);
+        for (int i = 0; i < 3; ++i)
+        {
+            if (s.accel_mps2[i] != imu_v || s.gyro_rads[i] != imu_v)
+            {
+                torn.fetch_add(1);
+            }
+        }
+        if (s.imu_temp_c != imu_v)
+        {
+            torn.fetch_add(1);
+        }
+
+        const float baro_v = static_cast<float>(s.baro_timestamp_us);
+        if (s.pressure_pa != baro_v || s.baro_temp_c != baro_v || s.altitude_m != baro_v)
+        {
+            torn.fetch_add(1);
+        }
+
+        const float mag_v = static_cast<float>(s.mag_timestamp_us);
+        for (int i = 0; i < 3; ++i)
+        {
+            const float m = s.mag_ut[i] < 0.0f ? -s.mag_ut[i] : s.mag_ut[i];
+            if (m != mag_v)
+            {
+                torn.fetch_add(1);
+            }
+        }
+    };
+
+    /* Several snapshot() callers on purpose: the _fresh flags are then
+     * meaningless, but every section must still be consistent. */
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kStressReaders; ++r)
+    {
+        readers.emplace_back([&] {
+            while (writers_left.load(std::memory_order_acquire) > 0)
+            {
+                check(hub.snapshot());
+            }
+        });
+    }
+
+    imu_writer.join();
+    baro_writer.join();
+    mag_writer.join();
+    for (auto &t : readers)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0u);
+    const auto s = hub.snapshot();
+    EXPECT_EQ(s.imu_timestamp_us, kStressWrites);
+    EXPECT_EQ(s.baro_timestamp_us, kStressWrites);
+    EXPECT_EQ(s.mag_timestamp_us, kStressWrites);
+}
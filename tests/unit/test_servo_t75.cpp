@@ -6,6 +6,9 @@
  *   - angle_to_pulse_us:  angle (deg) → pulse width (µs) with trim,
  *                         direction sign, software clamp, hardware clamp.
  *   - slew_step:          rate-limited move from current pulse toward target.
+ *   - slew_step_us:       same with a measured µs interval.
+ *   - stage_burst / burst_apply: TIM DMA-burst staging against a shadow
+ *                         register model (DCR.DBA / DBL, CCR order).
  *
  * No hardware dependency — exercised on host via Google Test.
  */
@@ -151,3 +154,76 @@ TEST(ServoSlew, NegativeRateKeepsCurrent)
 {
     EXPECT_EQ(acs::servo_t75::slew_step(1500, 1700, -1.0f, 10), 1500);
 }
+
+TEST(ServoSlew, MicrosecondDtMatchesMillisecond)
+{
+    EXPECT_EQ(acs::servo_t75::slew_step_us(1500, 1700, 2.0f, 10000),
+              acs::servo_t75::slew_step(1500, 1700, 2.0f, 10));
+}
+
+TEST(ServoSlew, MicrosecondDtUsesTrueInterval)
+{
+    /* 2 µs/ms * 2.5 ms (400 Hz) = 5 µs; 3.03 ms (ramka 330 Hz) ≈ 6 µs */
+    EXPECT_EQ(acs::servo_t75::slew_step_us(1500, 1700, 2.0f, 2500), 1505);
+    EXPECT_EQ(acs::servo_t75::slew_step_us(1500, 1700, 2.0f, 3030), 1506);
+    EXPECT_EQ(acs::servo_t75::slew_step_us(1700, 1500, 2.0f, 2500), 1695);
+    EXPECT_EQ(acs::servo_t75::slew_step_us(1500, 1700, 2.0f, 0), 1500);
+}
+
+/* ═════════════════════════════════════════════════════════════════════
+ * DMA burst staging (TIM4 DCR / DMAR shadow model)
+ * ═════════════════════════════════════════════════════════════════════ */
+
+TEST(ServoBurst, DcrAddressesCcr1ThroughCcr4)
+{
+    EXPECT_EQ(acs::servo_t75::kTimDcrDba, 13u);
+    EXPECT_EQ(acs::servo_t75::kTimDcrDbl, 3u);
+    EXPECT_EQ(acs::servo_t75::kTimDcrBurstCcr, 0x030Du);
+}
+
+TEST(ServoBurst, StagingFollowsFinToChannelMap)
+{
+    /* Plytka produkcyjna: fin 1..4 → CH4..CH1 */
+    const uint16_t pulses[4]    = {1510, 1620, 1430, 1390};
+    const uint8_t  fin_to_ch[4] = {3, 2, 1, 0};
+    uint32_t       burst[4]     = {};
+    acs::servo_t75::stage_burst(pulses, fin_to_ch, burst);
+
+    EXPECT_EQ(burst[0], 1390u); /* CCR1 = fin 4 */
+    EXPECT_EQ(burst[1], 1430u);
+    EXPECT_EQ(burst[2], 1620u);
+    EXPECT_EQ(burst[3], 1510u); /* CCR4 = fin 1 */
+}
+
+TEST(ServoBurst, ShadowBurstUpdatesAllFourCcrOnly)
+{
+    acs::servo_t75::TimShadow tim{};
+    for (auto &r : tim.regs)
+    {
+        r = 0xDEADBEEFu;
+    }
+
+    const uint16_t pulses[4]    = {1500, 1600, 1400, 1300};
+    const uint8_t  fin_to_ch[4] = {3, 2, 1, 0};
+    uint32_t       burst[4]     = {};
+    acs::servo_t75::stage_burst(pulses, fin_to_ch, burst);
+
+    EXPECT_EQ(acs::servo_t75::burst_apply(tim, acs::servo_t75::kTimDcrBurstCcr, burst), 4u);
+
+    /* Kazda pletwa w swoim kanale, w tej samej "ramce" */
+    for (size_t fin = 0; fin < 4; ++fin)
+    {
+        EXPECT_EQ(tim.ccr(fin_to_ch[fin]), pulses[fin]) << "fin " << fin + 1;
+    }
+    EXPECT_EQ(tim.regs[acs::servo_t75::kTimDcrDba - 1], 0xDEADBEEFu); /* CCMR2 */
+    EXPECT_EQ(tim.regs[acs::servo_t75::kTimDcrDba + 4], 0xDEADBEEFu); /* BDTR  */
+}
+
+TEST(ServoBurst, ShadowRejectsBurstPastAddressableRange)
+{
+    acs::servo_t75::TimShadow tim{};
+    const uint32_t            words[4] = {1, 2, 3, 4};
+    EXPECT_EQ(acs::servo_t75::burst_apply(tim, (3u << 8) | 0x1Eu, words), 0u);
+    EXPECT_EQ(acs::servo_t75::burst_apply(tim, (3u << 8) | 0x1Cu, words), 4u);
+    EXPECT_EQ(tim.regs[0x1F], 4u);
+}
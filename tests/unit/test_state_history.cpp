@@ -0,0 +1,201 @@
+/**
+ * @file test_state_history.cpp
+ * @brief Unit tests for the delayed-fusion state history.
+ *
+ * Coverage:
+ *   - lookup: exact hit, interpolation (lerp + slerp), clamping, too old
+ *   - ring overwrite, DWT-style timestamp wrap
+ *   - end-to-end: delayed baro on a 100 m/s climb, fused at sample time
+ *     vs. naively as if current
+ */
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "navigation/state_history.h"
+
+using namespace acs::nav;
+
+namespace
+{
+
+NavState make_state(float k)
+{
+    NavState x;
+    x.q  = quat_from_euler(0.0f, 0.0f, 0.1f * k);
+    x.v  = Vec3(k, 2.0f * k, -k);
+    x.p  = Vec3(10.0f * k, 0.0f, -5.0f * k);
+    x.bg = Vec3::Zero();
+    x.ba = Vec3::Zero();
+    return x;
+}
+
+}  // namespace
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Lookup
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+TEST(StateHistory, EmptyReturnsFalse)
+{
+    StateHistory<8> h;
+    NavState        x;
+    EXPECT_FALSE(h.at(1000, x));
+    EXPECT_EQ(h.size(), 0u);
+}
+
+TEST(StateHistory, ExactAndInterpolated)
+{
+    StateHistory<16> h;
+    for (int i = 0; i < 10; ++i)
+    {
+        h.push(1000U + static_cast<uint32_t>(i) * 1000U, make_state(static_cast<float>(i)));
+    }
+
+    NavState x;
+    ASSERT_TRUE(h.at(4000, x));
+    EXPECT_FLOAT_EQ(x.v.x(), 3.0f);
+
+    /* 1/4 drogi miedzy wpisami 3 (4000 µs) i 4 (5000 µs) */
+    ASSERT_TRUE(h.at(4250, x));
+    EXPECT_NEAR(x.v.x(), 3.25f, 1e-5f);
+    EXPECT_NEAR(x.p.z(), -16.25f, 1e-4f);
+
+    float r = 0.0f, p = 0.0f, y = 0.0f;
+    quat_to_euler(x.q, r, p, y);
+    EXPECT_NEAR(y, 0.325f, 1e-5f);
+}
+
+TEST(StateHistory, ClampsFutureAndRejectsTooOld)
+{
+    StateHistory<16> h;
+    for (int i = 0; i < 10; ++i)
+    {
+        h.push(1000U + static_cast<uint32_t>(i) * 1000U, make_state(static_cast<float>(i)));
+    }
+
+    NavState x;
+    ASSERT_TRUE(h.at(20000, x)); /* nowszy niz najnowszy → najnowszy */
+    EXPECT_FLOAT_EQ(x.v.x(), 9.0f);
+
+    ASSERT_TRUE(h.at(1000, x)); /* dokladnie najstarszy */
+    EXPECT_FLOAT_EQ(x.v.x(), 0.0f);
+
+    EXPECT_FALSE(h.at(999, x));
+    EXPECT_EQ(h.span_us(), 9000u);
+}
+
+TEST(StateHistory, OverwritesOldest)
+{
+    StateHistory<4> h;
+    for (int i = 0; i < 10; ++i)
+    {
+        h.push(static_cast<uint32_t>(i) * 100U, make_state(static_cast<float>(i)));
+    }
+
+    EXPECT_EQ(h.size(), 4u);
+    EXPECT_EQ(h.newest_us(), 900u);
+
+    NavState x;
+    EXPECT_FALSE(h.at(500, x));
+    ASSERT_TRUE(h.at(650, x));
+    EXPECT_NEAR(x.v.x(), 6.5f, 1e-5f);
+}
+
+TEST(StateHistory, HandlesTimestampWrap)
+{
+    constexpr uint32_t kWrap = 7809031; /* 2³² / 550 — DWT µs na H725 */
+    StateHistory<16>   h(kWrap);
+
+    /* Wpisy co 1 ms przez punkt zawiniecia */
+    for (int i = 0; i < 10; ++i)
+    {
+        const uint32_t t = (kWrap - 5000U + static_cast<uint32_t>(i) * 1000U) % kWrap;
+        h.push(t, make_state(static_cast<float>(i)));
+    }
+
+    NavState x;
+    ASSERT_TRUE(h.at(kWrap - 500U, x)); /* miedzy wpisami 4 i 5 */
+    EXPECT_NEAR(x.v.x(), 4.5f, 1e-4f);
+    ASSERT_TRUE(h.at(1500U, x)); /* po zawinieciu, miedzy 6 i 7 */
+    EXPECT_NEAR(x.v.x(), 6.5f, 1e-4f);
+    ASSERT_TRUE(h.at(kWrap - 5000U, x));
+    EXPECT_NEAR(x.v.x(), 0.0f, 1e-5f);
+}
+
+/* ═══════════════════════════════════════════════════════════════════════════
+ *  Delayed baro fusion
+ * ═══════════════════════════════════════════════════════════════════════════ */
+
+namespace
+{
+
+/* Wznoszenie 100 m/s; baro (idealne) opoznione o 20 ms, 50 Hz.
+ * Zwraca maksymalny blad wysokosci w ostatniej sekundzie. */
+float run_climb(bool delayed)
+{
+    constexpr float    kVz      = -100.0f; /* NED: w gore */
+    constexpr uint32_t kStepUs  = 1000;
+    constexpr uint32_t kDelayUs = 20000;
+
+    EskfConfig cfg   = EskfConfig::rocket_default();
+    cfg.baro_noise_m = 0.1f;
+    Eskf f;
+    f.init(cfg, quat_identity());
+    NavState x0 = f.state();
+    x0.v        = Vec3(0.0f, 0.0f, kVz);
+    f.restore(x0, f.covariance());
+    f.set_baro_reference(0.0f);
+
+    StateHistory<64> hist;
+    float            max_err = 0.0f;
+
+    for (uint32_t k = 1; k <= 3000; ++k)
+    {
+        const uint32_t t = k * kStepUs;
+
+        DeltaState d;
+        d.dtheta   = Vec3::Zero();
+        d.dvel     = Vec3(0.0f, 0.0f, -kGravity) * 1e-3f; /* stala predkosc */
+        d.dt       = 1e-3f;
+        d.samples  = 1;
+        d.t_end_us = t;
+        (void)f.predict(d);
+        hist.push(t, f.state());
+
+        /* Pomiar z chwili t - 20 ms dociera teraz */
+        if (k % 20 == 0 && t > kDelayUs)
+        {
+            const uint32_t t_meas = t - kDelayUs;
+            const float    alt    = -kVz * static_cast<float>(t_meas) * 1e-6f;
+            NavState       past;
+            if (delayed && hist.at(t_meas, past))
+            {
+                (void)f.update_baro(alt, past);
+            }
+            else
+            {
+                (void)f.update_baro(alt);
+            }
+        }
+
+        if (k > 2000)
+        {
+            const float truth = kVz * static_cast<float>(t) * 1e-6f;
+            max_err           = std::fmax(max_err, std::fabs(f.state().p.z() - truth));
+        }
+    }
+    return max_err;
+}
+
+}  // namespace
+
+TEST(StateHistory, DelayedBaroRemovesLagError)
+{
+    const float naive   = run_climb(false);
+    const float delayed = run_climb(true);
+
+    /* Naiwnie: pomiar "spoznia sie" o 100 m/s × 20 ms = 2 m */
+    EXPECT_GT(naive, 0.5f);
+    EXPECT_LT(delayed, 0.05f);
+}
@@ -8,6 +8,16 @@ The binary format mirrors the packed C structs defined in
 ``src/logger/log_format.h``.  All multi-byte values are little-endian
 (ARM Cortex-M7 native).
 
+Since format v5 records travel in CRC-32 frames: a torn or garbled write
+costs only the frames it touches, the decoder resynchronises on the next
+frame sync word.
+
+Since format v4 the file header is followed by a schema block describing
+every message type (``LOG_SCHEMA``).  Types this decoder does not know are
+decoded from the schema alone into ``<name>.csv``; known types are checked
+against it, so a drift between the firmware and this file is reported
+instead of silently misparsed.
+
 Usage::
 
     # Decode to CSV (one file per message type)
@@ -18,13 +28,20 @@ Usage::
 
     # Dump all records to stdout
     python tools/log_decoder.py LOG_001.BIN --dump
+
+For multi-hundred-MB logs use the native decoder built in the ``tests/``
+CMake tree (``acs4_logdec``, ``tests/tools/``): same CSV files, plus a
+binary columnar format and a timestamp index.
 """
 
 from __future__ import annotations
 
 import argparse
+import io
+import re
 import struct
 import sys
+import zlib
 from dataclasses import dataclass, field
 from pathlib import Path
 from typing import BinaryIO
@@ -34,18 +51,21 @@ from typing import BinaryIO
 # ---------------------------------------------------------------------------
 
 FILE_MAGIC = b"ACS4"
-FORMAT_VERSION = 1
+FORMAT_VERSION = 5
 
 HEADER_SIZE = 5  # uint8 msg_id + uint32 timestamp_us
 FILE_HEADER_SIZE = 14  # magic(4) + version(2) + sysclk(4) + boot_ms(4)
 
 # Message IDs
+MSG_PAD = 0x00  # padding byte, never a record (unwritten preallocated tail)
 MSG_IMU = 0x01
 MSG_NAV = 0x02
 MSG_CTRL = 0x03
 MSG_BARO = 0x04
 MSG_MAG = 0x05
 MSG_EVENT = 0x06
+MSG_IMU_DELTA = 0x07  # variable length, see decode_imu_delta()
+MSG_IMU_BLOCK = 0x08  # fixed part + payload_len bytes, see decode_imu_block()
 
 # struct formats (little-endian)
 FMT_HEADER = "<BI"  # msg_id(u8), timestamp_us(u32)
@@ -56,6 +76,10 @@ FMT_CTRL = "<BI4hB"  # header + servo[4] + flight_state
 FMT_BARO = "<BIIi"  # header + pressure_pa(u32) + altitude_mm(i32)
 FMT_MAG = "<BI3h"  # header + field[3]
 FMT_EVENT = "<BIBH"  # header + event_code(u8) + aux(u16)
+# header + period_us(u16) + count(u8) + payload_len(u16) + accel[3] + gyro[3]
+FMT_IMU_BLOCK = "<BIHBH3h3h"
+IMU_BLOCK_FIXED_SIZE = struct.calcsize(FMT_IMU_BLOCK)
+IMU_BLOCK_MAX_SAMPLES = 32
 
 MSG_SIZES: dict[int, int] = {
     MSG_IMU: struct.calcsize(FMT_IMU),
@@ -73,8 +97,28 @@ MSG_NAMES: dict[int, str] = {
     MSG_BARO: "BARO",
     MSG_MAG: "MAG",
     MSG_EVENT: "EVENT",
+    MSG_IMU_DELTA: "IMU_DELTA",
+    MSG_IMU_BLOCK: "IMU_BLOCK",
 }
 
+# IMU_DELTA: ddt + accel[3] + gyro[3], each a zig-zag LEB128 varint (<= 5 B)
+IMU_DELTA_FIELDS = 7
+VARINT_MAX_BYTES = 5
+
+# Schema block (v4+, right after the file header), see log_schema_write()
+SCHEMA_MAGIC = b"SCHM"
+LAYOUT_FIXED = 0  # MSG_SIZES-style fixed record
+LAYOUT_LEN16 = 1  # fixed part + u16 payload length at byte layout_arg
+LAYOUT_VARINTS = 2  # msg_id + layout_arg LEB128 varints, no timestamp
+FIELD_FORMATS: dict[int, str] = {1: "B", 2: "H", 3: "I", 4: "h", 5: "i"}
+
+# v5 frames: sync(4) + seq(u32) + len(u16) + crc32(u32), then len payload bytes.
+# crc = zlib.crc32 over seq, len and payload, seeded with crc32(file header).
+FRAME_SYNC = b"\xa5\x5aFR"
+FMT_FRAME_HEADER = "<4sIHI"
+FRAME_HEADER_SIZE = struct.calcsize(FMT_FRAME_HEADER)
+_NON_PAD = re.compile(b"[^\x00]")
+
 
 # ---------------------------------------------------------------------------
 # Decoded record types
@@ -131,17 +175,67 @@ class EventRecord:
     aux: int
 
 
+@dataclass
+class ImuDeltaState:
+    """Delta chain shared by IMU keyframes and IMU_DELTA records (raw LSB)."""
+
+    synced: bool = False
+    timestamp_us: int = 0
+    dt_us: int = 0
+    accel: list[int] = field(default_factory=lambda: [0, 0, 0])
+    gyro: list[int] = field(default_factory=lambda: [0, 0, 0])
+
+
+@dataclass
+class SchemaField:
+    name: str
+    fmt: str  # struct format character
+    scale: float
+    decimals: int
+
+
+@dataclass
+class SchemaMsg:
+    msg_id: int
+    name: str
+    layout: int
+    layout_arg: int
+    fields: list[SchemaField]
+
+    @property
+    def fmt(self) -> str:
+        """struct format of the fixed part (header + fields)."""
+        return FMT_HEADER + "".join(f.fmt for f in self.fields)
+
+    @property
+    def fixed_size(self) -> int:
+        if self.layout == LAYOUT_VARINTS:
+            return 1
+        return struct.calcsize(self.fmt)
+
+
 @dataclass
 class DecodedLog:
     header: FileHeader | None = None
+    schema: list[SchemaMsg] | None = None  # None: pre-v4 file or bad block
+    # Types unknown to this decoder, decoded from the schema: name -> rows
+    extra: dict[str, list[tuple[int, ...]]] = field(default_factory=dict)
     imu: list[ImuRecord] = field(default_factory=list)
     nav: list[NavRecord] = field(default_factory=list)
     ctrl: list[CtrlRecord] = field(default_factory=list)
     baro: list[BaroRecord] = field(default_factory=list)
     mag: list[MagRecord] = field(default_factory=list)
     events: list[EventRecord] = field(default_factory=list)
+    imu_delta_count: int = 0
+    imu_block_count: int = 0
+    imu_unsynced: int = 0  # deltas before the first keyframe (undecodable)
     unknown_count: int = 0
+    padding_bytes: int = 0
     parse_errors: int = 0
+    frames: int = 0  # v5: frames that passed the CRC
+    frames_lost: int = 0  # v5: gaps in the frame sequence
+    corrupt_regions: int = 0  # v5: damaged runs skipped by resync
+    corrupt_bytes: int = 0
 
 
 # ---------------------------------------------------------------------------
@@ -159,6 +253,211 @@ def decode_file_header(data: bytes) -> FileHeader:
     )
 
 
+def read_schema(fp: BinaryIO) -> list[SchemaMsg] | None:
+    """Read the schema block at the current position; None if invalid."""
+    head = fp.read(6)
+    if len(head) < 6 or head[:4] != SCHEMA_MAGIC:
+        return None
+    (length,) = struct.unpack_from("<H", head, 4)
+    body = fp.read(length)
+    if len(body) < length:
+        return None
+
+    pos = 0
+
+    def take(n: int) -> bytes:
+        nonlocal pos
+        if pos + n > len(body):
+            raise ValueError("schema block truncated")
+        pos += n
+        return body[pos - n : pos]
+
+    def take_str() -> str:
+        return take(take(1)[0]).decode("ascii")
+
+    msgs: list[SchemaMsg] = []
+    try:
+        for _ in range(take(1)[0]):
+            msg_id, layout, layout_arg, n_fields = take(4)
+            msg = SchemaMsg(msg_id, take_str(), layout, layout_arg, [])
+            for _ in range(n_fields):
+                ftype, decimals = take(2)
+                (scale,) = struct.unpack("<d", take(8))
+                if ftype not in FIELD_FORMATS:
+                    return None
+                msg.fields.append(
+                    SchemaField(take_str(), FIELD_FORMATS[ftype], scale, decimals)
+                )
+            if layout > LAYOUT_VARINTS or msg_id == MSG_PAD:
+                return None
+            if layout == LAYOUT_LEN16 and layout_arg + 2 > msg.fixed_size:
+                return None
+            msgs.append(msg)
+    except (ValueError, UnicodeDecodeError):
+        return None
+    return msgs if pos == len(body) else None
+
+
+def check_schema(schema: list[SchemaMsg]) -> dict[int, SchemaMsg]:
+    """Warn where the file disagrees with the formats above.
+
+    Returns the types this decoder has no code for (decoded generically).
+    """
+    known_sizes = dict(MSG_SIZES)
+    known_sizes[MSG_IMU_BLOCK] = IMU_BLOCK_FIXED_SIZE
+    generic: dict[int, SchemaMsg] = {}
+    for msg in schema:
+        if msg.msg_id == MSG_IMU_DELTA:
+            if msg.layout != LAYOUT_VARINTS or msg.layout_arg != IMU_DELTA_FIELDS:
+                print(
+                    f"Warning: schema of {msg.name} differs from decoder",
+                    file=sys.stderr,
+                )
+        elif msg.msg_id in known_sizes:
+            if msg.fixed_size != known_sizes[msg.msg_id]:
+                print(
+                    f"Warning: {msg.name} is {msg.fixed_size} B in the file, "
+                    f"decoder expects {known_sizes[msg.msg_id]} B",
+                    file=sys.stderr,
+                )
+        else:
+            generic[msg.msg_id] = msg
+    return generic
+
+
+def decode_generic(log: DecodedLog, msg: SchemaMsg, first: bytes, fp: BinaryIO) -> bool:
+    """Decode a record of a type known only from the schema (msg_id consumed)."""
+    if msg.layout == LAYOUT_VARINTS:
+        return all(read_varint(fp) is not None for _ in range(msg.layout_arg))
+
+    raw = first + fp.read(msg.fixed_size - 1)
+    if len(raw) < msg.fixed_size:
+        return False
+    if msg.layout == LAYOUT_LEN16:
+        (payload_len,) = struct.unpack_from("<H", raw, msg.layout_arg)
+        if len(fp.read(payload_len)) < payload_len:
+            return False
+    log.extra.setdefault(msg.name, []).append(struct.unpack(msg.fmt, raw)[1:])
+    return True
+
+
+def zigzag_decode(u: int) -> int:
+    return (u >> 1) ^ -(u & 1)
+
+
+def read_varint(fp: BinaryIO) -> int | None:
+    """Read one LEB128 varint (uint32); None if truncated or too long."""
+    value = 0
+    for i in range(VARINT_MAX_BYTES):
+        b = fp.read(1)
+        if len(b) == 0:
+            return None
+        value |= (b[0] & 0x7F) << (7 * i)
+        if (b[0] & 0x80) == 0:
+            return value
+    return None
+
+
+def _wrap_i16(v: int) -> int:
+    return ((v + 0x8000) & 0xFFFF) - 0x8000
+
+
+def decode_imu_delta(log: DecodedLog, state: ImuDeltaState, fp: BinaryIO) -> bool:
+    """Decode the body of an IMU_DELTA record (msg_id already consumed)."""
+    fields = []
+    for _ in range(IMU_DELTA_FIELDS):
+        u = read_varint(fp)
+        if u is None:
+            return False
+        fields.append(zigzag_decode(u))
+
+    if not state.synced:
+        log.imu_unsynced += 1
+        return True
+
+    state.dt_us = (state.dt_us + fields[0]) & 0xFFFFFFFF
+    state.timestamp_us = (state.timestamp_us + state.dt_us) & 0xFFFFFFFF
+    for i in range(3):
+        state.accel[i] = _wrap_i16(state.accel[i] + fields[1 + i])
+        state.gyro[i] = _wrap_i16(state.gyro[i] + fields[4 + i])
+
+    log.imu.append(_imu_record(state.timestamp_us, state.accel, state.gyro))
+    log.imu_delta_count += 1
+    return True
+
+
+def parse_varint(buf: bytes, pos: int) -> tuple[int, int] | None:
+    """Parse one LEB128 varint from buf; returns (value, new_pos)."""
+    value = 0
+    for i in range(VARINT_MAX_BYTES):
+        if pos >= len(buf):
+            return None
+        b = buf[pos]
+        pos += 1
+        value |= (b & 0x7F) << (7 * i)
+        if (b & 0x80) == 0:
+            return value, pos
+    return None
+
+
+def decode_imu_block(log: DecodedLog, fixed: bytes, payload: bytes) -> bool:
+    """Decode an IMU_BLOCK record: sample 0 raw, then 6 varint deltas each."""
+    _, ts, period, count, _, ax, ay, az, gx, gy, gz = struct.unpack(FMT_IMU_BLOCK, fixed)
+    if count == 0 or count > IMU_BLOCK_MAX_SAMPLES:
+        return False
+
+    accel = [ax, ay, az]
+    gyro = [gx, gy, gz]
+    samples = [_imu_record(ts, accel, gyro)]
+    pos = 0
+    for k in range(1, count):
+        deltas = []
+        for _ in range(6):
+            parsed = parse_varint(payload, pos)
+            if parsed is None:
+                return False
+            u, pos = parsed
+            deltas.append(zigzag_decode(u))
+        for i in range(3):
+            accel[i] = _wrap_i16(accel[i] + deltas[i])
+            gyro[i] = _wrap_i16(gyro[i] + deltas[3 + i])
+        samples.append(_imu_record((ts + k * period) & 0xFFFFFFFF, accel, gyro))
+
+    if pos != len(payload):
+        return False
+
+    log.imu.extend(samples)
+    log.imu_block_count += 1
+    return True
+
+
+def _imu_record(ts: int, accel: list[int], gyro: list[int]) -> ImuRecord:
+    ax, ay, az = accel
+    gx, gy, gz = gyro
+    return ImuRecord(
+        timestamp_us=ts,
+        accel_mps2=(ax * 0.001, ay * 0.001, az * 0.001),
+        gyro_rads=(gx * 0.01, gy * 0.01, gz * 0.01),
+    )
+
+
+def skip_padding(fp: BinaryIO) -> int:
+    """Skip a run of padding bytes (megabytes on a preallocated log).
+
+    Returns the number skipped; fp is left on the first non-padding byte.
+    """
+    skipped = 0
+    while True:
+        chunk = fp.read(65536)
+        if not chunk:
+            return skipped
+        n = len(chunk) - len(chunk.lstrip(bytes([MSG_PAD])))
+        skipped += n
+        if n < len(chunk):
+            fp.seek(n - len(chunk), 1)
+            return skipped
+
+
 def decode_log(fp: BinaryIO) -> DecodedLog:
     """Decode an entire binary log file into structured records."""
     log = DecodedLog()
@@ -184,6 +483,37 @@ def decode_log(fp: BinaryIO) -> DecodedLog:
             file=sys.stderr,
         )
 
+    generic: dict[int, SchemaMsg] = {}
+    if log.header.version >= 4:
+        start = fp.tell()
+        log.schema = read_schema(fp)
+        if log.schema is None:
+            print(
+                "Warning: no valid schema block, using built-in formats",
+                file=sys.stderr,
+            )
+            fp.seek(start)
+        else:
+            generic = check_schema(log.schema)
+
+    imu_state = ImuDeltaState()
+
+    if log.header.version < 5:
+        # No frames: the first damaged record ends the decode
+        decode_records(log, fp, imu_state, generic)
+    else:
+        decode_frames(log, fp.read(), zlib.crc32(raw_hdr), imu_state, generic)
+
+    return log
+
+
+def decode_records(
+    log: DecodedLog,
+    fp: BinaryIO,
+    imu_state: ImuDeltaState,
+    generic: dict[int, SchemaMsg],
+) -> bool:
+    """Decode records up to EOF; False if a damaged record stopped it."""
     while True:
         msg_id_byte = fp.read(1)
         if len(msg_id_byte) == 0:
@@ -191,6 +521,34 @@ def decode_log(fp: BinaryIO) -> DecodedLog:
 
         msg_id = msg_id_byte[0]
 
+        if msg_id == MSG_PAD:
+            log.padding_bytes += 1 + skip_padding(fp)
+            continue
+
+        if msg_id == MSG_IMU_BLOCK:
+            fixed = msg_id_byte + fp.read(IMU_BLOCK_FIXED_SIZE - 1)
+            if len(fixed) < IMU_BLOCK_FIXED_SIZE:
+                log.parse_errors += 1
+                return False
+            payload_len = struct.unpack_from("<H", fixed, 8)[0]
+            payload = fp.read(payload_len)
+            if len(payload) < payload_len or not decode_imu_block(log, fixed, payload):
+                log.parse_errors += 1
+                return False
+            continue
+
+        if msg_id == MSG_IMU_DELTA:
+            if not decode_imu_delta(log, imu_state, fp):
+                log.parse_errors += 1
+                return False
+            continue
+
+        if msg_id in generic:
+            if not decode_generic(log, generic[msg_id], msg_id_byte, fp):
+                log.parse_errors += 1
+                return False
+            continue
+
         rec_size = MSG_SIZES.get(msg_id)
         if rec_size is None:
             log.unknown_count += 1
@@ -200,28 +558,90 @@ def decode_log(fp: BinaryIO) -> DecodedLog:
         payload = fp.read(remaining)
         if len(payload) < remaining:
             log.parse_errors += 1
-            break
+            return False
 
         raw = msg_id_byte + payload
 
         try:
-            _decode_record(log, msg_id, raw)
+            _decode_record(log, msg_id, raw, imu_state)
         except struct.error:
             log.parse_errors += 1
 
-    return log
-
+    return True
+
+
+def parse_frame(data: bytes, pos: int, seed: int) -> tuple[int, int] | None:
+    """(seq, payload length) of a valid frame at pos, None otherwise."""
+    if data[pos : pos + 4] != FRAME_SYNC or len(data) - pos < FRAME_HEADER_SIZE:
+        return None
+    _, seq, length, crc = struct.unpack_from(FMT_FRAME_HEADER, data, pos)
+    end = pos + FRAME_HEADER_SIZE + length
+    if end > len(data):
+        return None
+    value = zlib.crc32(data[pos + 4 : pos + 10], seed)
+    if zlib.crc32(data[pos + FRAME_HEADER_SIZE : end], value) != crc:
+        return None
+    return seq, length
+
+
+def decode_frames(
+    log: DecodedLog,
+    data: bytes,
+    seed: int,
+    imu_state: ImuDeltaState,
+    generic: dict[int, SchemaMsg],
+) -> None:
+    """Decode v5 CRC frames; damaged regions are skipped to the next sync word."""
+    pos = 0
+    next_seq = 0
+    in_bad = False
+    while pos < len(data):
+        if data[pos] == MSG_PAD:
+            m = _NON_PAD.search(data, pos)
+            end = m.start() if m else len(data)
+            log.padding_bytes += end - pos
+            pos = end
+            continue
 
-def _decode_record(log: DecodedLog, msg_id: int, raw: bytes) -> None:
+        frame = parse_frame(data, pos, seed)
+        if frame is None:
+            nxt = data.find(FRAME_SYNC, pos + 1)
+            nxt = len(data) if nxt < 0 else nxt
+            log.corrupt_bytes += nxt - pos
+            log.corrupt_regions += 0 if in_bad else 1
+            in_bad = True
+            imu_state.synced = False  # deltas wait for the next keyframe
+            pos = nxt
+            continue
+        in_bad = False
+
+        seq, length = frame
+        if seq != next_seq:
+            gap = (seq - next_seq) & 0xFFFFFFFF
+            log.frames_lost += gap if gap < 0x80000000 else 0
+            imu_state.synced = False
+        next_seq = (seq + 1) & 0xFFFFFFFF
+        log.frames += 1
+
+        start = pos + FRAME_HEADER_SIZE
+        payload = io.BytesIO(data[start : start + length])
+        if not decode_records(log, payload, imu_state, generic):
+            imu_state.synced = False  # rest of the frame is lost
+        pos = start + length
+
+
+def _decode_record(
+    log: DecodedLog, msg_id: int, raw: bytes, imu_state: ImuDeltaState
+) -> None:
     if msg_id == MSG_IMU:
+        # Every LogImu is also the keyframe of the following IMU_DELTA chain
         _, ts, ax, ay, az, gx, gy, gz = struct.unpack(FMT_IMU, raw)
-        log.imu.append(
-            ImuRecord(
-                timestamp_us=ts,
-                accel_mps2=(ax * 0.001, ay * 0.001, az * 0.001),
-                gyro_rads=(gx * 0.01, gy * 0.01, gz * 0.01),
-            )
-        )
+        imu_state.synced = True
+        imu_state.timestamp_us = ts
+        imu_state.dt_us = 0
+        imu_state.accel = [ax, ay, az]
+        imu_state.gyro = [gx, gy, gz]
+        log.imu.append(_imu_record(ts, imu_state.accel, imu_state.gyro))
 
     elif msg_id == MSG_NAV:
         _, ts, qw, qx, qy, qz, px, py, pz, vx, vy, vz = struct.unpack(FMT_NAV, raw)
@@ -284,6 +704,8 @@ def print_summary(log: DecodedLog) -> None:
     print(f"Format version: {hdr.version}")
     print(f"System clock:   {hdr.sysclk_hz / 1e6:.1f} MHz")
     print(f"Boot time:      {hdr.boot_time_ms} ms")
+    if log.schema is not None:
+        print(f"Schema:         from file ({len(log.schema)} message types)")
     print()
 
     total = (
@@ -293,16 +715,31 @@ def print_summary(log: DecodedLog) -> None:
         + len(log.baro)
         + len(log.mag)
         + len(log.events)
+        + sum(len(rows) for rows in log.extra.values())
     )
     print(f"Records decoded: {total}")
-    print(f"  IMU:    {len(log.imu)}")
+    print(
+        f"  IMU:    {len(log.imu)} ({log.imu_delta_count} delta-encoded, "
+        f"{log.imu_block_count} blocks)"
+    )
     print(f"  NAV:    {len(log.nav)}")
     print(f"  CTRL:   {len(log.ctrl)}")
     print(f"  BARO:   {len(log.baro)}")
     print(f"  MAG:    {len(log.mag)}")
     print(f"  EVENT:  {len(log.events)}")
+    for name, rows in log.extra.items():
+        print(f"  {name}: {len(rows)} (from schema)")
+    if log.imu_unsynced:
+        print(f"  IMU deltas before first keyframe: {log.imu_unsynced}")
     print(f"  Unknown: {log.unknown_count}")
+    if log.padding_bytes:
+        print(f"  Padding: {log.padding_bytes} B (log not closed cleanly?)")
     print(f"  Errors:  {log.parse_errors}")
+    if hdr.version >= 5:
+        print(
+            f"  Frames:  {log.frames} ok, {log.frames_lost} lost, "
+            f"{log.corrupt_regions} corrupt regions ({log.corrupt_bytes} B)"
+        )
 
     if log.imu:
         t0 = log.imu[0].timestamp_us
@@ -460,6 +897,23 @@ def export_csv(log: DecodedLog, output_dir: Path) -> None:
                 f.write(f"{re_.timestamp_us},{re_.event_code},{re_.aux}\n")
         print(f"  Wrote {path} ({len(log.events)} records)")
 
+    for msg in log.schema or []:
+        rows = log.extra.get(msg.name)
+        if not rows:
+            continue
+        path = output_dir / f"{msg.name}.csv"
+        with path.open("w") as f:
+            f.write(",".join(["timestamp_us"] + [fd.name for fd in msg.fields]) + "\n")
+            for row in rows:
+                cells = [str(row[0])]
+                for fd, v in zip(msg.fields, row[1:], strict=True):
+                    if fd.scale == 1.0:
+                        cells.append(str(v))
+                    else:
+                        cells.append(f"{v * fd.scale:.{fd.decimals}f}")
+                f.write(",".join(cells) + "\n")
+        print(f"  Wrote {path} ({len(rows)} records)")
+
 
 # ---------------------------------------------------------------------------
 # CLI